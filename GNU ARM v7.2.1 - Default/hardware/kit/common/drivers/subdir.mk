@@ -5,6 +5,7 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../hardware/kit/common/drivers/display.c \
+../hardware/kit/common/drivers/displayhost.c \
 ../hardware/kit/common/drivers/displayls013b7dh03.c \
 ../hardware/kit/common/drivers/displaypalemlib.c \
 ../hardware/kit/common/drivers/i2cspm.c \
@@ -15,6 +16,7 @@ C_SRCS += \
 
 OBJS += \
 ./hardware/kit/common/drivers/display.o \
+./hardware/kit/common/drivers/displayhost.o \
 ./hardware/kit/common/drivers/displayls013b7dh03.o \
 ./hardware/kit/common/drivers/displaypalemlib.o \
 ./hardware/kit/common/drivers/i2cspm.o \
@@ -25,6 +27,7 @@ OBJS += \
 
 C_DEPS += \
 ./hardware/kit/common/drivers/display.d \
+./hardware/kit/common/drivers/displayhost.d \
 ./hardware/kit/common/drivers/displayls013b7dh03.d \
 ./hardware/kit/common/drivers/displaypalemlib.d \
 ./hardware/kit/common/drivers/i2cspm.d \
@@ -42,6 +45,13 @@ hardware/kit/common/drivers/display.o: ../hardware/kit/common/drivers/display.c
 	@echo 'Finished building: $<'
 	@echo ' '
 
+hardware/kit/common/drivers/displayhost.o: ../hardware/kit/common/drivers/displayhost.c
+	@echo 'Building file: $<'
+	@echo 'Invoking: GNU ARM C Compiler'
+	arm-none-eabi-gcc -g -gdwarf-2 -mcpu=cortex-m4 -mthumb -std=c99 '-DNVM3_DEFAULT_MAX_OBJECT_SIZE=512' '-DHAL_CONFIG=1' '-DMESH_LIB_NATIVE=1' '-D__HEAP_SIZE=0x1700' '-D__STACK_SIZE=0x1000' '-DNVM3_DEFAULT_NVM_SIZE=24576' '-DEFR32BG13P632F512GM48=1' -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\inc\common" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\Device\SiliconLabs\EFR32BG13P\Include" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emlib\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\common\drivers" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\dmd\ssd2119" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emlib\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\ble_stack\inc\soc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\CMSIS\Include" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\common\bsp" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\plugin\coexistence\common" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\protocol\ieee802154" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\Device\SiliconLabs\EFR32BG13P\Source\GCC" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\service\sleeptimer\config" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\common" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\glib" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\common\halconfig" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\gpiointerrupt\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\EFR32BG13_BRD4104A\config" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\service\sleeptimer\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\halconfig\inc\hal-config" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\ble_stack\src\soc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\gpiointerrupt\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\plugin\coexistence\hal\efr32" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\dmd\display" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\sleep\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\uartdrv\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\bootloader\api" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\nvm3\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\service\sleeptimer\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\nvm3\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\inc\soc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\common\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\common\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\chip\efr32\efr32xg1x" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\Device\SiliconLabs\EFR32BG13P\Source" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\dmd" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\protocol\ble" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\sleep\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\plugin" -Os -fno-builtin -Wall -c -fmessage-length=0 -ffunction-sections -fdata-sections -mfpu=fpv4-sp-d16 -mfloat-abi=softfp -MMD -MP -MF"hardware/kit/common/drivers/displayhost.d" -MT"hardware/kit/common/drivers/displayhost.o" -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
 hardware/kit/common/drivers/displayls013b7dh03.o: ../hardware/kit/common/drivers/displayls013b7dh03.c
 	@echo 'Building file: $<'
 	@echo 'Invoking: GNU ARM C Compiler'
@@ -4,19 +4,32 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../src/console.c \
 ../src/gpio.c \
-../src/log.c 
+../src/log.c \
+../src/profile.c 
 
 OBJS += \
+./src/console.o \
 ./src/gpio.o \
-./src/log.o 
+./src/log.o \
+./src/profile.o 
 
 C_DEPS += \
+./src/console.d \
 ./src/gpio.d \
-./src/log.d 
+./src/log.d \
+./src/profile.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
+src/console.o: ../src/console.c
+	@echo 'Building file: $<'
+	@echo 'Invoking: GNU ARM C Compiler'
+	arm-none-eabi-gcc -g -gdwarf-2 -mcpu=cortex-m4 -mthumb -std=c99 '-DNVM3_DEFAULT_MAX_OBJECT_SIZE=512' '-DHAL_CONFIG=1' '-DMESH_LIB_NATIVE=1' '-D__HEAP_SIZE=0x1700' '-D__STACK_SIZE=0x1000' '-DNVM3_DEFAULT_NVM_SIZE=24576' '-DEFR32BG13P632F512GM48=1' -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\inc\common" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\Device\SiliconLabs\EFR32BG13P\Include" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emlib\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\common\drivers" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\dmd\ssd2119" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emlib\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\ble_stack\inc\soc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\CMSIS\Include" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\common\bsp" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\plugin\coexistence\common" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\protocol\ieee802154" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\Device\SiliconLabs\EFR32BG13P\Source\GCC" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\service\sleeptimer\config" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\common" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\glib" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\common\halconfig" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\gpiointerrupt\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\EFR32BG13_BRD4104A\config" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\service\sleeptimer\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\halconfig\inc\hal-config" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\ble_stack\src\soc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\gpiointerrupt\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\plugin\coexistence\hal\efr32" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\dmd\display" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\sleep\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\uartdrv\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\bootloader\api" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\nvm3\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\service\sleeptimer\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\nvm3\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\inc\soc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\common\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\common\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\chip\efr32\efr32xg1x" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\Device\SiliconLabs\EFR32BG13P\Source" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\dmd" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\protocol\ble" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\sleep\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\plugin" -Os -fno-builtin -Wall -c -fmessage-length=0 -ffunction-sections -fdata-sections -mfpu=fpv4-sp-d16 -mfloat-abi=softfp -MMD -MP -MF"src/console.d" -MT"src/console.o" -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
 src/gpio.o: ../src/gpio.c
 	@echo 'Building file: $<'
 	@echo 'Invoking: GNU ARM C Compiler'
@@ -31,4 +44,10 @@ src/log.o: ../src/log.c
 	@echo 'Finished building: $<'
 	@echo ' '
 
+src/profile.o: ../src/profile.c
+	@echo 'Building file: $<'
+	@echo 'Invoking: GNU ARM C Compiler'
+	arm-none-eabi-gcc -g -gdwarf-2 -mcpu=cortex-m4 -mthumb -std=c99 '-DNVM3_DEFAULT_MAX_OBJECT_SIZE=512' '-DHAL_CONFIG=1' '-DMESH_LIB_NATIVE=1' '-D__HEAP_SIZE=0x1700' '-D__STACK_SIZE=0x1000' '-DNVM3_DEFAULT_NVM_SIZE=24576' '-DEFR32BG13P632F512GM48=1' -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\inc\common" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\Device\SiliconLabs\EFR32BG13P\Include" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emlib\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\common\drivers" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\dmd\ssd2119" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emlib\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\ble_stack\inc\soc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\CMSIS\Include" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\common\bsp" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\plugin\coexistence\common" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\protocol\ieee802154" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\Device\SiliconLabs\EFR32BG13P\Source\GCC" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\service\sleeptimer\config" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\common" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\glib" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\common\halconfig" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\gpiointerrupt\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\hardware\kit\EFR32BG13_BRD4104A\config" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\service\sleeptimer\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\halconfig\inc\hal-config" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\ble_stack\src\soc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\gpiointerrupt\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\plugin\coexistence\hal\efr32" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\dmd\display" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\sleep\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\uartdrv\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\bootloader\api" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\nvm3\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\service\sleeptimer\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\nvm3\src" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\protocol\bluetooth\bt_mesh\inc\soc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\common\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\common\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\chip\efr32\efr32xg1x" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\Device\SiliconLabs\EFR32BG13P\Source" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\middleware\glib\dmd" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\protocol\ble" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\emdrv\sleep\inc" -I"C:\Users\sengu\SimplicityStudio\v4_workspace\soc-btmesh-switch\platform\radio\rail_lib\plugin" -Os -fno-builtin -Wall -c -fmessage-length=0 -ffunction-sections -fdata-sections -mfpu=fpv4-sp-d16 -mfloat-abi=softfp -MMD -MP -MF"src/profile.d" -MT"src/profile.o" -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
 
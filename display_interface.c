@@ -31,11 +31,14 @@ display_interface_t display_interface = DEFAULT_DISPLAY_INTERFACE;
  *
  * @param[in] init   Pointer to display initialization function.
  * @param[in] print  Pointer to display print function.
+ * @param[in] flush  Pointer to display flush function, NULL if print updates
+ *                   the display immediately.
  ******************************************************************************/
-void DI_Config(init_func_t init, print_func_t print)
+void DI_Config(init_func_t init, print_func_t print, flush_func_t flush)
 {
   display_interface.init = init;
   display_interface.print = print;
+  display_interface.flush = flush;
 }
 
 /*******************************************************************************
@@ -68,4 +71,16 @@ void DI_Print(char *str, uint8_t row)
   display_interface.print(str, row);
 }
 
+/*******************************************************************************
+ * Update the display with everything printed since the last flush.
+ ******************************************************************************/
+void DI_Flush(void)
+{
+  if (display_interface.flush == NULL) {
+    return;
+  }
+
+  display_interface.flush();
+}
+
 /** @} (end addtogroup disp_interface) */
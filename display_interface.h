@@ -35,11 +35,14 @@
 typedef void (*init_func_t)(void);
 /// Pointer to display print function type
 typedef void (*print_func_t)(char *str, uint8_t row);
+/// Pointer to display flush function type
+typedef void (*flush_func_t)(void);
 
 /// Struct contains display interface functions
 typedef struct {
   init_func_t  init;   ///< Pointer to initialization function
   print_func_t print;  ///< Pointer to print function
+  flush_func_t flush;  ///< Pointer to flush function, NULL if print is immediate
 }display_interface_t;
 
 #if defined(FEATURE_LCD_SUPPORT)
@@ -60,10 +63,13 @@ typedef struct {
 #define DI_ROW_PEOPLE_COUNT LCD_ROW_PEOPLE_COUNT
 #define DI_ROW_ILLUMINANCE  LCD_ROW_ILLUMINANCE
 
+#define DI_EVENT_FLUSH      LCD_EVENT_FLUSH
+
 #define DEFAULT_DISPLAY_INTERFACE \
   {                               \
     LCD_init,                     \
-    LCD_write                     \
+    LCD_write,                    \
+    LCD_flush                     \
   }
 
 #else
@@ -82,8 +88,11 @@ typedef struct {
 #define DI_ROW_PEOPLE_COUNT 0
 #define DI_ROW_ILLUMINANCE  0
 
+#define DI_EVENT_FLUSH      0
+
 #define DEFAULT_DISPLAY_INTERFACE \
   {                               \
+    NULL,                         \
     NULL,                         \
     NULL                          \
   }
@@ -95,8 +104,10 @@ typedef struct {
  *
  * @param[in] init   Pointer to display initialization function.
  * @param[in] print  Pointer to display print function.
+ * @param[in] flush  Pointer to display flush function, NULL if print updates
+ *                   the display immediately.
  ******************************************************************************/
-void DI_Config(init_func_t init, print_func_t print);
+void DI_Config(init_func_t init, print_func_t print, flush_func_t flush);
 
 /***************************************************************************//**
  * Initialize Display Interface.
@@ -106,12 +117,20 @@ void DI_Init(void);
 /***************************************************************************//**
  * Print to Display Interface.
  *
+ * The display may defer the update until DI_Flush() is called. Such displays
+ * post DI_EVENT_FLUSH as an external signal when a flush is pending.
+ *
  * @param[in] str  Pointer to string which is displayed in the specified row.
  * @param[in] row  Selects which line of display is written,
  *                 possible values are defined as DI_ROW_xxx.
  ******************************************************************************/
 void DI_Print(char *str, uint8_t row);
 
+/***************************************************************************//**
+ * Update the display with everything printed since the last flush.
+ ******************************************************************************/
+void DI_Flush(void);
+
 /** @} (end addtogroup disp_interface) */
 
 #endif /* DISPLAY_INTERFACE_H */
@@ -34,10 +34,25 @@
  */
 #define USE_STATIC_PIXEL_MATRIX_POOL
 
-/* Specify the size of the static pixel matrix pool. For the weatherstation demo
- *  we need one pixel matrix (framebuffer) covering the whole display.
+/* Keep the line trailers (dummy byte + next line address) in the pixel
+ * matrix, so that consecutive lines can be sent as one block.
  */
-#define PIXEL_MATRIX_POOL_SIZE   (DISPLAY0_HEIGHT * DISPLAY0_WIDTH / 8)
+#define USE_CONTROL_BYTES
+
+/* Specify the size of the static pixel matrix pool. We need two pixel
+ * matrices (framebuffers) covering the whole display, including the two
+ * control bytes per line: the one drawn in and the front buffer the display
+ * is updated from when double buffering.
+ */
+#define PIXEL_MATRIX_POOL_SIZE   (2 * DISPLAY0_HEIGHT * (DISPLAY0_WIDTH / 8 + 2))
+
+/* The LDMA moves the pixel matrix in 16 bit units. */
+#define PIXEL_MATRIX_ALIGNMENT   (4)
+
+/* Send display updates with the LDMA on this channel instead of busy-waiting
+ * on the USART, see PAL_SpiTransmitAsync.
+ */
+#define PAL_SPI_DMA_CHANNEL      (0)
 
 /* On EFM32ZG_STK3200, the DISPLAY driver Platform Abstraction Layer (PAL)
  * uses the RTC to time and toggle the EXTCOMIN pin of the Sharp memory
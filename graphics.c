@@ -28,6 +28,35 @@
 /* Own header */
 #include "graphics.h"
 
+#include "src/log.h"
+
+/***************************************************************************************************
+   Local Macros and Definitions
+ **************************************************************************************************/
+
+/* RAM in bytes for text lines cached by graphWriteLine(), 0 disables the cache */
+#ifndef GRAPH_TEXT_CACHE_SIZE
+#define GRAPH_TEXT_CACHE_SIZE       (1024)
+#endif
+
+/* Maximum number of cached text lines, whatever the size of a line */
+#ifndef GRAPH_TEXT_CACHE_ENTRIES
+#define GRAPH_TEXT_CACHE_ENTRIES    (8)
+#endif
+
+/* Longer strings are drawn but not cached */
+#define GRAPH_TEXT_CACHE_TEXT_LEN   (24)
+
+/* A rendered text line: the full width pixel rows of the line, 1 bpp */
+typedef struct {
+  uint32_t hash;                              /* FNV-1a hash of the text */
+  uint32_t lastUse;                           /* LRU stamp, 0 if unused */
+  const void *pFont;                          /* Font pixel map used */
+  uint16_t rows;                              /* Pixel rows in the strip */
+  char text[GRAPH_TEXT_CACHE_TEXT_LEN];       /* Text for collision checks */
+  uint8_t *strip;                             /* Pixel data in DMD_writeData format */
+} graphTextCacheEntry_t;
+
 /***************************************************************************************************
    Local Variables
  **************************************************************************************************/
@@ -36,13 +65,34 @@
 static GLIB_Context_t glibContext;
 /* Current line number stored for printing text */
 static uint8_t graphLineNum = 0;
+/* Number of lines taken by the header, first line of the string below it */
+static uint8_t graphHeaderLines = 0;
 /* Device name string */
 static char *deviceHeader = NULL;
 
+#if GRAPH_TEXT_CACHE_SIZE > 0
+/* Rendered text lines, strips are carved from the pool by graphInit() */
+static graphTextCacheEntry_t graphTextCache[GRAPH_TEXT_CACHE_ENTRIES];
+static uint8_t graphTextCachePool[GRAPH_TEXT_CACHE_SIZE];
+/* Number of usable entries and bytes per strip */
+static uint8_t graphTextCacheSlots = 0;
+static uint32_t graphTextCacheSlotSize = 0;
+/* Stamp of the last cache access */
+static uint32_t graphTextCacheClock = 0;
+/* Statistics */
+static uint32_t graphTextCacheHits = 0;
+static uint32_t graphTextCacheMisses = 0;
+#endif
+
 /***************************************************************************************************
    Static Function Declarations
  **************************************************************************************************/
 static void graphPrintCenter(GLIB_Context_t *pContext, char *pString);
+#if GRAPH_TEXT_CACHE_SIZE > 0
+static void graphTextCacheInit(void);
+static bool graphTextCacheDraw(const char *pString, uint32_t hash, GLIB_Rectangle_t *pRect);
+static void graphTextCacheStore(const char *pString, uint32_t hash, GLIB_Rectangle_t *pRect);
+#endif
 
 /***************************************************************************************************
    Function Definitions
@@ -65,6 +115,10 @@ void graphInit(char *header)
       ;
   }
 
+  /* Send display updates in the background when the display supports it,
+     otherwise DMD_updateDisplay keeps drawing synchronously. */
+  DMD_enableDoubleBuffering();
+
   status = GLIB_contextInit(&glibContext);
   if (GLIB_OK != status) {
     while (1)
@@ -75,9 +129,13 @@ void graphInit(char *header)
   glibContext.foregroundColor = Black;
 
   /* Use Narrow font */
-  GLIB_setFont(&glibContext, (GLIB_Font_t *)&GLIB_FontNarrow6x8);
+  GLIB_setFont(&glibContext, (GLIB_Font_t *)&GLIB_FontNarrow6x8Rle);
 
   deviceHeader = header;
+
+#if GRAPH_TEXT_CACHE_SIZE > 0
+  graphTextCacheInit();
+#endif
 }
 
 void graphWriteString(char *string)
@@ -87,6 +145,7 @@ void graphWriteString(char *string)
   /* Reset line number, print header and device name */
   graphLineNum = 0;
   graphPrintCenter(&glibContext, deviceHeader);
+  graphHeaderLines = graphLineNum;
 
   /* Print the string below the header center aligned */
   graphPrintCenter(&glibContext, string);
@@ -94,6 +153,72 @@ void graphWriteString(char *string)
   DMD_updateDisplay();
 }
 
+void graphWriteLine(char *string, uint8_t line)
+{
+  GLIB_Rectangle_t lineRect;
+  int32_t lineHeight = glibContext.font.lineSpacing + glibContext.font.fontHeight;
+
+  graphLineNum = graphHeaderLines + line;
+
+  lineRect.xMin = 0;
+  lineRect.xMax = glibContext.pDisplayGeometry->xSize - 1;
+  lineRect.yMin = lineHeight * graphLineNum;
+  lineRect.yMax = lineRect.yMin + lineHeight - 1;
+  if (lineRect.yMin >= glibContext.pDisplayGeometry->ySize) {
+    return;
+  }
+  if (lineRect.yMax >= glibContext.pDisplayGeometry->ySize) {
+    lineRect.yMax = glibContext.pDisplayGeometry->ySize - 1;
+  }
+
+#if GRAPH_TEXT_CACHE_SIZE > 0
+  /* A line drawn before is copied from the cache in one go */
+  uint32_t hash = graphHashText(string);
+  if (graphTextCacheDraw(string, hash, &lineRect)) {
+    return;
+  }
+#endif
+
+  /* Clear the pixel rows of this line only, then draw inside them */
+  if (GLIB_setClippingRegion(&glibContext, &lineRect) == GLIB_OK) {
+    GLIB_clearRegion(&glibContext);
+    GLIB_resetDisplayClippingArea(&glibContext);
+    graphPrintCenter(&glibContext, string);
+  }
+  GLIB_resetClippingRegion(&glibContext);
+  GLIB_applyClippingRegion(&glibContext);
+
+#if GRAPH_TEXT_CACHE_SIZE > 0
+  graphTextCacheStore(string, hash, &lineRect);
+#endif
+}
+
+void graphUpdate(void)
+{
+  DMD_updateDisplay();
+}
+
+uint32_t graphHashText(const char *pString)
+{
+  uint32_t hash = 2166136261UL;
+
+  while (*pString) {
+    hash = (hash ^ (uint8_t)*pString++) * 16777619UL;
+  }
+  return hash;
+}
+
+void graphGetTextCacheStats(uint32_t *hits, uint32_t *misses)
+{
+#if GRAPH_TEXT_CACHE_SIZE > 0
+  *hits = graphTextCacheHits;
+  *misses = graphTextCacheMisses;
+#else
+  *hits = 0;
+  *misses = 0;
+#endif
+}
+
 /***************************************************************************************************
    Static Function Definitions
  **************************************************************************************************/
@@ -133,3 +258,101 @@ static void graphPrintCenter(GLIB_Context_t *pContext, char *pString)
     }
   } while (*pString); /* while terminating NULL is not reached */
 }
+
+#if GRAPH_TEXT_CACHE_SIZE > 0
+/***********************************************************************************************//**
+ *  \brief  Split the cache pool into strips of one text line of the current font
+ **************************************************************************************************/
+static void graphTextCacheInit(void)
+{
+  uint32_t lineHeight = glibContext.font.lineSpacing + glibContext.font.fontHeight;
+  uint8_t i;
+
+  graphTextCacheSlotSize = (glibContext.pDisplayGeometry->xSize * lineHeight + 7) / 8;
+  graphTextCacheSlots = GRAPH_TEXT_CACHE_SIZE / graphTextCacheSlotSize;
+  if (graphTextCacheSlots > GRAPH_TEXT_CACHE_ENTRIES) {
+    graphTextCacheSlots = GRAPH_TEXT_CACHE_ENTRIES;
+  }
+
+  memset(graphTextCache, 0, sizeof(graphTextCache));
+  for (i = 0; i < graphTextCacheSlots; i++) {
+    graphTextCache[i].strip = &graphTextCachePool[i * graphTextCacheSlotSize];
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Draw a text line from the cache
+ *  \param[in]  pString  String to be displayed
+ *  \param[in]  hash  Hash of the string
+ *  \param[in]  pRect  Pixel rows of the text line
+ *  \return  true if the line was in the cache and has been drawn
+ **************************************************************************************************/
+static bool graphTextCacheDraw(const char *pString, uint32_t hash, GLIB_Rectangle_t *pRect)
+{
+  uint32_t width = glibContext.pDisplayGeometry->xSize;
+  uint16_t rows = pRect->yMax - pRect->yMin + 1;
+  uint8_t i;
+
+  for (i = 0; i < graphTextCacheSlots; i++) {
+    graphTextCacheEntry_t *pEntry = &graphTextCache[i];
+
+    if (pEntry->lastUse != 0 && pEntry->hash == hash
+        && pEntry->pFont == glibContext.font.pFontPixMap && pEntry->rows == rows
+        && strcmp(pEntry->text, pString) == 0) {
+      if (DMD_setClippingArea(0, pRect->yMin, width, rows) != DMD_OK
+          || DMD_writeData(0, 0, pEntry->strip, width * rows) != DMD_OK) {
+        /* Fall back to drawing the text */
+        GLIB_applyClippingRegion(&glibContext);
+        return false;
+      }
+      GLIB_applyClippingRegion(&glibContext);
+
+      pEntry->lastUse = ++graphTextCacheClock;
+      graphTextCacheHits++;
+      return true;
+    }
+  }
+
+  graphTextCacheMisses++;
+  LOG_DEBUG("text cache miss \"%s\", %" PRIu32 " hits %" PRIu32 " misses",
+            pString, graphTextCacheHits, graphTextCacheMisses);
+  return false;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Copy a freshly drawn text line into the least recently used cache entry
+ *  \param[in]  pString  String that was displayed
+ *  \param[in]  hash  Hash of the string
+ *  \param[in]  pRect  Pixel rows of the text line
+ **************************************************************************************************/
+static void graphTextCacheStore(const char *pString, uint32_t hash, GLIB_Rectangle_t *pRect)
+{
+  uint32_t width = glibContext.pDisplayGeometry->xSize;
+  uint16_t rows = pRect->yMax - pRect->yMin + 1;
+  graphTextCacheEntry_t *pVictim = NULL;
+  uint8_t i;
+
+  if (graphTextCacheSlots == 0 || strlen(pString) >= GRAPH_TEXT_CACHE_TEXT_LEN
+      || (width * rows + 7) / 8 > graphTextCacheSlotSize) {
+    return;
+  }
+
+  for (i = 0; i < graphTextCacheSlots; i++) {
+    if (pVictim == NULL || graphTextCache[i].lastUse < pVictim->lastUse) {
+      pVictim = &graphTextCache[i];
+    }
+  }
+
+  /* Displays without DMD_readData support simply never hit */
+  pVictim->lastUse = 0;
+  if (DMD_setClippingArea(0, pRect->yMin, width, rows) == DMD_OK
+      && DMD_readData(0, 0, pVictim->strip, width * rows) == DMD_OK) {
+    pVictim->hash = hash;
+    pVictim->pFont = glibContext.font.pFontPixMap;
+    pVictim->rows = rows;
+    strcpy(pVictim->text, pString);
+    pVictim->lastUse = ++graphTextCacheClock;
+  }
+  GLIB_applyClippingRegion(&glibContext);
+}
+#endif
@@ -18,6 +18,8 @@
 #ifndef GRAPHICS_H
 #define GRAPHICS_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -38,6 +40,41 @@ void graphInit(char* header);
  **************************************************************************************************/
 void graphWriteString(char *string);
 
+/***********************************************************************************************//**
+ *  \brief  Redraw one text line below the header without touching the rest of the screen
+ *  \note   Only the pixel rows of the given text line are cleared and drawn, call
+ *          graphUpdate() to send them to the display. graphWriteString() must have been
+ *          called once before, the string should not contain new line characters.
+ *  \param[in]  string  String to be displayed center aligned
+ *  \param[in]  line  Text line counted from the first line below the header
+ **************************************************************************************************/
+void graphWriteLine(char *string, uint8_t line);
+
+/***********************************************************************************************//**
+ *  \brief  Send the lines changed by graphWriteLine() to the display
+ **************************************************************************************************/
+void graphUpdate(void);
+
+/***********************************************************************************************//**
+ *  \brief  FNV-1a hash of a string
+ *  \note   Used as the key of the text line cache and by the LCD driver to skip rows rewritten
+ *          with unchanged content.
+ *  \param[in]  pString  String to hash
+ *  \return  Hash of the string
+ **************************************************************************************************/
+uint32_t graphHashText(const char *pString);
+
+/***********************************************************************************************//**
+ *  \brief  Read the statistics of the text line cache used by graphWriteLine()
+ *  \note   Lines are cached as rendered pixel rows, keyed by string and font, within a RAM
+ *          budget of GRAPH_TEXT_CACHE_SIZE bytes. A hit copies the rows into the framebuffer
+ *          instead of drawing the string. Misses are logged with LOG_DEBUG in graphics.c, the
+ *          counts are printed by the "profile" console command.
+ *  \param[out]  hits  Number of lines drawn from the cache
+ *  \param[out]  misses  Number of lines drawn with GLIB
+ **************************************************************************************************/
+void graphGetTextCacheStats(uint32_t *hits, uint32_t *misses);
+
 #ifdef __cplusplus
 }
 #endif
@@ -181,6 +181,49 @@ EMSTATUS DISPLAY_DeviceRegister(DISPLAY_Device_t *device)
   return status;
 }
 
+/**************************************************************************//**
+ * @brief Group the dirty rows of a pixel matrix into runs
+ *
+ * @detail  Consecutive dirty rows share one run. Once runsMax runs are in
+ *          use, the last run is stretched over the clean rows up to the
+ *          remaining dirty ones, so those clean rows are sent unchanged.
+ *          Used by backends with a PixelMatrixDrawRows function to plan
+ *          their transfer blocks.
+ *
+ * @param rowMask  One bit per row, set for the rows to draw.
+ * @param height   Height in pixel rows/lines of the pixel matrix.
+ * @param runs     Receives the runs, in row order.
+ * @param runsMax  Number of entries in runs, at least 1.
+ *
+ * @return  The number of runs, 0 if no row is dirty.
+ *****************************************************************************/
+unsigned int DISPLAY_RowRunsGet(const uint32_t   *rowMask,
+                                unsigned int     height,
+                                DISPLAY_RowRun_t *runs,
+                                unsigned int     runsMax)
+{
+  unsigned int runCnt = 0;
+  unsigned int row;
+
+  for (row = 0; row < height; row++) {
+    if (!(rowMask[row >> 5] & (1UL << (row & 0x1f)))) {
+      continue;
+    }
+
+    if ((runCnt > 0)
+        && ((row == runs[runCnt - 1].last + 1) || (runCnt == runsMax))) {
+      /* Extend the current run up to this row. */
+      runs[runCnt - 1].last = row;
+    } else {
+      runs[runCnt].first = row;
+      runs[runCnt].last  = row;
+      runCnt++;
+    }
+  }
+
+  return runCnt;
+}
+
 /***************  THE REST OF THE FILE IS DOCUMENTATION ONLY !  ***************/
 
 /*******************************************************************************
@@ -157,6 +157,19 @@ typedef struct DISPLAY_Device_t{
   /** Refreshes the display device driver after system change, like changing
       a clock frequency of some related device. */
   EMSTATUS (*pDriverRefresh)(struct DISPLAY_Device_t* device);
+
+  /** Starts copying the rows of the specified pixelMatrix buffer that are
+      set in rowMask (one bit per row, 32 rows per word) to the display device
+      and returns without waiting for the transfer to complete. The buffer
+      must not be modified until pPixelMatrixDrawWait returns. NULL if the
+      device can only draw synchronously. */
+  EMSTATUS (*pPixelMatrixDrawRows)(struct DISPLAY_Device_t* device,
+                                   DISPLAY_PixelMatrix_t pixelMatrix,
+                                   const uint32_t *rowMask,
+                                   unsigned int height);
+
+  /** Waits for a transfer started by pPixelMatrixDrawRows to complete. */
+  EMSTATUS (*pPixelMatrixDrawWait)(struct DISPLAY_Device_t* device);
 } DISPLAY_Device_t;
 
 /**
@@ -47,11 +47,25 @@
 extern "C" {
 #endif
 
+/*******************************************************************************
+ ********************************   TYPEDEFS   *********************************
+ ******************************************************************************/
+
+/** Run of consecutive pixel matrix rows, sent as one block by a backend. */
+typedef struct DISPLAY_RowRun_t{
+  unsigned int   first;   /**< First row of the run. */
+  unsigned int   last;    /**< Last row of the run, inclusive. */
+} DISPLAY_RowRun_t;
+
 /*******************************************************************************
  **************************    FUNCTION PROTOTYPES    **************************
  ******************************************************************************/
 
 EMSTATUS DISPLAY_DeviceRegister(DISPLAY_Device_t *device);
+unsigned int DISPLAY_RowRunsGet(const uint32_t   *rowMask,
+                                unsigned int     height,
+                                DISPLAY_RowRun_t *runs,
+                                unsigned int     runsMax);
 
 #ifdef __cplusplus
 }
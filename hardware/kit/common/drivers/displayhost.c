@@ -0,0 +1,682 @@
+/*
+ * displayhost.c
+ *
+ *  Host display backend, captures DISPLAY updates in memory
+ */
+
+/* The host backend replaces the LS013B7DH03 when the display stack is built
+   for a PC, e.g. to check rendering without a board. It is left out of the
+   firmware build unless DISPLAY_HOST_BACKEND is defined. host/Makefile builds
+   it with the display stack. */
+#if defined(DISPLAY_HOST_BACKEND)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* DISPLAY driver inclusions */
+#include "displayconfigall.h"
+#include "displaypal.h"
+#include "displaybackend.h"
+#include "displayhost.h"
+
+/** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
+
+/*******************************************************************************
+ ********************************  DEFINES  ************************************
+ ******************************************************************************/
+
+#ifndef DISPLAY_HOST_DEVICE_NAME
+#define DISPLAY_HOST_DEVICE_NAME    "Host display #1"
+#endif
+
+/* The pixel matrix has the LS013B7DH03 layout, so that the DMD and GLIB run
+   the same code paths as on the board. */
+#ifdef USE_CONTROL_BYTES
+#define DISPLAY_HOST_CONTROL_BYTES  (2)
+#else
+#define DISPLAY_HOST_CONTROL_BYTES  (0)
+#endif
+
+/* Bytes per line in the pixel matrix, i.e. the stride in bytes. */
+#define DISPLAY_HOST_LINE_BYTES \
+  (DISPLAY_HOST_WIDTH / 8 + DISPLAY_HOST_CONTROL_BYTES)
+
+/* LS013B7DH03 wire format: update command and first line address, then per
+   line the pixels, a dummy byte and the address of the next line. */
+#define DISPLAY_HOST_CMD_BYTES      (2)
+#define DISPLAY_HOST_WIRE_LINE_BYTES  (DISPLAY_HOST_WIDTH / 8 + 2)
+
+/* Offer the row mask interface whenever the LS013B7DH03 driver does. */
+#if defined(PAL_SPI_DMA_CHANNEL) && defined(USE_CONTROL_BYTES)
+#define DISPLAY_HOST_DRAW_ROWS
+#endif
+
+/* Longest stored deflate block. */
+#define PNG_STORED_BLOCK_MAX        (65535)
+
+/*******************************************************************************
+ ********************************  STATICS  ************************************
+ ******************************************************************************/
+
+/* What the display shows, 1 = white. */
+static uint8_t              panel[DISPLAY_HOST_HEIGHT * DISPLAY_HOST_PANEL_STRIDE];
+static DISPLAY_HostStats_t  stats;
+
+/* Frame dumps, see DISPLAY_HostFrameDumpSet. */
+static const char*          frameDumpFormat = NULL;
+static unsigned int         frameDumpCount;
+
+/*******************************************************************************
+ ************************   STATIC FUNCTION PROTOTYPES   ***********************
+ ******************************************************************************/
+
+static EMSTATUS DisplayEnable(DISPLAY_Device_t*     device,
+                              bool                  enable);
+static EMSTATUS PixelMatrixAllocate(DISPLAY_Device_t*     device,
+                                    unsigned int          width,
+#ifdef EMWIN_WORKAROUND
+                                    unsigned int          userStride,
+#endif
+                                    unsigned int          height,
+                                    DISPLAY_PixelMatrix_t *pixelMatrix);
+static EMSTATUS PixelMatrixFree(DISPLAY_Device_t*     device,
+                                DISPLAY_PixelMatrix_t pixelMatrix);
+#ifdef DISPLAY_HOST_DRAW_ROWS
+static EMSTATUS PixelMatrixDrawRows(DISPLAY_Device_t*      device,
+                                    DISPLAY_PixelMatrix_t  pixelMatrix,
+                                    const uint32_t        *rowMask,
+                                    unsigned int           height);
+static EMSTATUS PixelMatrixDrawWait(DISPLAY_Device_t*      device);
+#endif
+static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*     device,
+                                DISPLAY_PixelMatrix_t pixelMatrix,
+                                unsigned int          startColumn,
+                                unsigned int          width,
+#ifdef EMWIN_WORKAROUND
+                                unsigned int          userStride,
+#endif
+                                unsigned int          startRow,
+                                unsigned int          height);
+static EMSTATUS PixelMatrixClear(DISPLAY_Device_t*      device,
+                                 DISPLAY_PixelMatrix_t  pixelMatrix,
+                                 unsigned int           width,
+                                 unsigned int           height);
+static EMSTATUS DriverRefresh (DISPLAY_Device_t* device);
+static uint8_t  bitReverse(uint8_t b);
+static void     be32Put(uint8_t *p, uint32_t value);
+static uint32_t crc32Update(uint32_t crc, const uint8_t *data, unsigned int len);
+static uint32_t adler32(const uint8_t *data, unsigned int len);
+static bool     pngChunkWrite(FILE *file, const char *type,
+                              const uint8_t *data, unsigned int len);
+
+/** @endcond */
+
+/*******************************************************************************
+ **************************     GLOBAL FUNCTIONS      **************************
+ ******************************************************************************/
+
+/**************************************************************************//**
+ * @brief  Initialize the host display driver
+ *
+ * @detail  Registers a monochrome display with the geometry and pixel matrix
+ *          layout of the LS013B7DH03. Updates are copied into an in-memory
+ *          panel instead of being sent over SPI, and counted as they would
+ *          be on the wire.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS DISPLAY_HostInit(void)
+{
+  DISPLAY_Device_t      display;
+
+  /* A fresh display shows white, like the LS013B7DH03 after all clear. */
+  memset(panel, 0xff, sizeof(panel));
+  DISPLAY_HostStatsReset();
+
+  display.name                  = DISPLAY_HOST_DEVICE_NAME;
+  display.colourMode            = DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE;
+  display.addressMode           = DISPLAY_ADDRESSING_BY_ROWS_ONLY;
+  display.geometry.width        = DISPLAY_HOST_WIDTH;
+  display.geometry.height       = DISPLAY_HOST_HEIGHT;
+  /* stride = pixels + ctrl bytes */
+  display.geometry.stride       =
+    display.geometry.width + DISPLAY_HOST_CONTROL_BYTES * 8;
+
+  display.pDisplayPowerOn       = DisplayEnable;
+  display.pPixelMatrixAllocate  = PixelMatrixAllocate;
+  display.pPixelMatrixFree      = PixelMatrixFree;
+  display.pPixelMatrixDraw      = PixelMatrixDraw;
+  display.pPixelMatrixClear     = PixelMatrixClear;
+  display.pDriverRefresh        = DriverRefresh;
+#ifdef DISPLAY_HOST_DRAW_ROWS
+  display.pPixelMatrixDrawRows  = PixelMatrixDrawRows;
+  display.pPixelMatrixDrawWait  = PixelMatrixDrawWait;
+#else
+  display.pPixelMatrixDrawRows  = NULL;
+  display.pPixelMatrixDrawWait  = NULL;
+#endif
+
+  return DISPLAY_DeviceRegister(&display);
+}
+
+/**************************************************************************//**
+ * @brief  Get the contents of the host display.
+ *
+ * @return  The panel, DISPLAY_HOST_PANEL_STRIDE bytes per row, 1 bit per
+ *          pixel with the leftmost pixel in the LSB, a set bit is white.
+ *****************************************************************************/
+const uint8_t *DISPLAY_HostPanel(void)
+{
+  return panel;
+}
+
+/**************************************************************************//**
+ * @brief  Get the transfer statistics of the host display.
+ *
+ * @param[out] stats  Frames, lines and bytes sent since init or the last
+ *                    DISPLAY_HostStatsReset.
+ *****************************************************************************/
+void DISPLAY_HostStatsGet(DISPLAY_HostStats_t *pStats)
+{
+  *pStats = stats;
+}
+
+/**************************************************************************//**
+ * @brief  Reset the transfer statistics of the host display.
+ *****************************************************************************/
+void DISPLAY_HostStatsReset(void)
+{
+  memset(&stats, 0, sizeof(stats));
+}
+
+/**************************************************************************//**
+ * @brief  Write the contents of the host display to a binary PBM file.
+ *
+ * @param[in] fileName  Name of the file to write.
+ *
+ * @return  DISPLAY_EMSTATUS_OK, or DISPLAY_EMSTATUS_INVALID_PARAMETER if the
+ *          file could not be written.
+ *****************************************************************************/
+EMSTATUS DISPLAY_HostDumpPbm(const char *fileName)
+{
+  uint8_t      line[DISPLAY_HOST_PANEL_STRIDE];
+  FILE*        file;
+  unsigned int row;
+  unsigned int i;
+  bool         ok;
+
+  file = fopen(fileName, "wb");
+  if (NULL == file) {
+    return DISPLAY_EMSTATUS_INVALID_PARAMETER;
+  }
+
+  ok = fprintf(file, "P4\n%d %d\n", DISPLAY_HOST_WIDTH, DISPLAY_HOST_HEIGHT) > 0;
+  for (row = 0; ok && (row < DISPLAY_HOST_HEIGHT); row++) {
+    /* PBM wants the leftmost pixel in the MSB and 1 for black. */
+    for (i = 0; i < DISPLAY_HOST_PANEL_STRIDE; i++) {
+      line[i] = ~bitReverse(panel[row * DISPLAY_HOST_PANEL_STRIDE + i]);
+    }
+    ok = fwrite(line, 1, sizeof(line), file) == sizeof(line);
+  }
+
+  if ((0 != fclose(file)) || !ok) {
+    return DISPLAY_EMSTATUS_INVALID_PARAMETER;
+  }
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief  Write the contents of the host display to a PNG file.
+ *
+ * @detail  The image is 1 bit grayscale. The pixel data is stored
+ *          uncompressed in the deflate stream, so no zlib is needed.
+ *
+ * @param[in] fileName  Name of the file to write.
+ *
+ * @return  DISPLAY_EMSTATUS_OK, DISPLAY_EMSTATUS_NOT_ENOUGH_MEMORY, or
+ *          DISPLAY_EMSTATUS_INVALID_PARAMETER if the file could not be
+ *          written.
+ *****************************************************************************/
+EMSTATUS DISPLAY_HostDumpPng(const char *fileName)
+{
+  static const uint8_t signature[8] =
+  { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+  const unsigned int rawSize =
+    DISPLAY_HOST_HEIGHT * (1 + DISPLAY_HOST_PANEL_STRIDE);
+  const unsigned int blocks =
+    (rawSize + PNG_STORED_BLOCK_MAX - 1) / PNG_STORED_BLOCK_MAX;
+  uint8_t      header[13];
+  uint8_t*     raw;
+  uint8_t*     zlib;
+  uint8_t*     p;
+  unsigned int row;
+  unsigned int i;
+  unsigned int len;
+  FILE*        file;
+  bool         ok;
+
+  raw = malloc(rawSize);
+  /* zlib header, a 5 byte header per stored block, Adler-32 */
+  zlib = malloc(2 + blocks * 5 + rawSize + 4);
+  if ((NULL == raw) || (NULL == zlib)) {
+    free(raw);
+    free(zlib);
+    return DISPLAY_EMSTATUS_NOT_ENOUGH_MEMORY;
+  }
+
+  /* Scanlines: filter type 0, then the pixels with the leftmost in the MSB
+     and 1 for white. */
+  p = raw;
+  for (row = 0; row < DISPLAY_HOST_HEIGHT; row++) {
+    *p++ = 0;
+    for (i = 0; i < DISPLAY_HOST_PANEL_STRIDE; i++) {
+      *p++ = bitReverse(panel[row * DISPLAY_HOST_PANEL_STRIDE + i]);
+    }
+  }
+
+  p    = zlib;
+  *p++ = 0x78;
+  *p++ = 0x01;
+  for (i = 0; i < rawSize; i += len) {
+    len = rawSize - i;
+    if (len > PNG_STORED_BLOCK_MAX) {
+      len = PNG_STORED_BLOCK_MAX;
+    }
+    *p++ = (i + len == rawSize) ? 1 : 0;  /* BFINAL, BTYPE stored */
+    *p++ = (uint8_t) len;
+    *p++ = (uint8_t)(len >> 8);
+    *p++ = (uint8_t) ~len;
+    *p++ = (uint8_t)(~len >> 8);
+    memcpy(p, &raw[i], len);
+    p += len;
+  }
+  be32Put(p, adler32(raw, rawSize));
+  p += 4;
+  free(raw);
+
+  be32Put(&header[0], DISPLAY_HOST_WIDTH);
+  be32Put(&header[4], DISPLAY_HOST_HEIGHT);
+  header[8]  = 1;  /* Bit depth */
+  header[9]  = 0;  /* Grayscale */
+  header[10] = 0;  /* Deflate */
+  header[11] = 0;  /* Adaptive filtering */
+  header[12] = 0;  /* No interlace */
+
+  file = fopen(fileName, "wb");
+  if (NULL == file) {
+    free(zlib);
+    return DISPLAY_EMSTATUS_INVALID_PARAMETER;
+  }
+  ok = fwrite(signature, 1, sizeof(signature), file) == sizeof(signature);
+  ok = ok && pngChunkWrite(file, "IHDR", header, sizeof(header));
+  ok = ok && pngChunkWrite(file, "IDAT", zlib, p - zlib);
+  ok = ok && pngChunkWrite(file, "IEND", NULL, 0);
+  free(zlib);
+
+  if ((0 != fclose(file)) || !ok) {
+    return DISPLAY_EMSTATUS_INVALID_PARAMETER;
+  }
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief  Dump the host display to a PNG file after every update frame.
+ *
+ * @param[in] fileNameFormat  printf format of the file names, taking the
+ *                            frame number (counted from 0) as an unsigned
+ *                            int, e.g. "frame%04u.png". NULL stops dumping.
+ *                            The string must stay valid while dumping.
+ *****************************************************************************/
+void DISPLAY_HostFrameDumpSet(const char *fileNameFormat)
+{
+  frameDumpFormat = fileNameFormat;
+  frameDumpCount  = 0;
+}
+
+/** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
+
+/*******************************************************************************
+ *****************************   STATIC FUNCTIONS   ****************************
+ ******************************************************************************/
+
+/**************************************************************************//**
+ * @brief  Refresh the host display device, nothing to do.
+ *****************************************************************************/
+static EMSTATUS DriverRefresh(DISPLAY_Device_t* device)
+{
+  (void) device; /* Suppress compiler warning: unused parameter. */
+
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief  Turn the host display on or off, nothing to do.
+ *****************************************************************************/
+static EMSTATUS DisplayEnable(DISPLAY_Device_t* device,
+                              bool              enable)
+{
+  (void) device; /* Suppress compiler warning: unused parameter. */
+  (void) enable; /* Suppress compiler warning: unused parameter. */
+
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief   Allocate a pixel matrix buffer with malloc.
+ *
+ * @detail  The buffer has the same layout as the LS013B7DH03 ones.
+ *****************************************************************************/
+static EMSTATUS PixelMatrixAllocate(DISPLAY_Device_t*      device,
+                                    unsigned int           width,
+#ifdef EMWIN_WORKAROUND
+                                    unsigned int           userStride,
+#endif
+                                    unsigned int           height,
+                                    DISPLAY_PixelMatrix_t *pixelMatrix)
+{
+#ifdef EMWIN_WORKAROUND
+  unsigned int allocSize = (userStride / 8 + DISPLAY_HOST_CONTROL_BYTES) * height;
+#else
+  unsigned int allocSize = DISPLAY_HOST_LINE_BYTES * height;
+#endif
+
+  (void) device; /* Suppress compiler warning: unused parameter. */
+
+  if (width != DISPLAY_HOST_WIDTH) {
+    return DISPLAY_EMSTATUS_OUT_OF_RANGE;
+  }
+#ifdef EMWIN_WORKAROUND
+  if (userStride < width) {
+    return DISPLAY_EMSTATUS_INVALID_PARAMETER;
+  }
+#endif
+
+  *pixelMatrix = (DISPLAY_PixelMatrix_t) malloc(allocSize);
+  if (NULL == *pixelMatrix) {
+    return DISPLAY_EMSTATUS_NOT_ENOUGH_MEMORY;
+  }
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief   Free a pixel matrix buffer.
+ *****************************************************************************/
+static EMSTATUS PixelMatrixFree(DISPLAY_Device_t*     device,
+                                DISPLAY_PixelMatrix_t pixelMatrix)
+{
+  (void) device; /* Suppress compiler warning: unused parameter. */
+
+  free(pixelMatrix);
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief   Clear a pixel matrix buffer.
+ *
+ * @detail  Sets all pixels to blank and, with USE_CONTROL_BYTES, the line
+ *          trailers the same way as the LS013B7DH03 driver.
+ *****************************************************************************/
+static EMSTATUS PixelMatrixClear(DISPLAY_Device_t*      device,
+                                 DISPLAY_PixelMatrix_t  pixelMatrix,
+                                 unsigned int           width,
+                                 unsigned int           height)
+{
+  uint8_t*       pByte = (uint8_t*) pixelMatrix;
+  unsigned int   i;
+
+  (void) device; /* Suppress compiler warning: unused parameter. */
+  (void) width;  /* Suppress compiler warning: unused parameter. */
+
+  for (i = 0; i < height; i++) {
+    /* Clear line */
+    memset(pByte, 0x00, DISPLAY_HOST_WIDTH / 8);
+    pByte += DISPLAY_HOST_WIDTH / 8;
+
+#ifdef USE_CONTROL_BYTES
+    /* Set dummy byte. */
+    *pByte++ = 0xff;
+    /* Set address of next line */
+    *pByte++ = i + 1;
+#endif
+  }
+
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief   Reverse the bit order of a byte.
+ *****************************************************************************/
+static uint8_t bitReverse(uint8_t b)
+{
+  b = (uint8_t)((b & 0xf0) >> 4 | (b & 0x0f) << 4);
+  b = (uint8_t)((b & 0xcc) >> 2 | (b & 0x33) << 2);
+  b = (uint8_t)((b & 0xaa) >> 1 | (b & 0x55) << 1);
+  return b;
+}
+
+/**************************************************************************//**
+ * @brief   Store a 32 bit value big endian, as PNG wants it.
+ *****************************************************************************/
+static void be32Put(uint8_t *p, uint32_t value)
+{
+  p[0] = (uint8_t)(value >> 24);
+  p[1] = (uint8_t)(value >> 16);
+  p[2] = (uint8_t)(value >> 8);
+  p[3] = (uint8_t) value;
+}
+
+/**************************************************************************//**
+ * @brief   Update a CRC-32 (IEEE 802.3, as used by PNG) with more data.
+ *
+ * @param[in] crc   CRC of the data so far, 0 to start.
+ * @param[in] data  Data to add.
+ * @param[in] len   Length of the data in bytes.
+ *
+ * @return  CRC of all data.
+ *****************************************************************************/
+static uint32_t crc32Update(uint32_t crc, const uint8_t *data, unsigned int len)
+{
+  unsigned int bit;
+
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xedb88320UL & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+/**************************************************************************//**
+ * @brief   Adler-32 checksum of the zlib stream.
+ *****************************************************************************/
+static uint32_t adler32(const uint8_t *data, unsigned int len)
+{
+  uint32_t a = 1;
+  uint32_t b = 0;
+
+  while (len--) {
+    a = (a + *data++) % 65521;
+    b = (b + a) % 65521;
+  }
+  return (b << 16) | a;
+}
+
+/**************************************************************************//**
+ * @brief   Write one PNG chunk.
+ *
+ * @return  true if the chunk was written.
+ *****************************************************************************/
+static bool pngChunkWrite(FILE *file, const char *type,
+                          const uint8_t *data, unsigned int len)
+{
+  uint8_t  word[4];
+  uint32_t crc;
+
+  crc = crc32Update(0, (const uint8_t*) type, 4);
+  crc = crc32Update(crc, data, len);
+
+  be32Put(word, len);
+  if ((fwrite(word, 1, 4, file) != 4) || (fwrite(type, 1, 4, file) != 4)) {
+    return false;
+  }
+  if ((len > 0) && (fwrite(data, 1, len, file) != len)) {
+    return false;
+  }
+  be32Put(word, crc);
+  return fwrite(word, 1, 4, file) == 4;
+}
+
+/**************************************************************************//**
+ * @brief   Send one line of a pixel matrix to the panel.
+ *
+ * @param[in] line  Pixels of the line.
+ * @param[in] row   Row on the display.
+ *****************************************************************************/
+static void panelLineWrite(const uint8_t *line, unsigned int row)
+{
+  if (row < DISPLAY_HOST_HEIGHT) {
+    memcpy(&panel[row * DISPLAY_HOST_PANEL_STRIDE], line,
+           DISPLAY_HOST_PANEL_STRIDE);
+  }
+  stats.lines++;
+  stats.bytes += DISPLAY_HOST_WIRE_LINE_BYTES;
+}
+
+/**************************************************************************//**
+ * @brief   Start an update frame.
+ *****************************************************************************/
+static void panelFrameStart(void)
+{
+  stats.frames++;
+  stats.bytes += DISPLAY_HOST_CMD_BYTES;
+}
+
+/**************************************************************************//**
+ * @brief   End an update frame, dumping the panel if requested.
+ *****************************************************************************/
+static void panelFrameEnd(void)
+{
+  char fileName[256];
+
+  if (NULL != frameDumpFormat) {
+    snprintf(fileName, sizeof(fileName), frameDumpFormat, frameDumpCount++);
+    DISPLAY_HostDumpPng(fileName);
+  }
+}
+
+/**************************************************************************//**
+ * @brief Move and show the contents of a pixel matrix buffer on the panel.
+ *
+ * @param[in] device       Display device pointer.
+ * @param[in] pixelMatrix  Pointer to the pixel matrix buffer to draw.
+ * @param[in] startColumn  Start column on the display, must be 0.
+ * @param[in] width        Width in pixel columns of the pixel matrix to draw,
+ *                         must be the width of the display.
+ * @param[in] startRow     Start row on the display where to start drawing
+ *                         the pixel matrix.
+ * @param[in] height       Height in pixel rows/lines of the pixel matrix.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*      device,
+                                DISPLAY_PixelMatrix_t  pixelMatrix,
+                                unsigned int           startColumn,
+                                unsigned int           width,
+#ifdef EMWIN_WORKAROUND
+                                unsigned int           userStride,
+#endif
+                                unsigned int           startRow,
+                                unsigned int           height)
+{
+  const uint8_t* p = (const uint8_t*) pixelMatrix;
+  unsigned int   i;
+#ifdef EMWIN_WORKAROUND
+  unsigned int   lineBytes = userStride / 8;
+#else
+  unsigned int   lineBytes = DISPLAY_HOST_LINE_BYTES;
+#endif
+
+  (void) width;        /* Suppress compiler warning: unused parameter. */
+  (void) startColumn;  /* Suppress compiler warning: unused parameter. */
+  (void) device;       /* Suppress compiler warning: unused parameter. */
+
+  if (0 == height) {
+    return DISPLAY_EMSTATUS_OK;
+  }
+
+  panelFrameStart();
+  for (i = 0; i < height; i++) {
+    panelLineWrite(p, startRow + i);
+    p += lineBytes;
+  }
+  panelFrameEnd();
+
+  return DISPLAY_EMSTATUS_OK;
+}
+
+#ifdef DISPLAY_HOST_DRAW_ROWS
+/**************************************************************************//**
+ * @brief Move the dirty rows of a pixel matrix buffer onto the panel.
+ *
+ * @detail  Sends the same lines as the LS013B7DH03 driver, planned by
+ *          DISPLAY_RowRunsGet: all dirty rows in one frame, with the clean
+ *          rows between the last runs included once the runs outnumber the
+ *          DMA descriptors. The update is done when the function returns.
+ *
+ * @param[in] device       Display device pointer.
+ * @param[in] pixelMatrix  Pointer to the pixel matrix buffer to draw.
+ * @param[in] rowMask      One bit per row, set for the rows to draw.
+ * @param[in] height       Height in pixel rows/lines of the pixel matrix.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+static EMSTATUS PixelMatrixDrawRows(DISPLAY_Device_t*      device,
+                                    DISPLAY_PixelMatrix_t  pixelMatrix,
+                                    const uint32_t        *rowMask,
+                                    unsigned int           height)
+{
+  const uint8_t*   pBuffer   = (const uint8_t*) pixelMatrix;
+  DISPLAY_RowRun_t runs[PAL_SPI_DMA_DESCRIPTORS - 1];
+  unsigned int     runCnt;
+  unsigned int     i;
+  unsigned int     row;
+
+  (void) device; /* Suppress compiler warning: unused parameter. */
+
+  /* Same runs as the LS013B7DH03 driver, one DMA block each. */
+  runCnt = DISPLAY_RowRunsGet(rowMask, height, runs,
+                              PAL_SPI_DMA_DESCRIPTORS - 1);
+  if (0 == runCnt) {
+    return DISPLAY_EMSTATUS_OK;
+  }
+
+  panelFrameStart();
+  for (i = 0; i < runCnt; i++) {
+    for (row = runs[i].first; row <= runs[i].last; row++) {
+      panelLineWrite(pBuffer + row * DISPLAY_HOST_LINE_BYTES, row);
+    }
+  }
+  panelFrameEnd();
+
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief   Wait for PixelMatrixDrawRows, which is done on return already.
+ *****************************************************************************/
+static EMSTATUS PixelMatrixDrawWait(DISPLAY_Device_t* device)
+{
+  (void) device; /* Suppress compiler warning: unused parameter. */
+
+  return DISPLAY_EMSTATUS_OK;
+}
+#endif /* DISPLAY_HOST_DRAW_ROWS */
+
+/** @endcond */
+
+#endif /* DISPLAY_HOST_BACKEND */
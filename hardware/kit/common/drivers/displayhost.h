@@ -0,0 +1,74 @@
+/*
+ * displayhost.h
+ *
+ *  Host display backend, captures DISPLAY updates in memory
+ */
+
+#ifndef _DISPLAY_HOST_H_
+#define _DISPLAY_HOST_H_
+
+#include <stdint.h>
+#include "emstatus.h"
+
+/** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ ********************************  DEFINES  ************************************
+ ******************************************************************************/
+
+/* Display geometry, the same as the LS013B7DH03 unless overridden. */
+#ifndef DISPLAY_HOST_WIDTH
+#define DISPLAY_HOST_WIDTH          (128)
+#endif
+#ifndef DISPLAY_HOST_HEIGHT
+#define DISPLAY_HOST_HEIGHT         (128)
+#endif
+
+/* Bytes per row of the panel returned by DISPLAY_HostPanel. */
+#define DISPLAY_HOST_PANEL_STRIDE   (DISPLAY_HOST_WIDTH / 8)
+
+/*******************************************************************************
+ ********************************  TYPEDEFS  ***********************************
+ ******************************************************************************/
+
+/* Transfer statistics of the host display. The byte count is what a
+   LS013B7DH03 would be sent over SPI for the same updates. */
+typedef struct DISPLAY_HostStats_t {
+  uint32_t frames;   /* Update frames, i.e. SCS assertions. */
+  uint32_t lines;    /* Lines sent. */
+  uint32_t bytes;    /* Bytes sent, including commands and line trailers. */
+} DISPLAY_HostStats_t;
+
+/*******************************************************************************
+ **************************    FUNCTION PROTOTYPES    **************************
+ ******************************************************************************/
+
+/* Initialization function for the host display driver. */
+EMSTATUS DISPLAY_HostInit(void);
+
+/* Panel contents: 1 bit per pixel, LSB first, a set bit is a white pixel. */
+const uint8_t *DISPLAY_HostPanel(void);
+
+/* Transfer statistics since init or the last reset. */
+void DISPLAY_HostStatsGet(DISPLAY_HostStats_t *stats);
+void DISPLAY_HostStatsReset(void);
+
+/* Write the panel contents to a binary PBM (P4) or a 1 bit grayscale PNG. */
+EMSTATUS DISPLAY_HostDumpPbm(const char *fileName);
+EMSTATUS DISPLAY_HostDumpPng(const char *fileName);
+
+/* Write a PNG after every update frame, named by a printf format taking the
+   frame number as an unsigned int, e.g. "frame%04u.png". NULL stops it. */
+void DISPLAY_HostFrameDumpSet(const char *fileNameFormat);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @endcond */
+
+#endif /* _DISPLAY_HOST_H_ */
@@ -63,6 +63,16 @@
 #define LS013B7DH03_CONTROL_BYTES     (0)
 #endif
 
+/* DMA driven row updates need the line trailers (dummy byte + address of the
+   next line) inside the pixel matrix so that each run of rows is one block. */
+#if defined(PAL_SPI_DMA_CHANNEL) && defined(USE_CONTROL_BYTES)
+#define LS013B7DH03_DMA_SUPPORT
+#endif
+
+/* Bytes per line in the pixel matrix, i.e. the stride in bytes. */
+#define LS013B7DH03_LINE_BYTES \
+  (LS013B7DH03_WIDTH / 8 + LS013B7DH03_CONTROL_BYTES)
+
 #ifdef PIXEL_MATRIX_ALLOC_SUPPORT
 
   #ifdef USE_STATIC_PIXEL_MATRIX_POOL
@@ -106,6 +116,13 @@ typedef uint32_t PixelMatrixAlign_t;
 /* Static variables: */
 static uint8_t        lcdPolarity = 0;
 
+#ifdef LS013B7DH03_DMA_SUPPORT
+/* Update command of the DMA driven transfer, must stay valid while it runs. */
+static uint16_t        dmaCmd;
+/* Blocks of the DMA driven transfer: the command and one per run of rows. */
+static PAL_SpiBuffer_t dmaBlocks[PAL_SPI_DMA_DESCRIPTORS];
+#endif
+
 #ifdef PIXEL_MATRIX_ALLOC_SUPPORT
 #ifdef USE_STATIC_PIXEL_MATRIX_POOL
 #define PIXEL_MATRIX_POOL_ELEMENTS                     \
@@ -138,6 +155,13 @@ static EMSTATUS PixelMatrixAllocate(DISPLAY_Device_t*     device,
 static EMSTATUS PixelMatrixFree(DISPLAY_Device_t*     device,
                                 DISPLAY_PixelMatrix_t pixelMatrix);
 #endif
+#ifdef LS013B7DH03_DMA_SUPPORT
+static EMSTATUS PixelMatrixDrawRows(DISPLAY_Device_t*      device,
+                                    DISPLAY_PixelMatrix_t  pixelMatrix,
+                                    const uint32_t        *rowMask,
+                                    unsigned int           height);
+static EMSTATUS PixelMatrixDrawWait(DISPLAY_Device_t*      device);
+#endif
 static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*     device,
                                 DISPLAY_PixelMatrix_t pixelMatrix,
                                 unsigned int          startColumn,
@@ -234,6 +258,13 @@ EMSTATUS DISPLAY_Ls013b7dh03Init(void)
   display.pPixelMatrixDraw      = PixelMatrixDraw;
   display.pPixelMatrixClear     = PixelMatrixClear;
   display.pDriverRefresh        = DriverRefresh;
+#ifdef LS013B7DH03_DMA_SUPPORT
+  display.pPixelMatrixDrawRows  = PixelMatrixDrawRows;
+  display.pPixelMatrixDrawWait  = PixelMatrixDrawWait;
+#else
+  display.pPixelMatrixDrawRows  = NULL;
+  display.pPixelMatrixDrawWait  = NULL;
+#endif
 
   status = DISPLAY_DeviceRegister(&display);
 
@@ -365,6 +396,13 @@ static EMSTATUS DisplayPolarityInverse(void)
 #endif
 #else /* POLARITY_INVERSION_EXTCOMIN */
 
+#ifdef LS013B7DH03_DMA_SUPPORT
+  /* A DMA driven update owns the bus, invert on the next call instead. */
+  if (PAL_SpiTransmitBusy()) {
+    return DISPLAY_EMSTATUS_OK;
+  }
+#endif
+
   /* Send a packet with inverted com */
   PAL_GpioPinOutSet(LCD_PORT_SCS, LCD_PIN_SCS);
 
@@ -648,6 +686,11 @@ static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*      device,
   (void) startColumn;  /* Suppress compiler warning: unused parameter. */
   (void) device; /* Suppress compiler warning: unused parameter. */
 
+#ifdef LS013B7DH03_DMA_SUPPORT
+  /* Do not interleave with a DMA driven update. */
+  PAL_SpiTransmitWait();
+#endif
+
   /* Need to adjust start row by one because LS013B7DH03 starts counting lines
      from 1, while the DISPLAY interface starts from 0. */
   startRow++;
@@ -701,4 +744,127 @@ static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*      device,
   return DISPLAY_EMSTATUS_OK;
 }
 
+#ifdef LS013B7DH03_DMA_SUPPORT
+/**************************************************************************//**
+ * @brief   Set the trailer of a line in a pixel matrix buffer.
+ *
+ * @param[in]  pixelMatrix  Pointer to the pixel matrix buffer.
+ * @param[in]  row          Row whose trailer to set.
+ * @param[in]  nextRow      Row sent after it, or -1 if it is the last one.
+ *****************************************************************************/
+static void pixelMatrixLinkRow(uint8_t* pixelMatrix,
+                               unsigned int row,
+                               int nextRow)
+{
+  uint8_t* pByte = pixelMatrix + row * LS013B7DH03_LINE_BYTES
+                   + LS013B7DH03_WIDTH / 8;
+
+  /* Dummy byte, then the address of the next line (counted from 1) or
+     dummy data at the end of the last line. */
+  pByte[0] = 0xff;
+  pByte[1] = (nextRow < 0) ? 0xff : (uint8_t)(nextRow + 1);
+}
+
+/**************************************************************************//**
+ * @brief   Transfer done callback, ends the update frame.
+ *****************************************************************************/
+static void PixelMatrixDrawDone(void)
+{
+  /* SCS hold time: min 2us */
+  PAL_TimerMicroSecondsDelay(2);
+
+  /* De-assert SCS */
+  PAL_GpioPinOutClear(LCD_PORT_SCS, LCD_PIN_SCS);
+}
+
+/**************************************************************************//**
+ * @brief Start moving the dirty rows of a pixel matrix buffer onto the display.
+ *
+ * @detail  All dirty rows go out in a single update frame: the trailer of
+ *          each sent row is pointed at the next dirty row, and every run of
+ *          consecutive rows becomes one DMA block. If there are more runs
+ *          than blocks, the last block is stretched over the clean rows up to
+ *          the remaining dirty ones; those rows are resent unchanged.
+ *          The function returns once the transfer is started, the buffer must
+ *          not be touched until PixelMatrixDrawWait returns.
+ *
+ * @param[in] device       Display device pointer.
+ * @param[in] pixelMatrix  Pointer to the pixel matrix buffer to draw.
+ * @param[in] rowMask      One bit per row, set for the rows to draw.
+ * @param[in] height       Height in pixel rows/lines of the pixel matrix.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+static EMSTATUS PixelMatrixDrawRows(DISPLAY_Device_t*      device,
+                                    DISPLAY_PixelMatrix_t  pixelMatrix,
+                                    const uint32_t        *rowMask,
+                                    unsigned int           height)
+{
+  uint8_t*         pBuffer   = (uint8_t*) pixelMatrix;
+  DISPLAY_RowRun_t runs[PAL_SPI_DMA_DESCRIPTORS - 1];
+  unsigned int     runCnt;
+  unsigned int     i;
+  unsigned int     row;
+  EMSTATUS         status;
+
+  (void) device; /* Suppress compiler warning: unused parameter. */
+
+  /* The previous frame must be done before its buffer and blocks are reused. */
+  PAL_SpiTransmitWait();
+
+  /* One block for the command, one per run of rows. */
+  runCnt = DISPLAY_RowRunsGet(rowMask, height, runs,
+                              PAL_SPI_DMA_DESCRIPTORS - 1);
+  if (0 == runCnt) {
+    /* Nothing to draw. */
+    return DISPLAY_EMSTATUS_OK;
+  }
+
+  /* The address of the first row goes with the update command. */
+  dmaCmd = LS013B7DH03_CMD_UPDATE | ((runs[0].first + 1) << 8);
+  dmaBlocks[0].data = (uint8_t*) &dmaCmd;
+  dmaBlocks[0].len  = 2;
+
+  for (i = 0; i < runCnt; i++) {
+    /* Chain the rows of the run, then the run to the next one. */
+    for (row = runs[i].first; row < runs[i].last; row++) {
+      pixelMatrixLinkRow(pBuffer, row, row + 1);
+    }
+    pixelMatrixLinkRow(pBuffer, runs[i].last,
+                       (i + 1 < runCnt) ? (int) runs[i + 1].first : -1);
+
+    dmaBlocks[i + 1].data = pBuffer + runs[i].first * LS013B7DH03_LINE_BYTES;
+    dmaBlocks[i + 1].len  =
+      (runs[i].last - runs[i].first + 1) * LS013B7DH03_LINE_BYTES;
+  }
+
+  /* Assert SCS */
+  PAL_GpioPinOutSet(LCD_PORT_SCS, LCD_PIN_SCS);
+
+  /* SCS setup time: min 6us */
+  PAL_TimerMicroSecondsDelay(6);
+
+  status = PAL_SpiTransmitAsync(dmaBlocks, runCnt + 1, PixelMatrixDrawDone);
+  if (PAL_EMSTATUS_OK != status) {
+    PAL_GpioPinOutClear(LCD_PORT_SCS, LCD_PIN_SCS);
+  }
+
+  return status;
+}
+
+/**************************************************************************//**
+ * @brief   Wait for a transfer started by PixelMatrixDrawRows to complete.
+ *
+ * @param[in] device  Display device pointer.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+static EMSTATUS PixelMatrixDrawWait(DISPLAY_Device_t* device)
+{
+  (void) device; /* Suppress compiler warning: unused parameter. */
+
+  return PAL_SpiTransmitWait();
+}
+#endif /* LS013B7DH03_DMA_SUPPORT */
+
 /** @endcond */
@@ -31,6 +31,8 @@
 #ifndef _DISPLAY_PAL_H_
 #define _DISPLAY_PAL_H_
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "emstatus.h"
 
 #ifdef __cplusplus
@@ -45,6 +47,17 @@ extern "C" {
 #define PAL_EMSTATUS_OK                                  (0) /**< Operation successful. */
 #define PAL_EMSTATUS_INVALID_PARAM (PAL_EMSTATUS_BASE   | 1) /**< Invalid parameter. */
 #define PAL_EMSTATUS_REPEAT_FAILED (PAL_EMSTATUS_BASE   | 2) /**< Repeat failed. */
+#define PAL_EMSTATUS_BUSY          (PAL_EMSTATUS_BASE   | 3) /**< Transfer in progress. */
+
+#ifdef PAL_SPI_DMA_CHANNEL
+/** Number of linked LDMA descriptors, i.e. blocks per DMA driven transfer. */
+#ifndef PAL_SPI_DMA_DESCRIPTORS
+#define PAL_SPI_DMA_DESCRIPTORS    (16)
+#endif
+#if PAL_SPI_DMA_DESCRIPTORS < 2
+#error PAL_SPI_DMA_DESCRIPTORS must be at least 2.
+#endif
+#endif
 
 /** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
 
@@ -58,6 +71,22 @@ typedef enum {
   palGpioModePushPull
 } PAL_GpioMode_t;
 
+#ifdef PAL_SPI_DMA_CHANNEL
+/*******************************************************************************
+ ********************************   TYPEDEFS   *********************************
+ ******************************************************************************/
+
+/** One contiguous block of a DMA driven SPI transfer. */
+typedef struct {
+  uint8_t      *data;  /**< Start of the block, must be 16 bit aligned. */
+  unsigned int  len;   /**< Length of the block in bytes, must be even. */
+} PAL_SpiBuffer_t;
+
+/** Callback invoked from interrupt context when a DMA driven SPI transfer
+    has been completely shifted out. */
+typedef void (*PAL_SpiTransmitDone_t)(void);
+#endif
+
 /*******************************************************************************
  **************************    FUNCTION PROTOTYPES    **************************
  ******************************************************************************/
@@ -199,6 +228,44 @@ EMSTATUS PAL_SpiShutdown (void);
  *****************************************************************************/
 EMSTATUS PAL_SpiTransmit (uint8_t* data, unsigned int len);
 
+#ifdef PAL_SPI_DMA_CHANNEL
+/**************************************************************************//**
+ * @brief      Start a DMA driven transmit of a list of blocks on the SPI
+ *             interface.
+ *
+ * @detail     The blocks are sent back to back in one transfer and the
+ *             function returns as soon as the transfer has been started.
+ *             The blocks must stay untouched until the transfer is done.
+ *
+ * @param[in]  list      List of blocks to transmit.
+ * @param[in]  count     Number of blocks in the list, at most
+ *                       PAL_SPI_DMA_DESCRIPTORS.
+ * @param[in]  callback  Function called when the transfer is done, or NULL.
+ *
+ * @return     EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS PAL_SpiTransmitAsync (const PAL_SpiBuffer_t *list,
+                               unsigned int           count,
+                               PAL_SpiTransmitDone_t  callback);
+
+/**************************************************************************//**
+ * @brief   Check whether a DMA driven SPI transfer is in progress.
+ *
+ * @return  true if a transfer started by PAL_SpiTransmitAsync is not done.
+ *****************************************************************************/
+bool PAL_SpiTransmitBusy (void);
+
+/**************************************************************************//**
+ * @brief   Wait for a DMA driven SPI transfer to complete.
+ *
+ * @detail  The MCU sleeps in EM1 while waiting. Must not be called from an
+ *          interrupt handler with a priority higher than the LDMA interrupt.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS PAL_SpiTransmitWait (void);
+#endif
+
 /**************************************************************************//**
  * @brief   Initialize the PAL Timer interface
  *
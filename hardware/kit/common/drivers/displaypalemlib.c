@@ -45,6 +45,12 @@
 #include "displayconfigall.h"
 #include "displaypal.h"
 
+#ifdef PAL_SPI_DMA_CHANNEL
+#include "em_core.h"
+#include "em_emu.h"
+#include "sleep.h"
+#endif
+
 #ifdef INCLUDE_PAL_GPIO_PIN_AUTO_TOGGLE
 
 #if defined(RTCC_PRESENT) && (RTCC_COUNT > 0) && !defined(PAL_CLOCK_RTC)
@@ -63,10 +69,45 @@
 
 /** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
 
+#ifdef PAL_SPI_DMA_CHANNEL
+/*******************************************************************************
+ ********************************  DEFINES  ************************************
+ ******************************************************************************/
+
+/* Max number of halfwords a single LDMA descriptor can move. */
+#define PAL_SPI_DMA_XFER_MAX \
+  ((_LDMA_CH_CTRL_XFERCNT_MASK >> _LDMA_CH_CTRL_XFERCNT_SHIFT) + 1)
+
+/* LDMA request: the TX buffer level signal of the display USART. */
+#define PAL_SPI_DMA_REQSEL_(n)                 \
+  (LDMA_CH_REQSEL_SOURCESEL_USART ## n         \
+   | LDMA_CH_REQSEL_SIGSEL_USART ## n ## TXBL)
+#define PAL_SPI_DMA_REQSEL(n)         PAL_SPI_DMA_REQSEL_(n)
+
+/*******************************************************************************
+ *********************************  TYPEDEFS  **********************************
+ ******************************************************************************/
+
+/* LDMA linked transfer descriptor, as laid out in memory. */
+typedef struct {
+  uint32_t ctrl;
+  uint32_t src;
+  uint32_t dst;
+  uint32_t link;
+} PalDmaDescriptor_t;
+#endif
+
 /*******************************************************************************
  ********************************  STATICS  ************************************
  ******************************************************************************/
 
+#ifdef PAL_SPI_DMA_CHANNEL
+/* Descriptor list of the DMA driven transfer in progress. */
+static PalDmaDescriptor_t             spiDmaDescriptors[PAL_SPI_DMA_DESCRIPTORS];
+static volatile bool                  spiDmaBusy = false;
+static volatile PAL_SpiTransmitDone_t spiDmaCallback = NULL;
+#endif
+
 #ifdef INCLUDE_PAL_GPIO_PIN_AUTO_TOGGLE
 #ifndef INCLUDE_PAL_GPIO_PIN_AUTO_TOGGLE_HW_ONLY
 /* GPIO port and pin used for the PAL_GpioPinAutoToggle function. */
@@ -148,6 +189,11 @@ EMSTATUS PAL_SpiShutdown(void)
 {
   EMSTATUS status = PAL_EMSTATUS_OK;
 
+#ifdef PAL_SPI_DMA_CHANNEL
+  /* Let a DMA driven transfer finish before the USART goes away. */
+  PAL_SpiTransmitWait();
+#endif
+
   /* Disable the USART device used for SPI. */
   USART_Enable(PAL_SPI_USART_UNIT, usartDisable);
 
@@ -189,6 +235,152 @@ EMSTATUS PAL_SpiTransmit(uint8_t* data, unsigned int len)
   return status;
 }
 
+#ifdef PAL_SPI_DMA_CHANNEL
+/**************************************************************************//**
+ * @brief      Start a DMA driven transmit of a list of blocks on the SPI
+ *             interface.
+ *
+ * @detail     Each block is moved by one LDMA descriptor, 16 bits at a time
+ *             into the USART TXDOUBLE register, and the descriptors are
+ *             linked so the whole list goes out as one transfer. EM2 is
+ *             blocked until the transfer is done since the USART and the
+ *             LDMA are not clocked there.
+ *
+ * @param[in]  list      List of blocks to transmit.
+ * @param[in]  count     Number of blocks in the list.
+ * @param[in]  callback  Function called when the transfer is done, or NULL.
+ *
+ * @return     EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS PAL_SpiTransmitAsync(const PAL_SpiBuffer_t *list,
+                              unsigned int           count,
+                              PAL_SpiTransmitDone_t  callback)
+{
+  PalDmaDescriptor_t *desc   = spiDmaDescriptors;
+  uint32_t            chMask = 1UL << PAL_SPI_DMA_CHANNEL;
+  unsigned int        i;
+
+  if ((0 == count) || (count > PAL_SPI_DMA_DESCRIPTORS)) {
+    return PAL_EMSTATUS_INVALID_PARAM;
+  }
+  if (spiDmaBusy) {
+    return PAL_EMSTATUS_BUSY;
+  }
+
+  for (i = 0; i < count; i++, desc++) {
+    if ((0 == list[i].len) || (list[i].len & 0x1)
+        || ((uintptr_t)list[i].data & 0x1)
+        || (list[i].len / 2 > PAL_SPI_DMA_XFER_MAX)) {
+      return PAL_EMSTATUS_INVALID_PARAM;
+    }
+
+    desc->ctrl = LDMA_CH_CTRL_STRUCTTYPE_TRANSFER
+                 | ((list[i].len / 2 - 1) << _LDMA_CH_CTRL_XFERCNT_SHIFT)
+                 | LDMA_CH_CTRL_BLOCKSIZE_UNIT1
+                 | LDMA_CH_CTRL_REQMODE_BLOCK
+                 | LDMA_CH_CTRL_SRCINC_ONE
+                 | LDMA_CH_CTRL_SIZE_HALFWORD
+                 | LDMA_CH_CTRL_DSTINC_NONE;
+    desc->src  = (uint32_t)list[i].data;
+    desc->dst  = (uint32_t)&PAL_SPI_USART_UNIT->TXDOUBLE;
+    if (i == count - 1) {
+      /* Raise the channel done interrupt once the last block is queued. */
+      desc->ctrl |= LDMA_CH_CTRL_DONEIFSEN;
+      desc->link  = 0;
+    } else {
+      desc->link = ((uint32_t)(desc + 1) & _LDMA_CH_LINK_LINKADDR_MASK)
+                   | LDMA_CH_LINK_LINK;
+    }
+  }
+
+  spiDmaCallback = callback;
+  spiDmaBusy     = true;
+  SLEEP_SleepBlockBegin(sleepEM2);
+
+  /* Other LDMA users (e.g. MSC_WriteWordDma) may have stopped the clock. */
+  CMU_ClockEnable(cmuClock_LDMA, true);
+
+  LDMA->CH[PAL_SPI_DMA_CHANNEL].REQSEL = PAL_SPI_DMA_REQSEL(PAL_SPI_USART_INDEX);
+  LDMA->CH[PAL_SPI_DMA_CHANNEL].CFG    = 0;
+  LDMA->CH[PAL_SPI_DMA_CHANNEL].LOOP   = 0;
+  LDMA->CH[PAL_SPI_DMA_CHANNEL].LINK   =
+    (uint32_t)spiDmaDescriptors & _LDMA_CH_LINK_LINKADDR_MASK;
+
+  LDMA->IFC     = chMask;
+  LDMA->IEN    |= chMask;
+  LDMA->CHDONE &= ~chMask;
+  NVIC_ClearPendingIRQ(LDMA_IRQn);
+  NVIC_EnableIRQ(LDMA_IRQn);
+
+  /* Load the first descriptor and enable the channel. */
+  LDMA->LINKLOAD = chMask;
+
+  return PAL_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief   Check whether a DMA driven SPI transfer is in progress.
+ *
+ * @return  true if a transfer started by PAL_SpiTransmitAsync is not done.
+ *****************************************************************************/
+bool PAL_SpiTransmitBusy(void)
+{
+  return spiDmaBusy;
+}
+
+/**************************************************************************//**
+ * @brief   Wait for a DMA driven SPI transfer to complete.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS PAL_SpiTransmitWait(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  while (spiDmaBusy) {
+    /* Check and sleep with interrupts masked, the pending LDMA interrupt
+       still wakes the core and is taken when they are unmasked again. */
+    CORE_ENTER_CRITICAL();
+    if (spiDmaBusy) {
+      EMU_EnterEM1();
+    }
+    CORE_EXIT_CRITICAL();
+  }
+
+  return PAL_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief   LDMA interrupt handler, finishes a DMA driven SPI transfer.
+ *
+ * @detail  The LDMA is done as soon as the last halfword is written to the
+ *          USART, so wait for the remaining bytes to be shifted out before
+ *          reporting the transfer as complete. That is at most three byte
+ *          times.
+ *****************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  uint32_t              chMask  = 1UL << PAL_SPI_DMA_CHANNEL;
+  uint32_t              pending = LDMA->IF & LDMA->IEN;
+  PAL_SpiTransmitDone_t callback;
+
+  if (pending & chMask) {
+    LDMA->IFC = chMask;
+
+    while (!(PAL_SPI_USART_UNIT->STATUS & USART_STATUS_TXC)) ;
+
+    callback       = spiDmaCallback;
+    spiDmaCallback = NULL;
+    spiDmaBusy     = false;
+    SLEEP_SleepBlockEnd(sleepEM2);
+
+    if (NULL != callback) {
+      callback();
+    }
+  }
+}
+#endif /* PAL_SPI_DMA_CHANNEL */
+
 /**************************************************************************//**
  * @brief   Initialize the PAL Timer interface
  *
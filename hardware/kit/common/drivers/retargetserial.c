@@ -33,7 +33,11 @@
 #include "em_cmu.h"
 #include "em_core.h"
 #include "em_gpio.h"
+#include "em_bus.h"
 #include "retargetserial.h"
+#if defined(RETARGET_USART)
+#include "sleep.h"
+#endif
 
 #if defined(HAL_CONFIG)
 #include "retargetserialhalconfig.h"
@@ -59,17 +63,51 @@
 #include "em_leuart.h"
 #endif
 
-/* Receive buffer */
+/* Receive buffer, written only by the RX interrupt and read only by
+ * RETARGET_ReadChar(), so neither side needs to mask interrupts. */
 #ifndef RXBUFSIZE
-#define RXBUFSIZE    8                          /**< Buffer size for RX */
+#define RXBUFSIZE    256                        /**< Buffer size for RX, power of two */
+#endif
+#if (RXBUFSIZE < 2) || ((RXBUFSIZE & (RXBUFSIZE - 1)) != 0)
+#error "RXBUFSIZE must be a power of two"
+#endif
+static volatile uint32_t rxReadIndex  = 0;      /**< Free running index of the next byte to read */
+static volatile uint32_t rxWriteIndex = 0;      /**< Free running index of the next byte to store */
+static volatile uint8_t  rxBuffer[RXBUFSIZE];   /**< Buffer to store data */
+static volatile bool     rxStalled    = false;  /**< RX interrupt disabled because the buffer was full */
+static RETARGET_RxNotify_t rxNotify   = NULL;   /**< Called when a line is complete or the buffer is full */
+
+/* Transmit buffer, drained by the TX buffer level interrupt. A size of 0
+ * makes RETARGET_WriteChar() wait for the UART to take each byte instead. */
+#ifndef TXBUFSIZE
+#define TXBUFSIZE    256                        /**< Buffer size for TX, power of two or 0 */
 #endif
-static volatile int     rxReadIndex  = 0;       /**< Index in buffer to be read */
-static volatile int     rxWriteIndex = 0;       /**< Index in buffer to be written to */
-static volatile int     rxCount      = 0;       /**< Keeps track of how much data which are stored in the buffer */
-static volatile uint8_t rxBuffer[RXBUFSIZE];    /**< Buffer to store data */
+#if (TXBUFSIZE & (TXBUFSIZE - 1)) != 0
+#error "TXBUFSIZE must be a power of two"
+#endif
+#if TXBUFSIZE > 0
+static volatile uint32_t txReadIndex  = 0;      /**< Free running index of the next byte to send */
+static volatile uint32_t txWriteIndex = 0;      /**< Free running index of the next byte to store */
+static uint8_t           txBuffer[TXBUFSIZE];   /**< Buffer to store data to send */
+static volatile bool     txActive     = false;  /**< TX interrupt enabled, EM2 blocked for USARTs */
+static bool              txDrop       = false;  /**< Drop bytes instead of waiting when full */
+static uint32_t          txHighWatermark = 0;   /**< Most bytes ever stored in the buffer */
+static uint32_t          txDropped    = 0;      /**< Bytes dropped because the buffer was full */
+#endif
+
 static uint8_t          LFtoCRLF    = 0;        /**< LF to CRLF conversion disabled */
 static bool             initialized = false;    /**< Initialize UART/LEUART */
 
+#if defined(RETARGET_USART)
+#define RETARGET_STATUS_TXBL    USART_STATUS_TXBL /**< UART can take more data */
+#define RETARGET_STATUS_RXDATAV USART_STATUS_RXDATAV /**< UART has received data */
+#define RETARGET_IF_RXDATAV     USART_IF_RXDATAV  /**< RX data valid interrupt */
+#else
+#define RETARGET_STATUS_TXBL    LEUART_STATUS_TXBL /**< UART can take more data */
+#define RETARGET_STATUS_RXDATAV LEUART_STATUS_RXDATAV /**< UART has received data */
+#define RETARGET_IF_RXDATAV     LEUART_IF_RXDATAV /**< RX data valid interrupt */
+#endif
+
 /**************************************************************************//**
  * @brief Disable RX interrupt
  *****************************************************************************/
@@ -84,43 +122,152 @@ static void disableRxInterrupt()
 
 /**************************************************************************//**
  * @brief Enable RX interrupt
+ *
+ * @details
+ *   Uses the bit set alias where there is one, so that this does not race
+ *   with the interrupt handlers changing other bits of IEN.
  *****************************************************************************/
 static void enableRxInterrupt()
 {
+  BUS_RegMaskedSet(&RETARGET_UART->IEN, RETARGET_IF_RXDATAV);
+}
+
+#if TXBUFSIZE > 0
+/**************************************************************************//**
+ * @brief Move buffered bytes to the UART while it has room for them
+ *
+ * @details
+ *   Called from the TX interrupt, or with interrupts masked. When the buffer
+ *   runs empty, the TX interrupt is disabled and EM2 is allowed again.
+ *****************************************************************************/
+static void txPump(void)
+{
+  while ((txReadIndex != txWriteIndex)
+         && (RETARGET_UART->STATUS & RETARGET_STATUS_TXBL)) {
+    RETARGET_TX(RETARGET_UART, txBuffer[txReadIndex & (TXBUFSIZE - 1)]);
+    txReadIndex++;
+  }
+
+  if ((txReadIndex == txWriteIndex) && txActive) {
 #if defined(RETARGET_USART)
-  USART_IntEnable(RETARGET_UART, USART_IF_RXDATAV);
+    USART_IntDisable(RETARGET_UART, USART_IF_TXBL);
+    SLEEP_SleepBlockEnd(sleepEM2);
 #else
-  LEUART_IntEnable(RETARGET_UART, LEUART_IF_RXDATAV);
+    LEUART_IntDisable(RETARGET_UART, LEUART_IF_TXBL);
 #endif
+    txActive = false;
+  }
 }
 
 /**************************************************************************//**
- * @brief UART/LEUART IRQ Handler
+ * @brief Store a byte in the TX buffer
+ *
+ * @details
+ *   When the buffer is full, the byte is dropped if enabled by
+ *   RETARGET_SerialTxDrop(). Otherwise bytes are moved to the UART from here
+ *   until there is room, so that this also works when called with interrupts
+ *   disabled.
+ *
+ * @param c Character to transmit
  *****************************************************************************/
-void RETARGET_IRQ_NAME(void)
+static void txPut(char c)
 {
+  uint32_t used;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  used = txWriteIndex - txReadIndex;
+  if (used == TXBUFSIZE) {
+    if (txDrop) {
+      txDropped++;
+      CORE_EXIT_ATOMIC();
+      return;
+    }
+    do {
+      /* Let pending interrupts in between the attempts. */
+      CORE_EXIT_ATOMIC();
+      CORE_ENTER_ATOMIC();
+      txPump();
+      used = txWriteIndex - txReadIndex;
+    } while (used == TXBUFSIZE);
+  }
+
+  txBuffer[txWriteIndex & (TXBUFSIZE - 1)] = (uint8_t)c;
+  txWriteIndex++;
+  used++;
+  if (used > txHighWatermark) {
+    txHighWatermark = used;
+  }
+
+  if (!txActive) {
+    /* The USART stops in EM2, keep the core out of it until the buffer is
+     * empty. */
+    txActive = true;
 #if defined(RETARGET_USART)
-  if (RETARGET_UART->STATUS & USART_STATUS_RXDATAV) {
+    SLEEP_SleepBlockBegin(sleepEM2);
+    USART_IntEnable(RETARGET_UART, USART_IF_TXBL);
 #else
-  if (RETARGET_UART->IF & LEUART_IF_RXDATAV) {
-#endif
-
-    if (rxCount < RXBUFSIZE) {
-      /* There is room for data in the RX buffer so we store the data. */
-      rxBuffer[rxWriteIndex] = RETARGET_RX(RETARGET_UART);
-      rxWriteIndex++;
-      rxCount++;
-      if (rxWriteIndex == RXBUFSIZE) {
-        rxWriteIndex = 0;
-      }
-    } else {
+    LEUART_IntEnable(RETARGET_UART, LEUART_IF_TXBL);
+#endif
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+#if defined(RETARGET_TX_IRQ_NAME)
+/**************************************************************************//**
+ * @brief UART TX IRQ Handler
+ *****************************************************************************/
+void RETARGET_TX_IRQ_NAME(void)
+{
+  txPump();
+}
+#endif
+#endif /* TXBUFSIZE > 0 */
+
+/**************************************************************************//**
+ * @brief UART/LEUART IRQ Handler
+ *****************************************************************************/
+void RETARGET_IRQ_NAME(void)
+{
+  uint32_t writeIndex = rxWriteIndex;
+  bool     notify     = false;
+
+  /* Empty the RX FIFO, not just one byte per interrupt. */
+  while (RETARGET_UART->STATUS & RETARGET_STATUS_RXDATAV) {
+    uint8_t c;
+
+    if (writeIndex - rxReadIndex == RXBUFSIZE) {
       /* The RX buffer is full so we must wait for the RETARGET_ReadChar()
        * function to make some more room in the buffer. RX interrupts are
        * disabled to let the ISR exit. The RX interrupt will be enabled in
        * RETARGET_ReadChar(). */
       disableRxInterrupt();
+      rxStalled = true;
+      notify    = true;
+      break;
+    }
+
+    /* There is room for data in the RX buffer so we store the data. */
+    c = RETARGET_RX(RETARGET_UART);
+    rxBuffer[writeIndex & (RXBUFSIZE - 1)] = c;
+    writeIndex++;
+    if ((c == '\r') || (c == '\n')) {
+      notify = true;
     }
   }
+  /* Publish the bytes only after they are stored. */
+  rxWriteIndex = writeIndex;
+
+  if (notify && (rxNotify != NULL)) {
+    rxNotify();
+  }
+
+#if (TXBUFSIZE > 0) && !defined(RETARGET_TX_IRQ_NAME)
+  /* RX and TX share the interrupt. */
+  if (txActive) {
+    txPump();
+  }
+#endif
 }
 
 /**************************************************************************//**
@@ -141,6 +288,13 @@ void RETARGET_SerialCrLf(int on)
  *****************************************************************************/
 void RETARGET_SerialInit(void)
 {
+#if TXBUFSIZE > 0
+  /* Send what is buffered before the UART is reset. */
+  if (initialized) {
+    RETARGET_SerialFlush();
+  }
+#endif
+
   /* Enable peripheral clocks */
 #if defined(_CMU_HFPERCLKEN0_MASK)
   CMU_ClockEnable(cmuClock_HFPER, true);
@@ -197,6 +351,12 @@ void RETARGET_SerialInit(void)
   USART_IntEnable(RETARGET_UART, USART_IF_RXDATAV);
   NVIC_EnableIRQ(RETARGET_IRQn);
 
+#if (TXBUFSIZE > 0) && defined(RETARGET_TX_IRQ_NAME)
+  /* TX interrupts are enabled while there is data to send */
+  NVIC_ClearPendingIRQ(RETARGET_TX_IRQn);
+  NVIC_EnableIRQ(RETARGET_TX_IRQn);
+#endif
+
   /* Finally enable it */
   USART_Enable(usart, usartEnable);
 
@@ -270,32 +430,46 @@ void RETARGET_SerialInit(void)
  *****************************************************************************/
 int RETARGET_ReadChar(void)
 {
-  int c = -1;
-  CORE_DECLARE_IRQ_STATE;
+  int      c = -1;
+  uint32_t readIndex;
 
   if (initialized == false) {
     RETARGET_SerialInit();
   }
 
-  CORE_ENTER_ATOMIC();
-  if (rxCount > 0) {
-    c = rxBuffer[rxReadIndex];
-    rxReadIndex++;
-    if (rxReadIndex == RXBUFSIZE) {
-      rxReadIndex = 0;
+  readIndex = rxReadIndex;
+  if (readIndex != rxWriteIndex) {
+    c = rxBuffer[readIndex & (RXBUFSIZE - 1)];
+    rxReadIndex = readIndex + 1;
+    /* RX interrupts are disabled when a buffer full condition is entered.
+     * This way flow control can be handled automatically by the hardware.
+     * The interrupt handler only stalls on a full buffer, so if it stalls
+     * after this check there is data left to read and a later call
+     * enables it. */
+    if (rxStalled) {
+      rxStalled = false;
+      enableRxInterrupt();
     }
-    rxCount--;
-    /* Unconditionally enable the RX interrupt. RX interrupts are disabled when
-     * a buffer full condition is entered. This way flow control can be handled
-     * automatically by the hardware. */
-    enableRxInterrupt();
   }
 
-  CORE_EXIT_ATOMIC();
-
   return c;
 }
 
+/**************************************************************************//**
+ * @brief Set a function to be told about received data
+ *
+ * @details
+ *   The function is called from the RX interrupt handler after a CR or LF
+ *   has been stored, and when the RX buffer is full. It should only signal
+ *   the main loop, which then reads the data with RETARGET_ReadChar().
+ *
+ * @param notify Function to call, or NULL for none
+ *****************************************************************************/
+void RETARGET_SerialRxNotifySet(RETARGET_RxNotify_t notify)
+{
+  rxNotify = notify;
+}
+
 /**************************************************************************//**
  * @brief Transmit single byte to USART/LEUART
  * @param c Character to transmit
@@ -307,15 +481,54 @@ int RETARGET_WriteChar(char c)
     RETARGET_SerialInit();
   }
 
+#if TXBUFSIZE > 0
+  /* Add CR or LF to CRLF if enabled */
+  if (LFtoCRLF && (c == '\n')) {
+    txPut('\r');
+  }
+  txPut(c);
+#else
   /* Add CR or LF to CRLF if enabled */
   if (LFtoCRLF && (c == '\n')) {
     RETARGET_TX(RETARGET_UART, '\r');
   }
   RETARGET_TX(RETARGET_UART, c);
+#endif
 
   return c;
 }
 
+/**************************************************************************//**
+ * @brief Select what RETARGET_WriteChar() does when the TX buffer is full
+ * @param on If non-zero, bytes that do not fit are dropped and counted.
+ *           Otherwise RETARGET_WriteChar() waits for room, which is the
+ *           default.
+ *****************************************************************************/
+void RETARGET_SerialTxDrop(int on)
+{
+#if TXBUFSIZE > 0
+  txDrop = on ? true : false;
+#else
+  (void)on;
+#endif
+}
+
+/**************************************************************************//**
+ * @brief Get TX buffer statistics
+ * @param highWatermark Set to the most bytes ever waiting in the TX buffer
+ * @param dropped Set to the number of bytes dropped because it was full
+ *****************************************************************************/
+void RETARGET_SerialTxStats(uint32_t *highWatermark, uint32_t *dropped)
+{
+#if TXBUFSIZE > 0
+  *highWatermark = txHighWatermark;
+  *dropped       = txDropped;
+#else
+  *highWatermark = 0;
+  *dropped       = 0;
+#endif
+}
+
 /**************************************************************************//**
  * @brief Enable hardware flow control. (RTS + CTS)
  * @return true if hardware flow control was enabled and false otherwise.
@@ -339,7 +552,7 @@ bool RETARGET_SerialEnableFlowControl(void)
 }
 
 /**************************************************************************//**
- * @brief Flush UART/LEUART
+ * @brief Flush UART/LEUART, waits until everything buffered has been sent
  *****************************************************************************/
 void RETARGET_SerialFlush(void)
 {
@@ -359,6 +572,14 @@ void RETARGET_SerialFlush(void)
 #define _GENERIC_UART_STATUS_IDLE     LEUART_STATUS_TXC
 #endif
 
+#endif
+
+#if TXBUFSIZE > 0
+  /* Send what is buffered. Masking interrupts lets this work whether the TX
+   * interrupt can run or not. */
+  while (txReadIndex != txWriteIndex) {
+    CORE_ATOMIC_SECTION(txPump(); )
+  }
 #endif
 
   while (!(RETARGET_UART->STATUS & _GENERIC_UART_STATUS_IDLE)) ;
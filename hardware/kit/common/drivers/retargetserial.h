@@ -37,6 +37,7 @@
 #include "retargetserialconfig.h"
 #endif
 #include <stdbool.h>
+#include <stdint.h>
 
 /***************************************************************************//**
  * @addtogroup kitdrv
@@ -56,6 +57,9 @@
 extern "C" {
 #endif
 
+/** Function told about received data, see RETARGET_SerialRxNotifySet(). */
+typedef void (*RETARGET_RxNotify_t)(void);
+
 #if defined(__CROSSWORKS_ARM)
 int __putchar(int ch);
 int __getchar(void);
@@ -68,6 +72,9 @@ void RETARGET_SerialCrLf(int on);
 void RETARGET_SerialInit(void);
 bool RETARGET_SerialEnableFlowControl(void);
 void RETARGET_SerialFlush(void);
+void RETARGET_SerialTxDrop(int on);
+void RETARGET_SerialTxStats(uint32_t *highWatermark, uint32_t *dropped);
+void RETARGET_SerialRxNotifySet(RETARGET_RxNotify_t notify);
 
 #ifdef __cplusplus
 }
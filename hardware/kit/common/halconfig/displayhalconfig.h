@@ -157,10 +157,34 @@ extern int HAL_SPIDISPLAY_EXTCOMIN_CALLBACK (void(*pFunction)(void*),
  */
 #define DISPLAY_DEVICES_MAX   (1)
 
-#if BSP_SPIDISPLAY_DISPLAY == HAL_DISPLAY_SHARP_LS013B7DH03
+#if defined(DISPLAY_HOST_BACKEND)
+// Host build: capture display updates in memory instead of driving the LCD
+
+/** Display color mode, 1 bit per pixel addressed by rows only */
+  #define DISPLAY_COLOUR_MODE_IS_MONOCHROME_INVERSE
+
+/**
+ * Geometry of display device #0 in the system, the host display emulates the
+ * ls013b7dh03 of the WSTK.
+ */
+  #include "displayhost.h"
+  #define DISPLAY0_WIDTH    (DISPLAY_HOST_WIDTH)
+  #define DISPLAY0_HEIGHT   (DISPLAY_HOST_HEIGHT)
+/**
+ * Define all display device driver initialization functions here.
+ */
+  #define DISPLAY_DEVICE_DRIVER_INIT_FUNCTIONS \
+  {                                            \
+    DISPLAY_HostInit,                          \
+    NULL                                       \
+  }
+#elif BSP_SPIDISPLAY_DISPLAY == HAL_DISPLAY_SHARP_LS013B7DH03
   #define SHARP_MEMLCD_DEVICE_NAME   "Sharp LS013B7DH03 #1"
   #define LS013B7DH03_POLARITY_INVERSION_FREQUENCY (64)
 
+/** Display color mode, 1 bit per pixel addressed by rows only */
+  #define DISPLAY_COLOUR_MODE_IS_MONOCHROME_INVERSE
+
 /**
  * Geometry of display device #0 in the system (i.e. ls013b7dh03 on the WSTK)
  * These defines can be used to declare static framebuffers in order to save
@@ -15,6 +15,8 @@
 #else
 #define RETARGET_IRQ_NAME   USART0_RX_IRQHandler
 #define RETARGET_IRQn       USART0_RX_IRQn
+#define RETARGET_TX_IRQ_NAME USART0_TX_IRQHandler
+#define RETARGET_TX_IRQn    USART0_TX_IRQn
 #endif
 #define RETARGET_USART      1
 #elif BSP_SERIAL_APP_PORT == HAL_SERIAL_PORT_USART1
@@ -29,6 +31,8 @@
 #else
 #define RETARGET_IRQ_NAME   USART1_RX_IRQHandler
 #define RETARGET_IRQn       USART1_RX_IRQn
+#define RETARGET_TX_IRQ_NAME USART1_TX_IRQHandler
+#define RETARGET_TX_IRQn    USART1_TX_IRQn
 #endif
 #define RETARGET_USART      1
 #elif BSP_SERIAL_APP_PORT == HAL_SERIAL_PORT_USART2
@@ -43,6 +47,8 @@
 #else
 #define RETARGET_IRQ_NAME   USART2_RX_IRQHandler
 #define RETARGET_IRQn       USART2_RX_IRQn
+#define RETARGET_TX_IRQ_NAME USART2_TX_IRQHandler
+#define RETARGET_TX_IRQn    USART2_TX_IRQn
 #endif
 #define RETARGET_USART      1
 #elif BSP_SERIAL_APP_PORT == HAL_SERIAL_PORT_USART3
@@ -57,6 +63,8 @@
 #else
 #define RETARGET_IRQ_NAME   USART3_RX_IRQHandler
 #define RETARGET_IRQn       USART3_RX_IRQn
+#define RETARGET_TX_IRQ_NAME USART3_TX_IRQHandler
+#define RETARGET_TX_IRQn    USART3_TX_IRQn
 #endif
 #define RETARGET_USART      1
 #elif BSP_SERIAL_APP_PORT == HAL_SERIAL_PORT_USART4
@@ -66,6 +74,8 @@
 #define RETARGET_UART_INDEX 4
 #define RETARGET_IRQ_NAME   USART4_RX_IRQHandler
 #define RETARGET_IRQn       USART4_RX_IRQn
+#define RETARGET_TX_IRQ_NAME USART4_TX_IRQHandler
+#define RETARGET_TX_IRQn    USART4_TX_IRQn
 #define RETARGET_USART      1
 #elif BSP_SERIAL_APP_PORT == HAL_SERIAL_PORT_USART5
 // USART5
@@ -74,6 +84,8 @@
 #define RETARGET_UART_INDEX 5
 #define RETARGET_IRQ_NAME   USART5_RX_IRQHandler
 #define RETARGET_IRQn       USART5_RX_IRQn
+#define RETARGET_TX_IRQ_NAME USART5_TX_IRQHandler
+#define RETARGET_TX_IRQn    USART5_TX_IRQn
 #define RETARGET_USART      1
 #elif BSP_SERIAL_APP_PORT == HAL_SERIAL_PORT_UART0
 // UART0
@@ -87,6 +99,8 @@
 #else
 #define RETARGET_IRQ_NAME   UART0_RX_IRQHandler
 #define RETARGET_IRQn       UART0_RX_IRQn
+#define RETARGET_TX_IRQ_NAME UART0_TX_IRQHandler
+#define RETARGET_TX_IRQn    UART0_TX_IRQn
 #endif
 #define RETARGET_USART      1
 #elif BSP_SERIAL_APP_PORT == HAL_SERIAL_PORT_UART1
@@ -101,6 +115,8 @@
 #else
 #define RETARGET_IRQ_NAME   UART1_RX_IRQHandler
 #define RETARGET_IRQn       UART1_RX_IRQn
+#define RETARGET_TX_IRQ_NAME UART1_TX_IRQHandler
+#define RETARGET_TX_IRQn    UART1_TX_IRQn
 #endif
 #define RETARGET_USART      1
 #elif BSP_SERIAL_APP_PORT == HAL_SERIAL_PORT_LEUART0
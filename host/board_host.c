@@ -0,0 +1,152 @@
+/*
+ * board_host.c
+ *
+ *  Host stand-ins for the MCU, board and driver functions the switch calls, for the switch
+ *  simulation.  Clocks, interrupts and the serial port do nothing.  The GPIO registers are in
+ *  host memory, see sim/em_device.h, and an input with a pull resistor reads as the level of the
+ *  pull, so the buttons read as released once gpioInit() sets their pull-ups.  The sleeptimer
+ *  counts microseconds of the host's monotonic clock.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_core.h"
+#include "em_gpio.h"
+#include "sl_sleeptimer.h"
+#include "retargetserial.h"
+#include "init_mcu.h"
+#include "init_board.h"
+#include "init_app.h"
+
+#define HOST_SLEEPTIMER_HZ	1000000UL
+
+GPIO_TypeDef hostGpio;
+NVIC_Type hostNvic;
+
+void initMcu(void)
+{
+}
+
+void initBoard(void)
+{
+}
+
+void initApp(void)
+{
+}
+
+void initVcomEnable(void)
+{
+}
+
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable)
+{
+	(void)clock;
+	(void)enable;
+}
+
+CORE_irqState_t CORE_EnterAtomic(void)
+{
+	return 0;
+}
+
+void CORE_ExitAtomic(CORE_irqState_t irqState)
+{
+	(void)irqState;
+}
+
+/**
+ * Sets the output level, which an input with a pull resistor also reads as
+ */
+void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out)
+{
+	if (out) {
+		GPIO_PinOutSet(port, pin);
+	} else {
+		GPIO_PinOutClear(port, pin);
+	}
+	if (mode == gpioModeInputPull || mode == gpioModeInputPullFilter) {
+		/* DIN is read only on the chip */
+		BUS_RegBitWrite((volatile uint32_t *)&GPIO->P[port].DIN, pin, out != 0);
+	}
+}
+
+void GPIO_DriveStrengthSet(GPIO_Port_TypeDef port, GPIO_DriveStrength_TypeDef strength)
+{
+	(void)port;
+	(void)strength;
+}
+
+void GPIO_ExtIntConfig(GPIO_Port_TypeDef port, unsigned int pin, unsigned int intNo,
+		bool risingEdge, bool fallingEdge, bool enable)
+{
+	(void)port;
+	(void)pin;
+	(void)intNo;
+	(void)risingEdge;
+	(void)fallingEdge;
+	(void)enable;
+}
+
+sl_status_t sl_sleeptimer_init(void)
+{
+	return SL_STATUS_OK;
+}
+
+uint64_t sl_sleeptimer_get_tick_count64(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * HOST_SLEEPTIMER_HZ + (uint64_t)ts.tv_nsec / (1000000000UL / HOST_SLEEPTIMER_HZ);
+}
+
+uint32_t sl_sleeptimer_get_tick_count(void)
+{
+	return (uint32_t)sl_sleeptimer_get_tick_count64();
+}
+
+uint32_t sl_sleeptimer_get_timer_frequency(void)
+{
+	return HOST_SLEEPTIMER_HZ;
+}
+
+sl_status_t sl_sleeptimer_tick64_to_ms(uint64_t tick, uint64_t *ms)
+{
+	*ms = tick / (HOST_SLEEPTIMER_HZ / 1000);
+	return SL_STATUS_OK;
+}
+
+/**
+ * printf goes straight to stdout on the host, and nothing is received
+ */
+void RETARGET_SerialInit(void)
+{
+}
+
+void RETARGET_SerialCrLf(int on)
+{
+	(void)on;
+}
+
+void RETARGET_SerialFlush(void)
+{
+	fflush(stdout);
+}
+
+int RETARGET_ReadChar(void)
+{
+	return -1;
+}
+
+int RETARGET_WriteChar(char c)
+{
+	return putchar(c);
+}
+
+void RETARGET_SerialRxNotifySet(RETARGET_RxNotify_t notify)
+{
+	(void)notify;
+}
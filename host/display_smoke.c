@@ -0,0 +1,103 @@
+/*
+ * display_smoke.c
+ *
+ *  Renders the LCD rows of the switch through lcd_driver, graphics, GLIB and DMD onto the
+ *  host display backend and checks the panel.  Writes display_smoke.pbm and display_smoke.png.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "native_gecko.h"
+#include "lcd_driver.h"
+#include "display.h"
+#include "displayhost.h"
+#include "graphics.h"
+
+/* FNV-1a of the panel after the first render, update when the fonts or layout change on purpose */
+#define SMOKE_PANEL_HASH	0x8de03447UL
+
+#define PANEL_SIZE	(DISPLAY_HOST_PANEL_STRIDE * DISPLAY_HOST_HEIGHT)
+
+static int failures;
+
+/**
+ * lcd_driver posts a flush signal to the main loop, the smoke test flushes directly instead
+ */
+void gecko_external_signal(uint32 signals)
+{
+	(void)signals;
+}
+
+static void check(int ok, const char *what)
+{
+	printf("%s: %s\n", ok ? "ok" : "FAIL", what);
+	if (!ok) {
+		failures++;
+	}
+}
+
+static uint32_t panelHash(void)
+{
+	const uint8_t *panel = DISPLAY_HostPanel();
+	uint32_t hash = 2166136261UL;
+	int i;
+
+	for (i = 0; i < PANEL_SIZE; i++) {
+		hash = (hash ^ panel[i]) * 16777619UL;
+	}
+	return hash;
+}
+
+static void writeRows(void)
+{
+	LCD_write("switch node 1a2b", LCD_ROW_NAME);
+	LCD_write("provisioned", LCD_ROW_STATUS);
+	LCD_write("connected", LCD_ROW_CONNECTION);
+	LCD_write("LPN with friend", LCD_ROW_LPN);
+	LCD_write("Lightness: 75%", LCD_ROW_LIGHTNESS);
+	LCD_write("ColorTemp: 4500K", LCD_ROW_TEMPERATURE);
+}
+
+int main(void)
+{
+	static uint8_t first[PANEL_SIZE];
+	DISPLAY_HostStats_t stats;
+	uint32_t frames;
+	uint32_t hash;
+	int i;
+
+	LCD_init();
+	writeRows();
+	LCD_flush();
+	memcpy(first, DISPLAY_HostPanel(), PANEL_SIZE);
+	hash = panelHash();
+	printf("panel hash 0x%08lx\n", (unsigned long)hash);
+	check(hash == SMOKE_PANEL_HASH, "first render matches the reference panel");
+	check(DISPLAY_HostDumpPbm("display_smoke.pbm") == DISPLAY_EMSTATUS_OK
+	      && DISPLAY_HostDumpPng("display_smoke.png") == DISPLAY_EMSTATUS_OK, "panel dumps written");
+
+	/* rows rewritten with the text already shown send nothing */
+	DISPLAY_HostStatsGet(&stats);
+	frames = stats.frames;
+	writeRows();
+	LCD_flush();
+	DISPLAY_HostStatsGet(&stats);
+	check(stats.frames == frames, "unchanged rows are not redrawn");
+
+	/* a changed row is redrawn, and changing it back restores the first panel */
+	for (i = 0; i < 100; i++) {
+		char text[LCD_ROW_LEN];
+
+		snprintf(text, sizeof(text), "Level: %d", i);
+		LCD_write(text, LCD_ROW_LIGHTNESS);
+		LCD_flush();
+	}
+	DISPLAY_HostStatsGet(&stats);
+	check(stats.frames == frames + 100, "each changed row is sent in one frame");
+	check(memcmp(first, DISPLAY_HostPanel(), PANEL_SIZE) != 0, "changed row differs from the first panel");
+	writeRows();
+	LCD_flush();
+	check(memcmp(first, DISPLAY_HostPanel(), PANEL_SIZE) == 0, "restored rows give the first panel again");
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,313 @@
+/*
+ * gecko_replay.c
+ *
+ *  Host stand-in for the native_gecko layer, for the switch simulation.  main.c runs unchanged on
+ *  top of it, renamed to switchMain(), with the stack events replayed from a recorded file.
+ *
+ *  gecko_wait_event() returns the next event of the file, or an external signal event when
+ *  gecko_external_signal() was called since the last one, like the stack does.  Each call also
+ *  ends the dispatch of the event before: the time since it was returned is reported as the
+ *  handler latency of that event, along with the number of BGAPI commands it issued.  At the end
+ *  of the file the totals and the event loop profile are printed and the program exits.
+ *
+ *  Commands succeed without doing anything.  Their responses are zeroed, which reads as
+ *  bg_err_success, only system_get_bt_address returns an address.
+ *
+ *  Event files hold the BGAPI packets of the events as hex bytes: the four byte header, in which
+ *  byte 0 is 0xa0 for an event, byte 1 the payload length, bytes 2 and 3 the class and method,
+ *  followed by the payload in little endian.  Whitespace is ignored and # starts a comment which
+ *  runs to the end of the line.  External signals from the switch are not in the files, they are
+ *  made up during the replay.
+ *
+ *  Usage: switch_sim <event file>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "native_gecko.h"
+#include "src/profile.h"
+
+#define REPLAY_MAX_BYTES	65536
+#define EVT_HEADER_TYPE_MASK	0xf8UL
+#define EVT_HEADER_TYPE		((uint32_t)gecko_dev_type_gecko | gecko_msg_type_evt)
+
+/* Command handlers of the commands the switch, mesh_lib and mesh_sensor issue */
+#define HOST_BT_COMMANDS(X) \
+	X(flash_ps_erase_all) \
+	X(gatt_server_send_user_write_response) \
+	X(gatt_server_write_attribute_value) \
+	X(hardware_set_soft_timer) \
+	X(le_connection_close) \
+	X(mesh_generic_client_get) \
+	X(mesh_generic_client_init) \
+	X(mesh_generic_client_publish) \
+	X(mesh_generic_client_set) \
+	X(mesh_generic_server_publish) \
+	X(mesh_generic_server_response) \
+	X(mesh_generic_server_update) \
+	X(mesh_lpn_config) \
+	X(mesh_lpn_deinit) \
+	X(mesh_lpn_establish_friendship) \
+	X(mesh_lpn_init) \
+	X(mesh_lpn_terminate_friendship) \
+	X(mesh_node_init) \
+	X(mesh_node_start_unprov_beaconing) \
+	X(mesh_scene_client_init) \
+	X(mesh_sensor_server_init) \
+	X(system_get_bt_address) \
+	X(system_reset)
+
+#define HOST_BT_COMMAND_STUB(name) \
+	void sli_bt_cmd_##name(const void *payload) { (void)payload; }
+HOST_BT_COMMANDS(HOST_BT_COMMAND_STUB)
+
+/* Address returned by system_get_bt_address, least significant byte first */
+static const bd_addr replayAddress = { { 0x3c, 0x2b, 0x1a, 0x57, 0x0b, 0x00 } };
+
+static const struct {
+	uint32_t id;
+	const char *name;
+} eventNames[] = {
+	{ gecko_evt_system_boot_id, "system_boot" },
+	{ gecko_evt_system_external_signal_id, "system_external_signal" },
+	{ gecko_evt_hardware_soft_timer_id, "hardware_soft_timer" },
+	{ gecko_evt_le_connection_opened_id, "le_connection_opened" },
+	{ gecko_evt_le_connection_closed_id, "le_connection_closed" },
+	{ gecko_evt_le_connection_parameters_id, "le_connection_parameters" },
+	{ gecko_evt_le_gap_adv_timeout_id, "le_gap_adv_timeout" },
+	{ gecko_evt_gatt_server_user_write_request_id, "gatt_server_user_write_request" },
+	{ gecko_evt_mesh_node_initialized_id, "mesh_node_initialized" },
+	{ gecko_evt_mesh_node_provisioning_started_id, "mesh_node_provisioning_started" },
+	{ gecko_evt_mesh_node_provisioned_id, "mesh_node_provisioned" },
+	{ gecko_evt_mesh_node_provisioning_failed_id, "mesh_node_provisioning_failed" },
+	{ gecko_evt_mesh_node_reset_id, "mesh_node_reset" },
+	{ gecko_evt_mesh_lpn_friendship_established_id, "mesh_lpn_friendship_established" },
+	{ gecko_evt_mesh_lpn_friendship_failed_id, "mesh_lpn_friendship_failed" },
+	{ gecko_evt_mesh_lpn_friendship_terminated_id, "mesh_lpn_friendship_terminated" },
+};
+
+static struct gecko_cmd_packet cmdPacket;
+static struct gecko_cmd_packet rspPacket;
+static struct gecko_cmd_packet evtPacket;
+void *gecko_cmd_msg_buf = &cmdPacket;
+void *gecko_rsp_msg_buf = &rspPacket;
+
+static const char *replayPath;
+static uint8_t replayBytes[REPLAY_MAX_BYTES];
+static size_t replayLength;
+static size_t replayPos;
+static uint32_t pendingSignals;
+
+static bool dispatching;		/* an event was returned and its handler is running */
+static struct timespec dispatchStart;
+static uint32_t eventCount;
+static uint32_t eventCommands;	/* commands issued by the event being handled */
+static uint32_t totalCommands;
+static double totalUs;
+static double maxUs;
+
+static const char *eventName(uint32_t id)
+{
+	static char unknown[16];
+	size_t i;
+
+	for (i = 0; i < sizeof(eventNames) / sizeof(eventNames[0]); i++) {
+		if (eventNames[i].id == id) {
+			return eventNames[i].name;
+		}
+	}
+	snprintf(unknown, sizeof(unknown), "0x%08lx", (unsigned long)id);
+	return unknown;
+}
+
+/**
+ * Read the hex bytes of an event file
+ * @return false if the file cannot be read or holds something else
+ */
+static bool replayLoad(const char *path)
+{
+	FILE *file = fopen(path, "r");
+	int c;
+
+	if (file == NULL) {
+		perror(path);
+		return false;
+	}
+	replayPath = path;
+	replayLength = 0;
+	while ((c = fgetc(file)) != EOF) {
+		char hex[3] = { 0 };
+
+		if (c == '#') {
+			while (c != '\n' && c != EOF) {
+				c = fgetc(file);
+			}
+			continue;
+		}
+		if (isspace(c)) {
+			continue;
+		}
+		hex[0] = (char)c;
+		c = fgetc(file);
+		hex[1] = (c == EOF) ? 0 : (char)c;
+		if (!isxdigit((unsigned char)hex[0]) || !isxdigit((unsigned char)hex[1])
+		    || replayLength == REPLAY_MAX_BYTES) {
+			fprintf(stderr, "%s: not a hex byte at '%s', or too many bytes\n", path, hex);
+			fclose(file);
+			return false;
+		}
+		replayBytes[replayLength++] = (uint8_t)strtoul(hex, NULL, 16);
+	}
+	fclose(file);
+	return true;
+}
+
+static double elapsedUs(const struct timespec *start)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1e6 + (now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+/**
+ * Report the handler latency of the event returned last
+ */
+static void replayDispatchDone(void)
+{
+	double us;
+
+	if (!dispatching) {
+		return;
+	}
+	us = elapsedUs(&dispatchStart);
+	dispatching = false;
+	totalUs += us;
+	if (us > maxUs) {
+		maxUs = us;
+	}
+	printf("replay: %3lu %-32s %9.1f us %3lu commands\n", (unsigned long)eventCount,
+	       eventName(BGLIB_MSG_ID(evtPacket.header)), us, (unsigned long)eventCommands);
+}
+
+static void replayFinish(void)
+{
+	printf("replay: %lu events in %.1f us, max %.1f us, %lu commands\n",
+	       (unsigned long)eventCount, totalUs, maxUs, (unsigned long)totalCommands);
+	profileDump();
+	fflush(stdout);
+	exit(0);
+}
+
+/**
+ * Take the next event from the file into evtPacket, ends the replay at the end of the file
+ */
+static void replayNext(void)
+{
+	uint32_t header;
+	uint32_t length;
+
+	if (replayPos == replayLength) {
+		replayFinish();
+	}
+	if (replayLength - replayPos < BGLIB_MSG_HEADER_LEN) {
+		fprintf(stderr, "%s: truncated header at byte %lu\n", replayPath, (unsigned long)replayPos);
+		exit(2);
+	}
+	header = replayBytes[replayPos] | (uint32_t)replayBytes[replayPos + 1] << 8
+		| (uint32_t)replayBytes[replayPos + 2] << 16 | (uint32_t)replayBytes[replayPos + 3] << 24;
+	length = BGLIB_MSG_LEN(header);
+	if ((header & EVT_HEADER_TYPE_MASK) != EVT_HEADER_TYPE || length > sizeof(evtPacket.data)
+	    || replayLength - replayPos - BGLIB_MSG_HEADER_LEN < length) {
+		fprintf(stderr, "%s: no event of %lu bytes at byte %lu\n", replayPath,
+			(unsigned long)length, (unsigned long)replayPos);
+		exit(2);
+	}
+	memset(&evtPacket, 0, sizeof(evtPacket));
+	evtPacket.header = header;
+	memcpy(&evtPacket.data, &replayBytes[replayPos + BGLIB_MSG_HEADER_LEN], length);
+	replayPos += BGLIB_MSG_HEADER_LEN + length;
+}
+
+struct gecko_cmd_packet *gecko_wait_event(void)
+{
+	replayDispatchDone();
+	if (pendingSignals) {
+		memset(&evtPacket, 0, sizeof(evtPacket));
+		evtPacket.header = gecko_evt_system_external_signal_id
+			| (sizeof(evtPacket.data.evt_system_external_signal) << 8);
+		evtPacket.data.evt_system_external_signal.extsignals = pendingSignals;
+		pendingSignals = 0;
+	} else {
+		replayNext();
+	}
+	eventCount++;
+	eventCommands = 0;
+	dispatching = true;
+	clock_gettime(CLOCK_MONOTONIC, &dispatchStart);
+	return &evtPacket;
+}
+
+void gecko_external_signal(uint32 signals)
+{
+	pendingSignals |= signals;
+}
+
+void sli_bt_cmd_handler_delegate(uint32_t header, gecko_cmd_handler handler, const void *payload)
+{
+	memset(&rspPacket, 0, sizeof(rspPacket));
+	rspPacket.header = BGLIB_MSG_ID(header);
+	handler(payload);
+	if (BGLIB_MSG_ID(header) == gecko_cmd_system_get_bt_address_id) {
+		rspPacket.data.rsp_system_get_bt_address.address = replayAddress;
+	}
+	eventCommands++;
+	totalCommands++;
+}
+
+/**
+ * The mesh stack passes all events on to the application
+ */
+bool mesh_bgapi_listener(struct gecko_cmd_packet *evt)
+{
+	(void)evt;
+	return true;
+}
+
+errorcode_t gecko_stack_init(const gecko_configuration_t *config)
+{
+	(void)config;
+	return bg_err_success;
+}
+
+void gecko_bgapi_class_dfu_init(void) {}
+void gecko_bgapi_class_system_init(void) {}
+void gecko_bgapi_class_le_gap_init(void) {}
+void gecko_bgapi_class_le_connection_init(void) {}
+void gecko_bgapi_class_gatt_server_init(void) {}
+void gecko_bgapi_class_hardware_init(void) {}
+void gecko_bgapi_class_flash_init(void) {}
+void gecko_bgapi_class_test_init(void) {}
+void gecko_bgapi_class_mesh_node_init(void) {}
+void gecko_bgapi_class_mesh_proxy_init(void) {}
+void gecko_bgapi_class_mesh_proxy_server_init(void) {}
+void gecko_bgapi_class_mesh_generic_client_init(void) {}
+void gecko_bgapi_class_mesh_lpn_init(void) {}
+void gecko_bgapi_class_mesh_scene_client_init(void) {}
+
+int switchMain(void);
+
+int main(int argc, char *argv[])
+{
+	if (argc != 2) {
+		fprintf(stderr, "usage: switch_sim <event file>\n");
+		return 2;
+	}
+	if (!replayLoad(argv[1])) {
+		return 2;
+	}
+	return switchMain();
+}
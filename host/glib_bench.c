@@ -0,0 +1,325 @@
+/*
+ * glib_bench.c
+ *
+ *  Times the GLIB span and line paths against the per-span and per-pixel paths they replaced,
+ *  on the host display backend.  Each scene is drawn by both paths into the same frame buffer
+ *  and the panels must match pixel for pixel.
+ *
+ *  The old paths are kept here as reference code:
+ *  * refSpan() is the previous GLIB_drawLineH, which narrowed the DMD clipping area to the span,
+ *    wrote it with DMD_writeColor and restored the clipping area afterwards.
+ *  * refCircleFilled() and refPolygonFilled() are the previous fills, one refSpan() per span.
+ *  * refLine() is the previous GLIB_drawLine, one GLIB_drawPixel per pixel.
+ *
+ *  Usage: glib_bench [frames]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "glib.h"
+#include "dmd.h"
+#include "display.h"
+#include "displayhost.h"
+
+#define PANEL_SIZE	(DISPLAY_HOST_PANEL_STRIDE * DISPLAY_HOST_HEIGHT)
+#define STAR_POINTS	12
+
+typedef void (*drawScene_t)(GLIB_Context_t *context, int reference);
+
+static GLIB_Context_t context;
+static int failures;
+
+static EMSTATUS refSpan(GLIB_Context_t *pContext, int32_t x1, int32_t y, int32_t x2)
+{
+	EMSTATUS status;
+	int32_t swap;
+	uint8_t red, green, blue;
+	uint32_t length;
+
+	if ((y < pContext->clippingRegion.yMin) || (y > pContext->clippingRegion.yMax)) {
+		return GLIB_ERROR_NOTHING_TO_DRAW;
+	}
+	if (x1 > x2) {
+		swap = x1;
+		x1 = x2;
+		x2 = swap;
+	}
+	if ((x1 > pContext->clippingRegion.xMax) || (x2 < pContext->clippingRegion.xMin)) {
+		return GLIB_ERROR_NOTHING_TO_DRAW;
+	}
+	if (x1 < pContext->clippingRegion.xMin) {
+		x1 = pContext->clippingRegion.xMin;
+	}
+	if (x2 > pContext->clippingRegion.xMax) {
+		x2 = pContext->clippingRegion.xMax;
+	}
+
+	length = x2 - x1 + 1;
+	status = DMD_setClippingArea(x1, y, length, 1);
+	if (status != DMD_OK) {
+		return status;
+	}
+	GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
+	status = DMD_writeColor(0, 0, red, green, blue, length);
+	if (status != DMD_OK) {
+		return status;
+	}
+	return GLIB_applyClippingRegion(pContext);
+}
+
+static void refCircleFilled(GLIB_Context_t *pContext, int32_t xCenter, int32_t yCenter, uint32_t radius)
+{
+	int32_t x = 0;
+	int32_t y = radius;
+	int32_t d = 1 - radius;
+
+	refSpan(pContext, xCenter - y, yCenter, xCenter + y);
+	while (x < y) {
+		if (d < 0) {
+			d += 2 * x + 1;
+		} else {
+			y--;
+			d += 2 * (x - y) + 1;
+		}
+		refSpan(pContext, xCenter - x, yCenter + y, xCenter + x);
+		refSpan(pContext, xCenter - y, yCenter + x, xCenter + y);
+		refSpan(pContext, xCenter - x, yCenter - y, xCenter + x);
+		refSpan(pContext, xCenter - y, yCenter - x, xCenter + y);
+		x++;
+	}
+}
+
+static void refPolygonFilled(GLIB_Context_t *pContext, uint32_t numPoints, const int32_t *polyPoints)
+{
+	int32_t crossX[STAR_POINTS];
+	int32_t curY, minY, maxY;
+	uint32_t i, j, crosses;
+
+	minY = maxY = polyPoints[1];
+	for (i = 1; i < numPoints; i++) {
+		curY = polyPoints[2 * i + 1];
+		minY = (curY < minY) ? curY : minY;
+		maxY = (curY > maxY) ? curY : maxY;
+	}
+	minY = (minY < pContext->clippingRegion.yMin) ? pContext->clippingRegion.yMin : minY;
+	maxY = (maxY > pContext->clippingRegion.yMax) ? pContext->clippingRegion.yMax : maxY;
+
+	for (curY = minY; curY < maxY; curY++) {
+		crosses = 0;
+		j = numPoints - 1;
+		for (i = 0; i < numPoints; i++) {
+			int32_t cy = polyPoints[i * 2 + 1];
+			int32_t py = polyPoints[j * 2 + 1];
+
+			if ((cy < curY && py >= curY) || (py < curY && cy >= curY)) {
+				int32_t cx = polyPoints[i * 2];
+				int32_t px = polyPoints[j * 2];
+
+				crossX[crosses++] = (int) (cx + (curY - cy) / (float)(py - cy) * (float)(px - cx));
+			}
+			j = i;
+		}
+		for (i = 0; i < crosses; i += 2) {
+			refSpan(pContext, crossX[i], curY, crossX[i + 1]);
+		}
+	}
+}
+
+/**
+ * Lines inside the clipping region only, the old code clipped the end points before stepping
+ */
+static void refLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+	int32_t error, deltaX, deltaY;
+	int32_t yStep = 1;
+	int steep;
+
+	steep = abs(y2 - y1) > abs(x2 - x1);
+	if (steep) {
+		error = x1; x1 = y1; y1 = error;
+		error = x2; x2 = y2; y2 = error;
+	}
+	if (x2 < x1) {
+		error = x1; x1 = x2; x2 = error;
+		error = y1; y1 = y2; y2 = error;
+	}
+	deltaX = x2 - x1;
+	deltaY = abs(y2 - y1);
+	error = -deltaX / 2;
+	if (y2 < y1) {
+		yStep = -1;
+	}
+	for (; x1 <= x2; x1++) {
+		if (steep) {
+			GLIB_drawPixel(pContext, y1, x1);
+		} else {
+			GLIB_drawPixel(pContext, x1, y1);
+		}
+		error += deltaY;
+		if (error > 0) {
+			y1 += yStep;
+			error -= deltaX;
+		}
+	}
+}
+
+/**
+ * Concentric filled circles in alternating colours, so every layer shows in the result
+ */
+static void sceneCircles(GLIB_Context_t *pContext, int reference)
+{
+	int32_t radius;
+	int i = 0;
+
+	for (radius = 63; radius > 0; radius -= 8, i++) {
+		pContext->foregroundColor = (i & 1) ? White : Black;
+		if (reference) {
+			refCircleFilled(pContext, 64, 64, radius);
+		} else {
+			GLIB_drawCircleFilled(pContext, 64, 64, radius);
+		}
+	}
+	pContext->foregroundColor = Black;
+}
+
+static void starPoints(int32_t *points, int32_t outer, int32_t inner)
+{
+	/* cos and sin of k * 30 degrees, scaled by 1024 */
+	static const int32_t cosTab[STAR_POINTS] = { 1024, 887, 512, 0, -512, -887, -1024, -887, -512, 0, 512, 887 };
+	int k;
+
+	for (k = 0; k < STAR_POINTS; k++) {
+		int32_t r = (k & 1) ? inner : outer;
+
+		points[2 * k] = 64 + r * cosTab[k] / 1024;
+		points[2 * k + 1] = 64 + r * cosTab[(k + 9) % STAR_POINTS] / 1024;
+	}
+}
+
+static void scenePolygon(GLIB_Context_t *pContext, int reference)
+{
+	int32_t points[2 * STAR_POINTS];
+
+	starPoints(points, 63, 24);
+	if (reference) {
+		refPolygonFilled(pContext, STAR_POINTS, points);
+	} else {
+		GLIB_drawPolygonFilled(pContext, STAR_POINTS, points);
+	}
+}
+
+/**
+ * A circle and a star larger than the clipping region
+ */
+static void sceneClipped(GLIB_Context_t *pContext, int reference)
+{
+	GLIB_Rectangle_t clip = { 16, 24, 111, 103 };
+	int32_t points[2 * STAR_POINTS];
+
+	GLIB_setClippingRegion(pContext, &clip);
+	GLIB_applyClippingRegion(pContext);
+	starPoints(points, 90, 40);
+	if (reference) {
+		refCircleFilled(pContext, 40, 64, 50);
+		pContext->foregroundColor = White;
+		refPolygonFilled(pContext, STAR_POINTS, points);
+	} else {
+		GLIB_drawCircleFilled(pContext, 40, 64, 50);
+		pContext->foregroundColor = White;
+		GLIB_drawPolygonFilled(pContext, STAR_POINTS, points);
+	}
+	pContext->foregroundColor = Black;
+	GLIB_resetClippingRegion(pContext);
+	GLIB_applyClippingRegion(pContext);
+}
+
+/**
+ * A fan of lines from the centre to every fourth border pixel, none of them horizontal or vertical
+ */
+static void sceneLines(GLIB_Context_t *pContext, int reference)
+{
+	int32_t i;
+
+	for (i = 2; i < 128; i += 4) {
+		const int32_t ends[4][2] = { { i, 0 }, { i, 127 }, { 0, i }, { 127, i } };
+		int k;
+
+		for (k = 0; k < 4; k++) {
+			if (reference) {
+				refLine(pContext, 64, 64, ends[k][0], ends[k][1]);
+			} else {
+				GLIB_drawLine(pContext, 64, 64, ends[k][0], ends[k][1]);
+			}
+		}
+	}
+}
+
+static double nowUs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/**
+ * Draws the scene into a cleared frame buffer frames times and returns the drawing time per frame
+ * in microseconds.  The panel is updated once at the end and left in panel.
+ */
+static double runScene(drawScene_t scene, int reference, int frames, uint8_t *panel)
+{
+	double total = 0;
+	int i;
+
+	for (i = 0; i < frames; i++) {
+		double start;
+
+		GLIB_clear(&context);
+		start = nowUs();
+		scene(&context, reference);
+		total += nowUs() - start;
+	}
+	DMD_updateDisplay();
+	memcpy(panel, DISPLAY_HostPanel(), PANEL_SIZE);
+	return total / frames;
+}
+
+static void bench(const char *name, drawScene_t scene, int frames)
+{
+	static uint8_t oldPanel[PANEL_SIZE];
+	static uint8_t newPanel[PANEL_SIZE];
+	double oldUs, newUs;
+	int same;
+
+	oldUs = runScene(scene, 1, frames, oldPanel);
+	newUs = runScene(scene, 0, frames, newPanel);
+	same = memcmp(oldPanel, newPanel, PANEL_SIZE) == 0;
+	printf("%-16s old %8.2f us/frame  new %8.2f us/frame  %5.1fx  %s\n",
+	       name, oldUs, newUs, oldUs / newUs, same ? "same pixels" : "PIXELS DIFFER");
+	if (!same) {
+		failures++;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	int frames = (argc > 1) ? atoi(argv[1]) : 2000;
+
+	if (frames <= 0
+	    || DISPLAY_Init() != DISPLAY_EMSTATUS_OK
+	    || DMD_init(0) != DMD_OK
+	    || GLIB_contextInit(&context) != GLIB_OK) {
+		fprintf(stderr, "usage: glib_bench [frames]\n");
+		return 2;
+	}
+	context.backgroundColor = White;
+	context.foregroundColor = Black;
+
+	bench("filled circles", sceneCircles, frames);
+	bench("filled polygon", scenePolygon, frames);
+	bench("clipped fills", sceneClipped, frames);
+	bench("line fan", sceneLines, frames);
+	return failures ? 1 : 0;
+}
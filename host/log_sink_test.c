@@ -0,0 +1,242 @@
+/*
+ * log_sink_test.c
+ *
+ *  Test of the log sink rate limits on a simulated millisecond clock.  The log source is included
+ *  here so the test can supply the clock through LOG_TIMESTAMP_TICKS(), the serial port is a file.
+ *
+ *  Covers the folding of repeated lines, the "lines suppressed" records of a call site over its
+ *  rate limit, the partial and full refill of its bucket and the repeats reported by logDrain().
+ *  The test writes the lines it expects to <program>.expect and the log to stdout in text mode,
+ *  or the records to <program>.bin in binary mode for src/log_decode.py to turn into text.  The
+ *  host Makefile compares the two.
+ *
+ *  Usage: log_sink_test
+ */
+
+#include <stdint.h>
+#include <stdarg.h>
+
+static uint64_t hostMs = 1000;		/* simulated clock */
+#define LOG_TIMESTAMP_TICKS()		hostMs
+#define LOG_TIMESTAMP_TICK_HZ()		1000u
+
+#include "log.c"
+
+#if !INCLUDE_LOGGING || !LOG_RATE_LIMIT
+#error "build with INCLUDE_LOGGING and the rate limits on"
+#endif
+#if LOG_RATE_BURST != 8 || LOG_RATE_PER_SEC != 4 || LOG_REPEAT_SECONDS != 5
+#error "the expected lines are for the default rate limits"
+#endif
+
+#define RATE_PERIOD_MS	(1000 / LOG_RATE_PER_SEC)
+
+/* Where a line was logged from, as the sink prints it: the function in text mode, file:line once decoded */
+#if LOG_BINARY
+#define PROGRAM		"log_sink_test_binary"
+#define SITE_SET(where)	snprintf(where, sizeof(where), "%s:%d", siteFile(__FILE__), __LINE__)
+#else
+#define PROGRAM		"log_sink_test"
+#define SITE_SET(where)	snprintf(where, sizeof(where), "%s", __func__)
+#endif
+
+bool hostIrqMasked;
+
+static FILE *expect;
+static FILE *wire;
+static bool crlf;
+static char floodSite[32];
+static char stepSite[32];
+static char warnSite[32];
+static char friendSite[32];
+
+void hostIrqPoll(void)
+{
+}
+
+/**
+ * The serial port, bytes before the wire is opened are dropped
+ */
+int RETARGET_WriteChar(char c)
+{
+	if (wire != NULL) {
+		if (crlf && c == '\n') {
+			fputc('\r', wire);
+		}
+		fputc(c, wire);
+	}
+	return c;
+}
+
+void RETARGET_SerialInit(void)
+{
+}
+
+void RETARGET_SerialCrLf(int on)
+{
+	crlf = on;
+}
+
+void RETARGET_SerialFlush(void)
+{
+	if (wire != NULL) {
+		fflush(wire);
+	}
+}
+
+static const char *siteFile(const char *path)
+{
+	const char *slash = strrchr(path, '/');
+
+	return slash ? slash + 1 : path;
+}
+
+/**
+ * Add a line to the expected output, stamped with the simulated clock
+ */
+static void expectLine(const char *level, const char *site, const char *format, ...)
+{
+	va_list ap;
+
+	fprintf(expect, "%5"PRIu32":%s:%s: ", (uint32_t)hostMs, level, site);
+	va_start(ap, format);
+	vfprintf(expect, format, ap);
+	va_end(ap);
+	fputc('\n', expect);
+}
+
+/**
+ * The same line n times, one millisecond apart
+ */
+static void flood(int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		LOG_INFO("connection params: interval %d, timeout %d", 24, 500); SITE_SET(floodSite);
+		hostMs++;
+	}
+}
+
+/**
+ * A different line from the same call site each time
+ */
+static void step(int i)
+{
+	LOG_INFO("step %d", i); SITE_SET(stepSite);
+}
+
+static void warn(void)
+{
+	LOG_WARN("ret.code 0x%x", 0x181); SITE_SET(warnSite);
+}
+
+static void friendFind(void)
+{
+	LOG_INFO("trying to find friend..."); SITE_SET(friendSite);
+}
+
+int main(void)
+{
+	uint32_t repeated, rateLimited;
+	uint64_t start;
+	int i;
+
+	expect = fopen(PROGRAM ".expect", "w");
+	if (expect == NULL) {
+		perror(PROGRAM ".expect");
+		return 2;
+	}
+	logInit();
+#if LOG_BINARY
+	/* the logInit record is drained before the wire opens, its log.c line is not the test's to know */
+	logDrain();
+	wire = fopen(PROGRAM ".bin", "wb");
+	if (wire == NULL) {
+		perror(PROGRAM ".bin");
+		return 2;
+	}
+#else
+	expectLine("Info ", "logInit", "Initialized Logging");
+#endif
+
+	/* identical lines are sent once and counted, the count comes before the next different line */
+	start = hostMs;
+	flood(100);
+	warn();
+	hostMs = start;
+	expectLine("Info ", floodSite, "connection params: interval 24, timeout 500");
+	hostMs += 100;
+	expectLine("Info ", floodSite, "last message repeated 99 times");
+	expectLine("Warn ", warnSite, "ret.code 0x%x", 0x181);
+	logDrain();
+
+	/* the repeats did not use up the tokens of the flood site */
+	hostMs += 300;
+	flood(1);
+	hostMs--;
+	expectLine("Info ", floodSite, "connection params: interval 24, timeout 500");
+	hostMs++;
+
+	/* a call site with different lines sends its burst, then drops the rest */
+	start = hostMs;
+	for (i = 0; i < 20; i++) {
+		step(i);
+		if (i < LOG_RATE_BURST) {
+			expectLine("Info ", stepSite, "step %d", i);
+		}
+		hostMs++;
+	}
+
+	/* one refill period later it has one token, and reports the lines it dropped with the next line */
+	hostMs = start + RATE_PERIOD_MS;
+	for (i = 20; i < 23; i++) {
+		step(i);
+		if (i == 20) {
+			expectLine("Info ", stepSite, "12 lines suppressed");
+			expectLine("Info ", stepSite, "step %d", i);
+		}
+		hostMs++;
+	}
+
+	/* a long pause refills the bucket up to the burst and no further */
+	hostMs += 10 * RATE_PERIOD_MS * LOG_RATE_BURST;
+	for (i = 30; i < 40; i++) {
+		step(i);
+		if (i == 30) {
+			expectLine("Info ", stepSite, "2 lines suppressed");
+		}
+		if (i < 30 + LOG_RATE_BURST) {
+			expectLine("Info ", stepSite, "step %d", i);
+		}
+		hostMs++;
+	}
+
+	/* repeats are reported by logDrain once they are LOG_REPEAT_SECONDS old */
+	for (i = 0; i < 3; i++) {
+		friendFind();
+		if (i == 0) {
+			expectLine("Info ", friendSite, "trying to find friend...");
+		}
+		hostMs += 2000;
+		logDrain();
+	}
+	/* the first repeat was 4 s ago */
+	hostMs += 1000;
+	logDrain();
+	expectLine("Info ", friendSite, "last message repeated 2 times");
+	logFlush();
+
+	logSinkStats(&repeated, &rateLimited);
+	fprintf(stderr, "%s: repeated %"PRIu32" rate limited %"PRIu32"\n", PROGRAM, repeated, rateLimited);
+	fclose(expect);
+	if (wire != NULL) {
+		fclose(wire);
+	}
+	fflush(stdout);
+	if (repeated != 99 + 2 || rateLimited != 12 + 2 + 2) {
+		fprintf(stderr, "FAIL: sink counts\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,28 @@
+/*
+ * em_device.h
+ *
+ *  Host wrapper around the device header for the switch simulation.  The GPIO and NVIC register
+ *  blocks are moved into host memory, see host/board_host.c, and the bit-band and bit set/clear
+ *  aliases are hidden so the emlib inline functions fall back to plain read-modify-write.  The
+ *  CMSIS inline functions of core_cm4.h were compiled before this point and keep the real
+ *  addresses, they are not called.
+ */
+
+#ifndef HOST_SIM_EM_DEVICE_H_
+#define HOST_SIM_EM_DEVICE_H_
+
+#include_next "em_device.h"
+
+#undef BITBAND_PER_BASE
+#undef BITBAND_RAM_BASE
+#undef PER_BITSET_MEM_BASE
+#undef PER_BITCLR_MEM_BASE
+
+extern GPIO_TypeDef hostGpio;
+extern NVIC_Type hostNvic;
+#undef GPIO
+#define GPIO	(&hostGpio)
+#undef NVIC
+#define NVIC	(&hostNvic)
+
+#endif /* HOST_SIM_EM_DEVICE_H_ */
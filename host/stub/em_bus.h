@@ -0,0 +1,19 @@
+/*
+ * em_bus.h
+ *
+ *  Host stand-in for the emlib bit set alias.  Setting an interrupt enable runs a pending
+ *  interrupt right away, as the NVIC would.
+ */
+
+#ifndef HOST_STUB_EM_BUS_H_
+#define HOST_STUB_EM_BUS_H_
+#include <stdint.h>
+#include "em_core.h"
+
+static inline void BUS_RegMaskedSet(volatile uint32_t *addr, uint32_t mask)
+{
+	*addr |= mask;
+	hostIrqPoll();
+}
+
+#endif /* HOST_STUB_EM_BUS_H_ */
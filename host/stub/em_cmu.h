@@ -0,0 +1,15 @@
+/*
+ * em_cmu.h
+ *
+ *  Host stand-in for the emlib clock functions, clocks are always on.
+ */
+
+#ifndef HOST_STUB_EM_CMU_H_
+#define HOST_STUB_EM_CMU_H_
+#include <stdbool.h>
+
+typedef enum { cmuClock_GPIO, cmuClock_USART0 } CMU_Clock_TypeDef;
+
+static inline void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable) { (void)clock; (void)enable; }
+
+#endif /* HOST_STUB_EM_CMU_H_ */
@@ -0,0 +1,21 @@
+/*
+ * em_core.h
+ *
+ *  Host stand-in for the emlib CORE critical sections.  Interrupts are masked with a flag.  The
+ *  host program is called at the end of every critical section, to let time pass and to run the
+ *  interrupts that are pending once they are unmasked.
+ */
+
+#ifndef HOST_STUB_EM_CORE_H_
+#define HOST_STUB_EM_CORE_H_
+#include <stdbool.h>
+
+extern bool hostIrqMasked;
+void hostIrqPoll(void);
+
+#define CORE_DECLARE_IRQ_STATE		bool irqState
+#define CORE_ENTER_ATOMIC()		do { irqState = hostIrqMasked; hostIrqMasked = true; } while (0)
+#define CORE_EXIT_ATOMIC()		do { hostIrqMasked = irqState; hostIrqPoll(); } while (0)
+#define CORE_ATOMIC_SECTION(yourcode)	{ CORE_DECLARE_IRQ_STATE; CORE_ENTER_ATOMIC(); { yourcode } CORE_EXIT_ATOMIC(); }
+
+#endif /* HOST_STUB_EM_CORE_H_ */
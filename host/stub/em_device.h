@@ -0,0 +1,40 @@
+/*
+ * em_device.h
+ *
+ *  Host stand-in for the device header, just the USART registers and bits the retarget serial
+ *  driver uses.  The host program provides the USART0 instance and the NVIC functions.
+ */
+
+#ifndef HOST_STUB_EM_DEVICE_H_
+#define HOST_STUB_EM_DEVICE_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+	volatile uint32_t STATUS;
+	volatile uint32_t IEN;
+	volatile uint32_t ROUTEPEN;
+	volatile uint32_t ROUTELOC0;
+} USART_TypeDef;
+
+extern USART_TypeDef hostUsart0;
+#define USART0				(&hostUsart0)
+
+#define USART_STATUS_TXC		(1UL << 5)
+#define USART_STATUS_TXBL		(1UL << 6)
+#define USART_STATUS_RXDATAV		(1UL << 7)
+#define USART_STATUS_TXIDLE		(1UL << 13)
+#define USART_IF_TXBL			(1UL << 1)
+#define USART_IF_RXDATAV		(1UL << 2)
+#define USART_ROUTEPEN_RXPEN		(1UL << 0)
+#define USART_ROUTEPEN_TXPEN		(1UL << 1)
+#define _USART_ROUTELOC0_RXLOC_MASK	0x3FUL
+#define _USART_ROUTELOC0_RXLOC_SHIFT	0
+#define _USART_ROUTELOC0_TXLOC_MASK	0x3F00UL
+#define _USART_ROUTELOC0_TXLOC_SHIFT	8
+
+typedef enum { USART0_IRQn, USART0_RX_IRQn, USART0_TX_IRQn } IRQn_Type;
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+void NVIC_EnableIRQ(IRQn_Type irq);
+
+#endif /* HOST_STUB_EM_DEVICE_H_ */
@@ -0,0 +1,18 @@
+/*
+ * em_gpio.h
+ *
+ *  Host stand-in for the emlib GPIO functions, pin modes are ignored.
+ */
+
+#ifndef HOST_STUB_EM_GPIO_H_
+#define HOST_STUB_EM_GPIO_H_
+
+typedef enum { gpioPortA } GPIO_Port_TypeDef;
+typedef enum { gpioModeInputPull, gpioModePushPull } GPIO_Mode_TypeDef;
+
+static inline void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out)
+{
+	(void)port; (void)pin; (void)mode; (void)out;
+}
+
+#endif /* HOST_STUB_EM_GPIO_H_ */
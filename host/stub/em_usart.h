@@ -0,0 +1,27 @@
+/*
+ * em_usart.h
+ *
+ *  Host stand-in for the emlib USART functions.  Interrupt enables are kept in IEN, data goes
+ *  through USART_Tx and USART_Rx, which the host program provides.
+ */
+
+#ifndef HOST_STUB_EM_USART_H_
+#define HOST_STUB_EM_USART_H_
+#include "em_device.h"
+
+typedef enum { usartDisable, usartEnable } USART_Enable_TypeDef;
+typedef struct {
+	USART_Enable_TypeDef enable;
+} USART_InitAsync_TypeDef;
+#define USART_INITASYNC_DEFAULT		{ usartEnable }
+
+void USART_Tx(USART_TypeDef *usart, uint8_t data);
+uint8_t USART_Rx(USART_TypeDef *usart);
+
+static inline void USART_InitAsync(USART_TypeDef *usart, const USART_InitAsync_TypeDef *init) { (void)usart; (void)init; }
+static inline void USART_Enable(USART_TypeDef *usart, USART_Enable_TypeDef enable) { (void)usart; (void)enable; }
+static inline void USART_IntClear(USART_TypeDef *usart, uint32_t flags) { (void)usart; (void)flags; }
+static inline void USART_IntEnable(USART_TypeDef *usart, uint32_t flags) { usart->IEN |= flags; }
+static inline void USART_IntDisable(USART_TypeDef *usart, uint32_t flags) { usart->IEN &= ~flags; }
+
+#endif /* HOST_STUB_EM_USART_H_ */
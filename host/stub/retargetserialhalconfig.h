@@ -0,0 +1,34 @@
+/*
+ * retargetserialhalconfig.h
+ *
+ *  Host retarget serial configuration: USART0 with separate RX and TX interrupts, or one shared
+ *  interrupt when HOST_SHARED_IRQ is defined.
+ */
+
+#ifndef HOST_STUB_RETARGETSERIALHALCONFIG_H_
+#define HOST_STUB_RETARGETSERIALHALCONFIG_H_
+
+#define RETARGET_USART		1
+#define RETARGET_UART		USART0
+#define RETARGET_UART_INDEX	0
+#define RETARGET_CLK		cmuClock_USART0
+#if defined(HOST_SHARED_IRQ)
+#define RETARGET_IRQ_NAME	USART0_IRQHandler
+#define RETARGET_IRQn		USART0_IRQn
+#else
+#define RETARGET_IRQ_NAME	USART0_RX_IRQHandler
+#define RETARGET_IRQn		USART0_RX_IRQn
+#define RETARGET_TX_IRQ_NAME	USART0_TX_IRQHandler
+#define RETARGET_TX_IRQn	USART0_TX_IRQn
+#endif
+#define RETARGET_TX		USART_Tx
+#define RETARGET_RX		USART_Rx
+#define RETARGET_TXPORT		gpioPortA
+#define RETARGET_TXPIN		0
+#define RETARGET_RXPORT		gpioPortA
+#define RETARGET_RXPIN		1
+#define RETARGET_TX_LOCATION	0
+#define RETARGET_RX_LOCATION	0
+#define RETARGET_PERIPHERAL_ENABLE()
+
+#endif /* HOST_STUB_RETARGETSERIALHALCONFIG_H_ */
@@ -0,0 +1,15 @@
+/*
+ * sleep.h
+ *
+ *  Host stand-in for the sleep driver, the host program counts the EM2 blocks.
+ */
+
+#ifndef HOST_STUB_SLEEP_H_
+#define HOST_STUB_SLEEP_H_
+
+typedef enum { sleepEM2 = 2 } SLEEP_EnergyMode_t;
+
+void SLEEP_SleepBlockBegin(SLEEP_EnergyMode_t eMode);
+void SLEEP_SleepBlockEnd(SLEEP_EnergyMode_t eMode);
+
+#endif /* HOST_STUB_SLEEP_H_ */
@@ -0,0 +1,460 @@
+/*
+ * uart_ring_test.c
+ *
+ *  Model test of the retarget serial RX and TX rings.  The driver source is included here, built
+ *  with the stand-in headers in host/stub, so the test can start the free running ring indices
+ *  just below the 32 bit wrap.
+ *
+ *  The USART model has a TX FIFO of USART_TX_FIFO bytes which the line empties when the test lets
+ *  time pass, and an RX FIFO of USART_RX_FIFO bytes which overruns when the driver does not empty
+ *  it.  Interrupts run as soon as they are pending and not masked.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "retargetserial.c"
+
+#if (TXBUFSIZE == 0) || (TXBUFSIZE > 64) || (RXBUFSIZE > 64)
+#error "build with small TXBUFSIZE and RXBUFSIZE so the tests fill the rings"
+#endif
+
+#define USART_TX_FIFO	2
+#define USART_RX_FIFO	3
+#define INDEX_NEAR_WRAP	0xFFFFFFF0UL
+#define STREAM_MAX	5000
+
+USART_TypeDef hostUsart0;
+bool hostIrqMasked;
+
+static uint8_t txFifo[USART_TX_FIFO];
+static unsigned int txFifoLength;
+static uint8_t wire[STREAM_MAX];
+static unsigned int wireLength;
+static unsigned int linePollsPerSend;	/* the line empties the TX FIFO every this many polls, 0 when stopped */
+static unsigned int linePolls;
+static bool lineInstant;		/* bytes written to the USART go straight out */
+
+static uint8_t rxFifo[USART_RX_FIFO];
+static unsigned int rxFifoLength;
+static unsigned int rxOverruns;
+
+static bool inIrq;
+static int em2Blocks;
+static int em2BlocksMax;
+static unsigned int notifies;
+static int failures;
+
+static void usartStatusUpdate(void)
+{
+	hostUsart0.STATUS = (txFifoLength < USART_TX_FIFO ? USART_STATUS_TXBL : 0)
+			| (txFifoLength == 0 ? USART_STATUS_TXC | USART_STATUS_TXIDLE : 0)
+			| (rxFifoLength > 0 ? USART_STATUS_RXDATAV : 0);
+}
+
+void USART_Tx(USART_TypeDef *usart, uint8_t data)
+{
+	(void)usart;
+	if (txFifoLength == USART_TX_FIFO) {
+		printf("FAIL: USART_Tx with a full TX FIFO\n");
+		failures++;
+		return;
+	}
+	if (lineInstant) {
+		wire[wireLength++] = data;
+	} else {
+		txFifo[txFifoLength++] = data;
+	}
+	usartStatusUpdate();
+}
+
+uint8_t USART_Rx(USART_TypeDef *usart)
+{
+	uint8_t data = rxFifo[0];
+
+	(void)usart;
+	rxFifoLength--;
+	memmove(rxFifo, rxFifo + 1, rxFifoLength);
+	usartStatusUpdate();
+	return data;
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irq)
+{
+	(void)irq;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+	(void)irq;
+}
+
+void SLEEP_SleepBlockBegin(SLEEP_EnergyMode_t eMode)
+{
+	(void)eMode;
+	if (++em2Blocks > em2BlocksMax) {
+		em2BlocksMax = em2Blocks;
+	}
+}
+
+void SLEEP_SleepBlockEnd(SLEEP_EnergyMode_t eMode)
+{
+	(void)eMode;
+	em2Blocks--;
+}
+
+/**
+ * Runs the USART interrupts while one is pending and interrupts are not masked
+ */
+static void irqRun(void)
+{
+	if (inIrq || hostIrqMasked) {
+		return;
+	}
+	inIrq = true;
+	hostIrqMasked = true;
+	for (;;) {
+		bool tx = (hostUsart0.IEN & USART_IF_TXBL) && (hostUsart0.STATUS & USART_STATUS_TXBL);
+		bool rx = (hostUsart0.IEN & USART_IF_RXDATAV) && (hostUsart0.STATUS & USART_STATUS_RXDATAV);
+
+		if (!tx && !rx) {
+			break;
+		}
+#if defined(RETARGET_TX_IRQ_NAME)
+		if (tx) {
+			RETARGET_TX_IRQ_NAME();
+		}
+		if (rx) {
+			RETARGET_IRQ_NAME();
+		}
+#else
+		RETARGET_IRQ_NAME();
+#endif
+	}
+	hostIrqMasked = false;
+	inIrq = false;
+}
+
+/**
+ * The line sends up to count bytes from the TX FIFO
+ */
+static void lineSend(unsigned int count)
+{
+	while (count-- > 0 && txFifoLength > 0) {
+		wire[wireLength++] = txFifo[0];
+		txFifoLength--;
+		memmove(txFifo, txFifo + 1, txFifoLength);
+	}
+	usartStatusUpdate();
+	irqRun();
+}
+
+/**
+ * Called at the end of every critical section, time passes for the line
+ */
+void hostIrqPoll(void)
+{
+	if (linePollsPerSend > 0 && ++linePolls >= linePollsPerSend) {
+		linePolls = 0;
+		lineSend(USART_TX_FIFO);
+	} else {
+		irqRun();
+	}
+}
+
+/**
+ * The line sends until the driver has nothing left
+ */
+static void lineDrain(void)
+{
+	while (txFifoLength > 0) {
+		lineSend(USART_TX_FIFO);
+	}
+}
+
+/**
+ * The sender puts one byte on the RX line
+ */
+static void lineReceive(uint8_t data)
+{
+	if (rxFifoLength == USART_RX_FIFO) {
+		rxOverruns++;
+	} else {
+		rxFifo[rxFifoLength++] = data;
+	}
+	usartStatusUpdate();
+	irqRun();
+}
+
+static void rxNotifyCount(void)
+{
+	notifies++;
+}
+
+static void check(int ok, const char *test, const char *what)
+{
+	if (!ok) {
+		printf("FAIL: %s: %s\n", test, what);
+		failures++;
+	}
+}
+
+/**
+ * Empty model and driver, with the ring indices starting at index
+ */
+static void reset(uint32_t index)
+{
+	txFifoLength = 0;
+	wireLength = 0;
+	linePollsPerSend = 0;
+	linePolls = 0;
+	lineInstant = false;
+	rxFifoLength = 0;
+	rxOverruns = 0;
+	em2Blocks = 0;
+	em2BlocksMax = 0;
+	notifies = 0;
+
+	rxReadIndex = rxWriteIndex = index;
+	rxStalled = false;
+	txReadIndex = txWriteIndex = index;
+	txActive = false;
+	txHighWatermark = 0;
+	txDropped = 0;
+	RETARGET_SerialTxDrop(0);
+	RETARGET_SerialCrLf(0);
+	RETARGET_SerialRxNotifySet(rxNotifyCount);
+	hostUsart0.IEN = USART_IF_RXDATAV;
+	usartStatusUpdate();
+}
+
+static uint8_t pattern(unsigned int i)
+{
+	return (uint8_t)(i * 7 + (i >> 8));
+}
+
+static int wireMatches(unsigned int length)
+{
+	unsigned int i;
+
+	if (wireLength != length) {
+		return 0;
+	}
+	for (i = 0; i < length; i++) {
+		if (wire[i] != pattern(i)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/**
+ * Bytes written in bursts smaller than the ring and sent between bursts, across the index wrap
+ */
+static void testTxWrap(void)
+{
+	const char *test = "tx wrap";
+	uint32_t highWatermark, dropped;
+	unsigned int i;
+
+	reset(INDEX_NEAR_WRAP);
+	for (i = 0; i < 1000; i++) {
+		RETARGET_WriteChar(pattern(i));
+		if (i % 5 == 4) {
+			lineDrain();
+		}
+	}
+	lineDrain();
+	RETARGET_SerialTxStats(&highWatermark, &dropped);
+	check(wireMatches(1000), test, "bytes sent in order");
+	check(txReadIndex == (uint32_t)(INDEX_NEAR_WRAP + 1000), test, "indices wrapped");
+	check(highWatermark <= 5 && dropped == 0, test, "high watermark and drop count");
+	check(!txActive && !(hostUsart0.IEN & USART_IF_TXBL), test, "TX interrupt off when empty");
+	check(em2Blocks == 0 && em2BlocksMax == 1, test, "EM2 blocked once while sending");
+}
+
+/**
+ * Writes faster than the line sends wait for room in the ring, with interrupts enabled or masked
+ */
+static void testTxBlocking(bool masked)
+{
+	const char *test = masked ? "tx blocking, interrupts masked" : "tx blocking";
+	uint32_t highWatermark, dropped;
+	unsigned int i;
+
+	reset(INDEX_NEAR_WRAP);
+	linePollsPerSend = 8;
+	hostIrqMasked = masked;
+	for (i = 0; i < 300; i++) {
+		RETARGET_WriteChar(pattern(i));
+	}
+	hostIrqMasked = false;
+	linePollsPerSend = 0;
+	lineDrain();
+	RETARGET_SerialTxStats(&highWatermark, &dropped);
+	check(wireMatches(300), test, "no byte lost or reordered");
+	check(highWatermark == TXBUFSIZE && dropped == 0, test, "ring filled, nothing dropped");
+	check(em2Blocks == 0, test, "EM2 block released");
+}
+
+/**
+ * With dropping on, bytes that do not fit while the line is stalled are counted and lost
+ */
+static void testTxDrop(void)
+{
+	const char *test = "tx drop";
+	uint32_t highWatermark, dropped;
+	unsigned int i;
+
+	reset(0);
+	RETARGET_SerialTxDrop(1);
+	for (i = 0; i < 40; i++) {
+		RETARGET_WriteChar(pattern(i));
+	}
+	RETARGET_SerialTxStats(&highWatermark, &dropped);
+	check(dropped == 40 - TXBUFSIZE - USART_TX_FIFO, test, "bytes past the ring and FIFO dropped");
+	check(highWatermark == TXBUFSIZE, test, "high watermark is the ring size");
+	lineDrain();
+	check(wireMatches(TXBUFSIZE + USART_TX_FIFO), test, "bytes that fitted sent in order");
+
+	/* once there is room again nothing more is dropped */
+	wireLength = 0;
+	for (i = 0; i < 10; i++) {
+		RETARGET_WriteChar(pattern(i));
+	}
+	lineDrain();
+	RETARGET_SerialTxStats(&highWatermark, &dropped);
+	check(wireMatches(10) && dropped == 40 - TXBUFSIZE - USART_TX_FIFO, test, "sending again after the drop");
+}
+
+static void testTxCrLfFlush(void)
+{
+	const char *test = "tx CRLF and flush";
+	const char *text = "ab\ncd\n";
+
+	/* written and flushed with interrupts masked, so only the flush can send */
+	reset(INDEX_NEAR_WRAP);
+	hostIrqMasked = true;
+	RETARGET_SerialCrLf(1);
+	while (*text) {
+		RETARGET_WriteChar(*text++);
+	}
+	check(wireLength == 0 && txFifoLength == 0, test, "nothing sent before the flush");
+	lineInstant = true;
+	RETARGET_SerialFlush();
+	check(wireLength == 8 && memcmp(wire, "ab\r\ncd\r\n", 8) == 0, test, "LF sent as CRLF");
+	check(txReadIndex == txWriteIndex && !txActive && em2Blocks == 0, test, "flush empties the ring");
+	hostIrqMasked = false;
+}
+
+/**
+ * Received bytes read back in order across the index wrap
+ */
+static void testRxWrap(void)
+{
+	const char *test = "rx wrap";
+	unsigned int sent = 0, received = 0, bad = 0;
+	int c;
+
+	reset(INDEX_NEAR_WRAP);
+	while (sent < 1000) {
+		unsigned int burst;
+
+		for (burst = 0; burst < USART_RX_FIFO + 4; burst++) {
+			lineReceive(pattern(sent++));
+		}
+		while ((c = RETARGET_ReadChar()) >= 0) {
+			bad += (c != pattern(received++));
+		}
+	}
+	check(received == sent && bad == 0, test, "bytes received in order");
+	check(rxOverruns == 0 && rxWriteIndex == (uint32_t)(INDEX_NEAR_WRAP + sent), test, "no overrun, indices wrapped");
+}
+
+/**
+ * A full ring stops the RX interrupt until the reader makes room, with the rest left in the FIFO
+ */
+static void testRxStall(void)
+{
+	const char *test = "rx full ring";
+	unsigned int i, received = 0, bad = 0;
+	int c;
+
+	reset(INDEX_NEAR_WRAP);
+	for (i = 0; i < RXBUFSIZE + USART_RX_FIFO; i++) {
+		lineReceive(pattern(i));
+	}
+	check(rxStalled && !(hostUsart0.IEN & USART_IF_RXDATAV), test, "RX interrupt off when full");
+	check(rxFifoLength == USART_RX_FIFO && rxOverruns == 0, test, "rest waits in the FIFO");
+	check(notifies == 1, test, "notified once when full");
+
+	while ((c = RETARGET_ReadChar()) >= 0) {
+		bad += (c != pattern(received++));
+	}
+	check(received == RXBUFSIZE + USART_RX_FIFO && bad == 0, test, "all bytes read in order");
+	check(!rxStalled && (hostUsart0.IEN & USART_IF_RXDATAV), test, "RX interrupt on again");
+}
+
+static void testRxNotify(void)
+{
+	const char *test = "rx notify";
+	int c;
+
+	reset(0);
+	lineReceive('a');
+	lineReceive('b');
+	check(notifies == 0, test, "no notify within a line");
+	lineReceive('\r');
+	check(notifies == 1, test, "notify on CR");
+	lineReceive('\n');
+	check(notifies == 2, test, "notify on LF");
+	while ((c = RETARGET_ReadChar()) >= 0) {
+	}
+}
+
+/**
+ * A reader held off for up to the ring plus FIFO size between reads loses nothing
+ */
+static void testRxBlockedReader(void)
+{
+	const char *test = "rx blocked reader";
+	unsigned int sent = 0, received = 0, bad = 0;
+	int c;
+
+	reset(INDEX_NEAR_WRAP);
+	srand(1);
+	while (sent < STREAM_MAX) {
+		unsigned int held = 1 + rand() % (RXBUFSIZE + USART_RX_FIFO);
+
+		while (held-- > 0 && sent < STREAM_MAX) {
+			lineReceive(pattern(sent++));
+		}
+		while ((c = RETARGET_ReadChar()) >= 0) {
+			bad += (c != pattern(received++));
+		}
+	}
+	check(rxOverruns == 0, test, "no FIFO overrun");
+	check(received == sent && bad == 0, test, "all bytes received in order");
+}
+
+int main(void)
+{
+	RETARGET_SerialInit();
+
+	testTxWrap();
+	testTxBlocking(false);
+	testTxBlocking(true);
+	testTxDrop();
+	testTxCrLfFlush();
+	testRxWrap();
+	testRxStall();
+	testRxNotify();
+	testRxBlockedReader();
+
+#if defined(RETARGET_TX_IRQ_NAME)
+	printf("%s: TXBUFSIZE %d, RXBUFSIZE %d, separate RX and TX interrupts\n", failures ? "FAIL" : "ok", TXBUFSIZE, RXBUFSIZE);
+#else
+	printf("%s: TXBUFSIZE %d, RXBUFSIZE %d, shared interrupt\n", failures ? "FAIL" : "ok", TXBUFSIZE, RXBUFSIZE);
+#endif
+	return failures ? 1 : 0;
+}
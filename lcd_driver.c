@@ -16,7 +16,9 @@
  ******************************************************************************/
 
 #include <stdio.h>
+#include <stdbool.h>
 #include <string.h>
+#include "native_gecko.h"
 #include "graphics.h"
 #include "lcd_driver.h"
 
@@ -34,6 +36,40 @@
 
 /// 2D array for storing the LCD content
 static char LCD_data[LCD_ROW_MAX][LCD_ROW_LEN];
+/// Bitmask of rows written since the last flush, bit 0 is row 1
+static uint16_t LCD_dirty;
+/// Row content currently shown on the display
+static char LCD_shown[LCD_ROW_MAX][LCD_ROW_LEN];
+/// Set when rows are not at fixed text lines and the next flush must redraw all
+static bool LCD_redrawAll;
+
+/***************************************************************************//**
+ * Redraw the whole screen from LCD_data.
+ ******************************************************************************/
+static void LCD_flushAll(void)
+{
+  char LCD_message[LCD_ROW_MAX * LCD_ROW_LEN + 1];
+  char *pMsg = LCD_message;
+  int i;
+
+  LCD_redrawAll = false;
+  for (i = 0; i < LCD_ROW_MAX; i++) {
+    size_t len = strlen(LCD_data[i]);
+
+    memcpy(pMsg, LCD_data[i], len);
+    pMsg += len;
+    *pMsg++ = '\n'; // add newline at end of reach row
+
+    memcpy(LCD_shown[i], LCD_data[i], len + 1);
+    // a row spanning several lines shifts all rows below it
+    if (memchr(LCD_data[i], '\n', len) != NULL) {
+      LCD_redrawAll = true;
+    }
+  }
+  *pMsg = 0;
+
+  graphWriteString(LCD_message);
+}
 
 /***************************************************************************//**
  * Call a callback function at the given frequency.
@@ -60,10 +96,12 @@ int rtcIntCallbackRegister(void (*pFunction)(void*),
 void LCD_init(void)
 {
   memset(&LCD_data, 0, sizeof(LCD_data));
+  LCD_redrawAll = true;
 
   graphInit("SILICON LABORATORIES\nBluetooth Mesh Demo\n\n");
 
   LCD_write("initializing", LCD_ROW_STATUS);
+  LCD_flush();
 }
 
 /*******************************************************************************
@@ -75,27 +113,61 @@ void LCD_init(void)
  ******************************************************************************/
 void LCD_write(char *str, uint8_t row)
 {
-  char LCD_message[LCD_ROW_MAX * LCD_ROW_LEN];
   char *pRow;
-  int i;
 
-  if (row > LCD_ROW_MAX) {
+  if (row == 0 || row > LCD_ROW_MAX) {
     return;
   }
 
   pRow  = &(LCD_data[row - 1][0]);
 
-  strcpy(pRow, str);
+  strncpy(pRow, str, LCD_ROW_LEN - 1);
+  pRow[LCD_ROW_LEN - 1] = 0;
+
+  if (LCD_dirty == 0) {
+    gecko_external_signal(LCD_EVENT_FLUSH);
+  }
+  LCD_dirty |= 1 << (row - 1);
+}
 
-  LCD_message[0] = 0;
+/*******************************************************************************
+ * Redraw the LCD if any row was written since the last flush.
+ ******************************************************************************/
+void LCD_flush(void)
+{
+  uint16_t dirty = LCD_dirty;
+  bool changed = false;
+  int i;
+
+  if (dirty == 0) {
+    return;
+  }
+  LCD_dirty = 0;
 
   for (i = 0; i < LCD_ROW_MAX; i++) {
-    pRow  = &(LCD_data[i][0]);
-    strcat(LCD_message, pRow);
-    strcat(LCD_message, "\n"); // add newline at end of reach row
+    if ((dirty & (1 << i)) && strchr(LCD_data[i], '\n') != NULL) {
+      LCD_redrawAll = true;
+    }
+  }
+  if (LCD_redrawAll) {
+    LCD_flushAll();
+    return;
   }
 
-  graphWriteString(LCD_message);
+  // only the text lines of rows whose content changed are redrawn
+  for (i = 0; i < LCD_ROW_MAX; i++) {
+    if (!(dirty & (1 << i))) {
+      continue;
+    }
+    if (strcmp(LCD_data[i], LCD_shown[i]) != 0) {
+      strcpy(LCD_shown[i], LCD_data[i]);
+      graphWriteLine(LCD_data[i], i);
+      changed = true;
+    }
+  }
+  if (changed) {
+    graphUpdate();
+  }
 }
 
 /** @} (end addtogroup lcd_driver) */
@@ -60,6 +60,10 @@
 
 #define LCD_ROW_LEN         32    /**< up to 32 characters per each row */
 
+/// External signal posted by LCD_write() to request LCD_flush(), must not
+/// collide with the EVENT_PB0_xxx signals in src/gpio.h
+#define LCD_EVENT_FLUSH     (1U << 3)
+
 /***************************************************************************//**
  * LCD initialization, called once at startup.
  ******************************************************************************/
@@ -68,12 +72,21 @@ void LCD_init(void);
 /***************************************************************************//**
  * This function is used to write one line in the LCD.
  *
+ * The row is only stored and marked dirty, the display itself is updated by
+ * the next LCD_flush(). The first write after a flush posts LCD_EVENT_FLUSH
+ * as an external signal so several writes end up in a single refresh.
+ *
  * @param[in] str  Pointer to string which is displayed in the specified row.
  * @param[in] row  Selects which line of LCD display is written,
  *                 possible values are defined as LCD_ROW_xxx.
  ******************************************************************************/
 void LCD_write(char *str, uint8_t row);
 
+/***************************************************************************//**
+ * Redraw the LCD if any row was written since the last flush.
+ ******************************************************************************/
+void LCD_flush(void);
+
 /** @} (end addtogroup lcd_driver) */
 /** @} (end addtogroup disp_interface) */
 
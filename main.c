@@ -19,6 +19,7 @@
 /* C Standard Library headers */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 /* Board headers */
 #include "init_mcu.h"
@@ -53,9 +54,12 @@
 
 /* Display Interface header */
 #include "display_interface.h"
+#include "graphics.h"
 
 /* Other headers */
 #include "src/gpio.h"
+#include "src/profile.h"
+#include "src/console.h"
 
 #if defined(HAL_CONFIG)
 #include "bsphalconfig.h"
@@ -319,6 +323,35 @@ void initiate_factory_reset(void)
   gecko_cmd_hardware_set_soft_timer(2 * 32768, TIMER_ID_FACTORY_RESET, 1);
 }
 
+/***************************************************************************//**
+ * Handle the commands received over VCOM since the last call. Each command
+ * is answered with a line starting with "ok" or "error", so that a script can
+ * send the next one without waiting for anything else.
+ ******************************************************************************/
+static void handle_console_lines(void)
+{
+  char line[CONSOLE_LINE_MAX + 1];
+  uint32_t hits, misses;
+  int len;
+
+  while ((len = consoleReadLine(line, sizeof(line))) != -1) {
+    if (len == -2) {
+      printf("error line too long\r\n");
+    } else if (strcmp(line, "profile") == 0) {
+      profileDump();
+      graphGetTextCacheStats(&hits, &misses);
+      printf("text cache: %lu hits, %lu misses\r\n",
+             (unsigned long)hits, (unsigned long)misses);
+      printf("ok\r\n");
+    } else if (strcmp(line, "factory_reset") == 0) {
+      printf("ok\r\n");
+      initiate_factory_reset();
+    } else {
+      printf("error unknown command '%s'\r\n", line);
+    }
+  }
+}
+
 /***************************************************************************//**
  * Main function.
  ******************************************************************************/
@@ -373,9 +406,15 @@ int main(void)
 
   RETARGET_SerialInit();
 
+  // Commands over VCOM are read when EVENT_CONSOLE_LINE is signaled
+  consoleInit();
+
   // Display Interface initialization
   DI_Init();
 
+  // Event loop profiling, compiled out unless INCLUDE_PROFILING is set
+  profileInit();
+
 #if defined(_SILICON_LABS_32B_SERIES_1_CONFIG_3)
   /* xG13 devices have two RTCCs, one for the stack and another for the application.
    * The clock for RTCC needs to be enabled in application code. In xG12 RTCC init
@@ -384,11 +423,16 @@ int main(void)
 #endif
 
   while (1) {
+    // Send the log records queued since the last pass in binary logging, and the count of
+    // repeated lines held back by the rate limited log sink in text logging
+    logDrain();
     struct gecko_cmd_packet *evt = gecko_wait_event();
+    uint32_t start = profileStart();
     bool pass = mesh_bgapi_listener(evt);
     if (pass) {
       handle_gecko_event(BGLIB_MSG_ID(evt->header), evt);
     }
+    profileStop(BGLIB_MSG_ID(evt->header), start);
   }
 }
 
@@ -494,6 +538,18 @@ static void handle_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt)
 	      break;
 
 	    case gecko_evt_system_external_signal_id:
+	      // display rows printed since the last refresh are drawn in one go
+	      if (evt->data.evt_system_external_signal.extsignals & DI_EVENT_FLUSH) {
+	        DI_Flush();
+	      }
+	      // PB0 pressed while PB1 is held down dumps the event loop profile
+	      if ((evt->data.evt_system_external_signal.extsignals & EVENT_PB0_FALLING)
+	          && GPIO_PinInGet(Button_port, Button1) == 0) {
+	        profileDump();
+	      }
+	      if (evt->data.evt_system_external_signal.extsignals & EVENT_CONSOLE_LINE) {
+	        handle_console_lines();
+	      }
 	    break;
 
 	    case gecko_evt_mesh_node_provisioning_started_id:
@@ -32,6 +32,21 @@
 #define DIRTY_WORD_BITS_LOG2       (5)
 #define DIRTY_WORD_BITS_LOG2_MASK  ((1 << DIRTY_WORD_BITS_LOG2) - 1)
 
+/* Count trailing zeros of a non-zero dirty word. */
+#if defined(__GNUC__)
+#define DIRTY_CTZ(word)            ((unsigned int) __builtin_ctz(word))
+#else
+#define DIRTY_CTZ(word)            dirtyCtz(word)
+#endif
+
+/* Clean rows between two dirty runs that DMD_updateDisplay sends anyway to
+   merge the runs into one update. A clean row costs a row of SPI traffic,
+   while a new run costs the SCS setup/hold times and the update command, so
+   this only pays off at high SPI clock rates. 0 disables merging. */
+#ifndef DMD_DIRTY_GAP_MERGE
+#define DMD_DIRTY_GAP_MERGE        (0)
+#endif
+
 /* Definitions for RGB_3BIT mode */
 #define RGB_3BIT_BITS_PER_PIXEL  3
 
@@ -42,6 +57,10 @@ static bool  moduleInitialized = false;
 static DISPLAY_Device_t      displayDevice;
 static DISPLAY_PixelMatrix_t pixelMatrixBuffer = NULL;
 
+/* Front framebuffer when double buffering: holds what is on the display and
+   is sent from while drawing continues in pixelMatrixBuffer. */
+static DISPLAY_PixelMatrix_t frontBuffer = NULL;
+
 /* Dimensions of the display */
 static DMD_DisplayGeometry dimensions;
 
@@ -87,6 +106,14 @@ EMSTATUS DMD_init(DMD_InitConfig *initConfig)
     return status;
   }
 
+#if defined(DISPLAY_COLOUR_MODE_IS_MONOCHROME_INVERSE)
+  /* DMD_writeData is built for this display format only. */
+  if ((DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE != displayDevice.colourMode)
+      || (DISPLAY_ADDRESSING_BY_ROWS_ONLY != displayDevice.addressMode)) {
+    return DMD_ERROR_NOT_SUPPORTED;
+  }
+#endif
+
   /* Allocate the default framebuffer. */
   status = DMD_allocateFramebuffer(&pixelMatrixBuffer);
   if (DMD_OK != status) {
@@ -175,6 +202,190 @@ EMSTATUS DMD_setClippingArea(uint16_t xStart, uint16_t yStart,
   return DMD_OK;
 }
 
+#if defined(DISPLAY_COLOUR_MODE_IS_MONOCHROME_INVERSE)
+/**************************************************************************//**
+*  @brief
+*  Read up to 8 bits from a pixel data bit stream.
+*
+*  @param data
+*  Pixel data, 8 pixels per byte starting at the least significant bit.
+*  @param bit
+*  Index of the first bit to read.
+*  @param count
+*  Number of bits to read, 1 to 8.
+*
+*  @return
+*  The bits read, in the lowest bits of the result.
+******************************************************************************/
+static inline uint8_t readDataBits(const uint8_t data[], uint32_t bit,
+                                   unsigned int count)
+{
+  unsigned int shift = bit & 0x7;
+  unsigned int bits  = data[bit >> 3] >> shift;
+
+  /* Only touch the next byte if the bits run into it. */
+  if (shift + count > 8) {
+    bits |= data[(bit >> 3) + 1] << (8 - shift);
+  }
+  return (uint8_t)(bits & ((1U << count) - 1));
+}
+
+/**************************************************************************//**
+*  @brief
+*  DMD_writeData for a MONOCHROME_INVERSE display addressed by rows only.
+*
+*  @details
+*  Data bits map 1:1 onto pixel matrix bits, so rows are written a byte at a
+*  time, masking the partial bytes at either end of the row, and with memcpy
+*  where the data is byte aligned too. Arguments are checked by the caller.
+******************************************************************************/
+static void writeDataMonochromeInverse(uint16_t x, uint16_t y,
+                                       const uint8_t data[],
+                                       uint32_t numPixels)
+{
+  unsigned int  rowPixels;
+  unsigned int  pixel;
+  unsigned int  endPixel;
+  unsigned int  count;
+  unsigned int  numBytesToCopy;
+  uint8_t       pixelMask;
+  uint32_t      pixelBit    = 0;
+  int           rows        = 0;
+  int           bytesPerRow = displayDevice.geometry.stride >> 3;
+  uint8_t      *pStartRow;
+  uint8_t      *pDst;
+
+  /* Adjust y to account for clipping. */
+  y += dimensions.yClipStart;
+
+  pStartRow = (uint8_t*) pixelMatrixBuffer + y * bytesPerRow;
+
+  while (numPixels) {
+    /* Determine how many bits to write on the current row/line. */
+    rowPixels = numPixels > (unsigned int)(dimensions.clipWidth - x)
+                ? (unsigned int)(dimensions.clipWidth - x) : numPixels;
+    numPixels -= rowPixels;
+
+    pDst     = pStartRow + rows * bytesPerRow;
+    pixel    = x + dimensions.xClipStart;
+    endPixel = pixel + rowPixels;
+
+    while (pixel < endPixel) {
+      if ((0 == (pixel & 0x7)) && (0 == (pixelBit & 0x7))
+          && (endPixel - pixel >= 8)) {
+        /* Both sides byte aligned, copy the whole bytes in one go. */
+        numBytesToCopy = (endPixel - pixel) >> 3;
+        memcpy(&pDst[pixel >> 3], &data[pixelBit >> 3], numBytesToCopy);
+        pixel    += numBytesToCopy << 3;
+        pixelBit += numBytesToCopy << 3;
+        continue;
+      }
+
+      /* Fill up the current matrix byte, keeping the bits outside the row. */
+      count = 8 - (pixel & 0x7);
+      if (count > endPixel - pixel) {
+        count = endPixel - pixel;
+      }
+      pixelMask = (uint8_t)(((1U << count) - 1) << (pixel & 0x7));
+      pDst[pixel >> 3] = (pDst[pixel >> 3] & ~pixelMask)
+                         | (readDataBits(data, pixelBit, count)
+                            << (pixel & 0x7));
+      pixel    += count;
+      pixelBit += count;
+    }
+
+    /* Mark row/line as dirty */
+    dirtyRows[(y + rows) >> DIRTY_WORD_BITS_LOG2] |=
+      1UL << ((y + rows) & DIRTY_WORD_BITS_LOG2_MASK);
+
+    /* Update variables for next row. */
+    rows++;
+    x = 0;
+  }
+
+#ifdef UPDATE_PER_WRITE_CALL
+  /* Update the display device now. */
+  displayDevice.pPixelMatrixDraw(&displayDevice,
+                                 pStartRow,
+                                 0,
+                                 displayDevice.geometry.width,
+                                 y,
+                                 rows);
+#endif
+}
+
+/**************************************************************************//**
+*  @brief
+*  DMD_readData for a MONOCHROME_INVERSE display addressed by rows only.
+*
+*  @details
+*  The reverse of writeDataMonochromeInverse: pixel matrix bits are copied
+*  1:1 into the data bit stream. Data bits outside the pixels read are kept.
+*  Arguments are checked by the caller.
+******************************************************************************/
+static void readDataMonochromeInverse(uint16_t x, uint16_t y,
+                                      uint8_t data[], uint32_t numPixels)
+{
+  unsigned int  rowPixels;
+  unsigned int  pixel;
+  unsigned int  endPixel;
+  unsigned int  count;
+  unsigned int  numBytesToCopy;
+  unsigned int  shift;
+  unsigned int  bits;
+  unsigned int  mask;
+  uint32_t      pixelBit    = 0;
+  int           rows        = 0;
+  int           bytesPerRow = displayDevice.geometry.stride >> 3;
+  const uint8_t *pSrc;
+
+  /* Adjust y to account for clipping. */
+  y += dimensions.yClipStart;
+
+  while (numPixels) {
+    rowPixels = numPixels > (unsigned int)(dimensions.clipWidth - x)
+                ? (unsigned int)(dimensions.clipWidth - x) : numPixels;
+    numPixels -= rowPixels;
+
+    pSrc     = (const uint8_t*) pixelMatrixBuffer + (y + rows) * bytesPerRow;
+    pixel    = x + dimensions.xClipStart;
+    endPixel = pixel + rowPixels;
+
+    while (pixel < endPixel) {
+      if ((0 == (pixel & 0x7)) && (0 == (pixelBit & 0x7))
+          && (endPixel - pixel >= 8)) {
+        numBytesToCopy = (endPixel - pixel) >> 3;
+        memcpy(&data[pixelBit >> 3], &pSrc[pixel >> 3], numBytesToCopy);
+        pixel    += numBytesToCopy << 3;
+        pixelBit += numBytesToCopy << 3;
+        continue;
+      }
+
+      /* Take the rest of the current matrix byte, at most to the row end. */
+      count = 8 - (pixel & 0x7);
+      if (count > endPixel - pixel) {
+        count = endPixel - pixel;
+      }
+      bits  = (pSrc[pixel >> 3] >> (pixel & 0x7)) & ((1U << count) - 1);
+      shift = pixelBit & 0x7;
+      mask  = ((1U << count) - 1) << shift;
+      bits <<= shift;
+      data[pixelBit >> 3] = (data[pixelBit >> 3] & ~mask) | (bits & 0xff);
+      /* The bits may run into the next data byte. */
+      if (shift + count > 8) {
+        data[(pixelBit >> 3) + 1] = (data[(pixelBit >> 3) + 1] & ~(mask >> 8))
+                                    | (bits >> 8);
+      }
+      pixel    += count;
+      pixelBit += count;
+    }
+
+    rows++;
+    x = 0;
+  }
+}
+#endif /* DISPLAY_COLOUR_MODE_IS_MONOCHROME_INVERSE */
+
 /**************************************************************************//**
 *  @brief
 *  Draws pixels to the display
@@ -220,6 +431,9 @@ EMSTATUS DMD_writeData(uint16_t x, uint16_t y, const uint8_t data[],
     return DMD_ERROR_TOO_MUCH_DATA;
   }
 
+#if defined(DISPLAY_COLOUR_MODE_IS_MONOCHROME_INVERSE)
+  writeDataMonochromeInverse(x, y, data, numPixels);
+#else
   /* Write data */
   switch (displayDevice.addressMode) {
     default:
@@ -407,7 +621,7 @@ EMSTATUS DMD_writeData(uint16_t x, uint16_t y, const uint8_t data[],
 
         /* Mark row/line as dirty */
         dirtyRows[(y + rows) >> DIRTY_WORD_BITS_LOG2] |=
-          1 << ((y + rows) & DIRTY_WORD_BITS_LOG2_MASK);
+          1UL << ((y + rows) & DIRTY_WORD_BITS_LOG2_MASK);
 
         /* Update variables for next row. */
         rows++;
@@ -426,6 +640,7 @@ EMSTATUS DMD_writeData(uint16_t x, uint16_t y, const uint8_t data[],
     }
     break;
   }
+#endif /* DISPLAY_COLOUR_MODE_IS_MONOCHROME_INVERSE */
 
   return DMD_OK;
 }
@@ -433,7 +648,9 @@ EMSTATUS DMD_writeData(uint16_t x, uint16_t y, const uint8_t data[],
 /**************************************************************************//**
 *  @brief
 *  Reads data from display memory
-*  DOESN'T WORK yet - TIMING ISSUE?
+*
+*  Only implemented for MONOCHROME_INVERSE displays, where the data uses the
+*  same format as DMD_writeData. Returns DMD_ERROR_NOT_SUPPORTED otherwise.
 *
 *  @param x
 *  X coordinate of the first pixel to be read, relative to the clipping area
@@ -450,12 +667,34 @@ EMSTATUS DMD_writeData(uint16_t x, uint16_t y, const uint8_t data[],
 EMSTATUS DMD_readData(uint16_t x, uint16_t y,
                       uint8_t data[], uint32_t numPixels)
 {
+#if defined(DISPLAY_COLOUR_MODE_IS_MONOCHROME_INVERSE)
+  uint32_t clipRemaining;
+
+  if (!moduleInitialized) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  if (NULL == pixelMatrixBuffer) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  /* Check that the pixels are inside the clipping area */
+  clipRemaining = (dimensions.clipHeight - y) * dimensions.clipWidth - x;
+  if (numPixels > clipRemaining) {
+    return DMD_ERROR_TOO_MUCH_DATA;
+  }
+
+  readDataMonochromeInverse(x, y, data, numPixels);
+
+  return DMD_OK;
+#else
   (void) x;          /* Suppress compiler warning: unused parameter. */
   (void) y;          /* Suppress compiler warning: unused parameter. */
   (void) data;       /* Suppress compiler warning: unused parameter. */
   (void) numPixels;  /* Suppress compiler warning: unused parameter. */
 
   return DMD_ERROR_NOT_SUPPORTED;
+#endif
 }
 
 /**************************************************************************//**
@@ -653,7 +892,7 @@ EMSTATUS DMD_writeColor(uint16_t x, uint16_t y, uint8_t red,
 
         /* Mark row/line as dirty */
         dirtyRows[(y + rows) >> DIRTY_WORD_BITS_LOG2] |=
-          1 << ((y + rows) & DIRTY_WORD_BITS_LOG2_MASK);
+          1UL << ((y + rows) & DIRTY_WORD_BITS_LOG2_MASK);
 
         /* Update variable for next row/line. */
         x = 0;
@@ -676,6 +915,406 @@ EMSTATUS DMD_writeColor(uint16_t x, uint16_t y, uint8_t red,
   return DMD_OK;
 }
 
+/**************************************************************************//**
+*  \brief
+*  Draws the pixels selected by a bit mask on one row in the same color
+*
+*  @param x
+*  X coordinate of the pixel selected by bit 0 of mask, relative to the
+*  clipping area
+*  @param y
+*  Y coordinate of the row, relative to the clipping area
+*  @param red
+*  Red component of the color
+*  @param green
+*  Green component of the color
+*  @param blue
+*  Blue component of the color
+*  @param mask
+*  Bit n selects pixel x + n, pixels with a cleared bit are left unchanged
+*
+*  @return
+*  DMD_OK on success, otherwise error code
+******************************************************************************/
+EMSTATUS DMD_writeColorMask(uint16_t x, uint16_t y, uint8_t red,
+                            uint8_t green, uint8_t blue, uint32_t mask)
+{
+  uint8_t  *pDst;
+  uint64_t  bits;
+  uint8_t   pixelData;
+  int       bytesPerRow;
+
+  if (!moduleInitialized) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  if (NULL == pixelMatrixBuffer) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  if (0 == mask) {
+    return DMD_OK;
+  }
+
+  /* All selected pixels must be inside the clipping area */
+  if (x >= dimensions.clipWidth || y >= dimensions.clipHeight
+      || (dimensions.clipWidth - x < 32
+          && 0 != (mask >> (dimensions.clipWidth - x)))) {
+    return DMD_ERROR_PIXEL_OUT_OF_BOUNDS;
+  }
+
+  if (displayDevice.addressMode != DISPLAY_ADDRESSING_BY_ROWS_ONLY
+      || (displayDevice.colourMode != DISPLAY_COLOUR_MODE_MONOCHROME
+          && displayDevice.colourMode != DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE)) {
+    /* No packed layout to work on, draw pixel by pixel. */
+    EMSTATUS status;
+
+    for (; mask; mask >>= 1, x++) {
+      if (mask & 0x1) {
+        status = DMD_writeColor(x, y, red, green, blue, 1);
+        if (DMD_OK != status) {
+          return status;
+        }
+      }
+    }
+    return DMD_OK;
+  }
+
+  pixelData = green ? 0x00 : 0xff;
+  if (displayDevice.colourMode == DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE) {
+    pixelData = ~pixelData;
+  }
+
+  /* Adjust x and y to account for clipping. */
+  x += dimensions.xClipStart;
+  y += dimensions.yClipStart;
+
+  bytesPerRow = displayDevice.geometry.stride >> 3;
+  pDst = (uint8_t*) pixelMatrixBuffer + y * bytesPerRow + (x >> 3);
+
+  /* Align the mask to the framebuffer bytes and apply it a byte at a time */
+  bits = (uint64_t) mask << (x & 0x7);
+  for (; bits; bits >>= 8, pDst++) {
+    if (pixelData) {
+      *pDst |= (uint8_t) bits;
+    } else {
+      *pDst &= ~(uint8_t) bits;
+    }
+  }
+
+  /* Mark row/line as dirty */
+  dirtyRows[y >> DIRTY_WORD_BITS_LOG2] |= 1UL << (y & DIRTY_WORD_BITS_LOG2_MASK);
+
+#ifdef UPDATE_PER_WRITE_CALL
+  /* Update the display device now. */
+  displayDevice.pPixelMatrixDraw(&displayDevice,
+                                 (uint8_t*) pixelMatrixBuffer + y * bytesPerRow,
+                                 0,
+                                 displayDevice.geometry.width,
+                                 y,
+                                 1);
+#endif
+
+  return DMD_OK;
+}
+
+/**************************************************************************//**
+*  \brief
+*  Draws a horizontal run of pixels of the same color on one row
+*
+*  @param x
+*  X coordinate of the first pixel, relative to the clipping area
+*  @param y
+*  Y coordinate of the row, relative to the clipping area
+*  @param length
+*  Number of pixels in the run, the run must not cross the end of the row
+*  @param red
+*  Red component of the color
+*  @param green
+*  Green component of the color
+*  @param blue
+*  Blue component of the color
+*
+*  @return
+*  DMD_OK on success, otherwise error code
+******************************************************************************/
+EMSTATUS DMD_writeColorSpan(uint16_t x, uint16_t y, uint16_t length,
+                            uint8_t red, uint8_t green, uint8_t blue)
+{
+  uint8_t *pRow;
+  uint8_t  pixelData;
+  uint8_t  firstMask;
+  uint8_t  lastMask;
+  int      firstByte;
+  int      lastByte;
+  int      bytesPerRow;
+
+  if (!moduleInitialized) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  if (NULL == pixelMatrixBuffer) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  if (0 == length) {
+    return DMD_OK;
+  }
+
+  if (x + length > dimensions.clipWidth || y >= dimensions.clipHeight) {
+    return DMD_ERROR_PIXEL_OUT_OF_BOUNDS;
+  }
+
+  if (displayDevice.addressMode != DISPLAY_ADDRESSING_BY_ROWS_ONLY
+      || (displayDevice.colourMode != DISPLAY_COLOUR_MODE_MONOCHROME
+          && displayDevice.colourMode != DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE)) {
+    /* The run stays on one row, the generic fill handles it. */
+    return DMD_writeColor(x, y, red, green, blue, length);
+  }
+
+  pixelData = green ? 0x00 : 0xff;
+  if (displayDevice.colourMode == DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE) {
+    pixelData = ~pixelData;
+  }
+
+  /* Adjust x and y to account for clipping. */
+  x += dimensions.xClipStart;
+  y += dimensions.yClipStart;
+
+  bytesPerRow = displayDevice.geometry.stride >> 3;
+  pRow = (uint8_t*) pixelMatrixBuffer + y * bytesPerRow;
+
+  /* Partial bytes at both ends are masked, whole bytes in between are set
+     in one go. */
+  firstByte = x >> 3;
+  lastByte  = (x + length - 1) >> 3;
+  firstMask = 0xff << (x & 0x7);
+  lastMask  = 0xff >> (7 - ((x + length - 1) & 0x7));
+
+  if (firstByte == lastByte) {
+    firstMask &= lastMask;
+  }
+  pRow[firstByte] = (pRow[firstByte] & ~firstMask) | (pixelData & firstMask);
+  if (firstByte != lastByte) {
+    memset(&pRow[firstByte + 1], pixelData, lastByte - firstByte - 1);
+    pRow[lastByte] = (pRow[lastByte] & ~lastMask) | (pixelData & lastMask);
+  }
+
+  /* Mark row/line as dirty */
+  dirtyRows[y >> DIRTY_WORD_BITS_LOG2] |= 1UL << (y & DIRTY_WORD_BITS_LOG2_MASK);
+
+#ifdef UPDATE_PER_WRITE_CALL
+  /* Update the display device now. */
+  displayDevice.pPixelMatrixDraw(&displayDevice,
+                                 pRow,
+                                 0,
+                                 displayDevice.geometry.width,
+                                 y,
+                                 1);
+#endif
+
+  return DMD_OK;
+}
+
+/**************************************************************************//**
+*  \brief
+*  Draws a straight line of the same color between two points
+*
+*  @details
+*  The points are stepped with Bresenham's algorithm along the axis with the
+*  most motion, starting from the end with the lowest coordinate on that axis.
+*  On monochrome displays the line is drawn by moving a byte pointer and bit
+*  mask through the pixel matrix, without any per pixel checks.
+*
+*  @param x1
+*  X coordinate of the first end point, relative to the clipping area
+*  @param y1
+*  Y coordinate of the first end point, relative to the clipping area
+*  @param x2
+*  X coordinate of the second end point, relative to the clipping area
+*  @param y2
+*  Y coordinate of the second end point, relative to the clipping area
+*  @param red
+*  Red component of the color
+*  @param green
+*  Green component of the color
+*  @param blue
+*  Blue component of the color
+*
+*  @return
+*  DMD_OK on success, otherwise error code
+******************************************************************************/
+EMSTATUS DMD_writeColorLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
+                            uint8_t red, uint8_t green, uint8_t blue)
+{
+  EMSTATUS status;
+  int32_t  major1, minor1, major2, minor2;
+  int32_t  deltaMajor, deltaMinor;
+  int32_t  minorStep = 1;
+  int32_t  error;
+  int32_t  swap;
+  int32_t  row, rowEnd;
+  bool     steep;
+  uint8_t *pDst;
+  uint8_t  pixelMask;
+  uint8_t  pixelData;
+  int      bytesPerRow;
+
+  if (!moduleInitialized) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  if (NULL == pixelMatrixBuffer) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  if (x1 >= dimensions.clipWidth || x2 >= dimensions.clipWidth
+      || y1 >= dimensions.clipHeight || y2 >= dimensions.clipHeight) {
+    return DMD_ERROR_PIXEL_OUT_OF_BOUNDS;
+  }
+
+  /* Step along the axis with the most motion, lowest coordinate first */
+  steep = ((y2 > y1) ? (y2 - y1) : (y1 - y2)) > ((x2 > x1) ? (x2 - x1) : (x1 - x2));
+  if (steep) {
+    major1 = y1;
+    minor1 = x1;
+    major2 = y2;
+    minor2 = x2;
+  } else {
+    major1 = x1;
+    minor1 = y1;
+    major2 = x2;
+    minor2 = y2;
+  }
+  if (major2 < major1) {
+    swap   = major1;
+    major1 = major2;
+    major2 = swap;
+
+    swap   = minor1;
+    minor1 = minor2;
+    minor2 = swap;
+  }
+
+  deltaMajor = major2 - major1;
+  deltaMinor = (minor2 > minor1) ? (minor2 - minor1) : (minor1 - minor2);
+  error = -deltaMajor / 2;
+  if (minor2 < minor1) {
+    minorStep = -1;
+  }
+
+  if (displayDevice.addressMode != DISPLAY_ADDRESSING_BY_ROWS_ONLY
+      || (displayDevice.colourMode != DISPLAY_COLOUR_MODE_MONOCHROME
+          && displayDevice.colourMode != DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE)) {
+    /* No packed layout to step through, draw pixel by pixel. */
+    for (; major1 <= major2; major1++) {
+      status = steep ? DMD_writeColor(minor1, major1, red, green, blue, 1)
+               : DMD_writeColor(major1, minor1, red, green, blue, 1);
+      if (DMD_OK != status) {
+        return status;
+      }
+      error += deltaMinor;
+      if (error > 0) {
+        minor1 += minorStep;
+        error  -= deltaMajor;
+      }
+    }
+    return DMD_OK;
+  }
+
+  pixelData = green ? 0x00 : 0xff;
+  if (displayDevice.colourMode == DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE) {
+    pixelData = ~pixelData;
+  }
+
+  bytesPerRow = displayDevice.geometry.stride >> 3;
+
+  /* Pointer and mask of the first pixel in display coordinates */
+  if (steep) {
+    row = major1 + dimensions.yClipStart;
+    rowEnd = major2 + dimensions.yClipStart;
+    pDst = (uint8_t*) pixelMatrixBuffer + row * bytesPerRow
+           + ((minor1 + dimensions.xClipStart) >> 3);
+    pixelMask = 1 << ((minor1 + dimensions.xClipStart) & 0x7);
+  } else {
+    row = minor1 + dimensions.yClipStart;
+    rowEnd = minor2 + dimensions.yClipStart;
+    pDst = (uint8_t*) pixelMatrixBuffer + row * bytesPerRow
+           + ((major1 + dimensions.xClipStart) >> 3);
+    pixelMask = 1 << ((major1 + dimensions.xClipStart) & 0x7);
+  }
+
+  for (;; ) {
+    if (pixelData) {
+      *pDst |= pixelMask;
+    } else {
+      *pDst &= ~pixelMask;
+    }
+
+    if (major1++ == major2) {
+      break;
+    }
+
+    error += deltaMinor;
+    if (steep) {
+      /* Major step is one row down, minor step one pixel sideways */
+      pDst += bytesPerRow;
+      if (error > 0) {
+        error -= deltaMajor;
+        if (minorStep > 0) {
+          if (pixelMask == 0x80) {
+            pixelMask = 0x01;
+            pDst++;
+          } else {
+            pixelMask <<= 1;
+          }
+        } else {
+          if (pixelMask == 0x01) {
+            pixelMask = 0x80;
+            pDst--;
+          } else {
+            pixelMask >>= 1;
+          }
+        }
+      }
+    } else {
+      /* Major step is one pixel right, minor step one row up or down */
+      if (pixelMask == 0x80) {
+        pixelMask = 0x01;
+        pDst++;
+      } else {
+        pixelMask <<= 1;
+      }
+      if (error > 0) {
+        error -= deltaMajor;
+        pDst  += minorStep * bytesPerRow;
+      }
+    }
+  }
+
+  /* Every row between the end points holds a pixel of the line */
+  if (rowEnd < row) {
+    swap   = row;
+    row    = rowEnd;
+    rowEnd = swap;
+  }
+  for (swap = row; swap <= rowEnd; swap++) {
+    dirtyRows[swap >> DIRTY_WORD_BITS_LOG2] |= 1UL << (swap & DIRTY_WORD_BITS_LOG2_MASK);
+  }
+
+#ifdef UPDATE_PER_WRITE_CALL
+  /* Update the display device now. */
+  displayDevice.pPixelMatrixDraw(&displayDevice,
+                                 (uint8_t*) pixelMatrixBuffer + row * bytesPerRow,
+                                 0,
+                                 displayDevice.geometry.width,
+                                 row,
+                                 rowEnd - row + 1);
+#endif
+
+  return DMD_OK;
+}
+
 /**************************************************************************//**
 *  @brief
 *  Turns off the display and puts it into sleep mode
@@ -686,6 +1325,9 @@ EMSTATUS DMD_writeColor(uint16_t x, uint16_t y, uint8_t red,
 ******************************************************************************/
 EMSTATUS DMD_sleep(void)
 {
+  if (NULL != frontBuffer) {
+    displayDevice.pPixelMatrixDrawWait(&displayDevice);
+  }
   return displayDevice.pDisplayPowerOn(&displayDevice, false);
 }
 
@@ -809,8 +1451,9 @@ EMSTATUS DMD_selectFramebuffer(void *framebuffer)
 ******************************************************************************/
 EMSTATUS DMD_copyFramebuffer(void *dst, void *src)
 {
+  /* The stride is in bits. */
   unsigned int size =
-    displayDevice.geometry.stride * displayDevice.geometry.height;
+    (displayDevice.geometry.stride >> 3) * displayDevice.geometry.height;
 
   /* Copy contents of source framebuffer to destination framebuffer. */
   memcpy(dst, src, size);
@@ -822,6 +1465,159 @@ EMSTATUS DMD_copyFramebuffer(void *dst, void *src)
   return DMD_OK;
 }
 
+/**************************************************************************//**
+*  @brief
+*  Enable double buffering.
+*
+*  @details
+*  Allocates a front framebuffer that mirrors the display. The active
+*  framebuffer stays the one drawn in (back buffer); DMD_updateDisplay copies
+*  the dirty rows to the front buffer and lets the display device send them in
+*  the background, so drawing can go on during the transfer. Requires a
+*  display device that supports background transfers. The front buffer is
+*  private to the DMD and must not be selected for drawing.
+*
+*  @return
+*  Returns DMD_OK if successful, error otherwise.
+******************************************************************************/
+EMSTATUS DMD_enableDoubleBuffering(void)
+{
+  void     *backBuffer = pixelMatrixBuffer;
+  void     *newBuffer  = NULL;
+  EMSTATUS  status;
+
+  if (!moduleInitialized) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+  if (NULL != frontBuffer) {
+    return DMD_OK;
+  }
+  if ((NULL == displayDevice.pPixelMatrixDrawRows)
+      || (NULL == displayDevice.pPixelMatrixDrawWait)) {
+    return DMD_ERROR_NOT_SUPPORTED;
+  }
+
+  /* Allocating selects the new buffer, keep drawing in the current one. */
+  status = DMD_allocateFramebuffer(&newBuffer);
+  DMD_selectFramebuffer(backBuffer);
+  if (DMD_OK != status) {
+    return status;
+  }
+
+  DMD_copyFramebuffer(newBuffer, backBuffer);
+  frontBuffer = newBuffer;
+
+  /* Send the whole front buffer on the next update. */
+  memset(dirtyRows, 0xff, sizeof(dirtyRows));
+
+  return DMD_OK;
+}
+
+#if !defined(__GNUC__)
+static unsigned int dirtyCtz(uint32_t word)
+{
+  unsigned int n = 0;
+
+  while (!(word & 0x1)) {
+    word >>= 1;
+    n++;
+  }
+  return n;
+}
+#endif
+
+/**************************************************************************//**
+*  @brief
+*  Find the next row whose dirty flag has the given state.
+*
+*  @details
+*  Scans the dirty table a word at a time, skipping whole words of 32 rows
+*  that do not match and counting trailing zeros within the first one that
+*  does.
+*
+*  @param row
+*  First row to look at.
+*
+*  @param dirty
+*  true to look for a dirty row, false for a clean one.
+*
+*  @param height
+*  Number of rows on the display.
+*
+*  @return
+*  The row found, or height if there is none.
+******************************************************************************/
+static unsigned int findDirtyRow(unsigned int row, bool dirty,
+                                 unsigned int height)
+{
+  uint32_t word;
+
+  while (row < height) {
+    word = dirtyRows[row >> DIRTY_WORD_BITS_LOG2];
+    if (!dirty) {
+      word = ~word;
+    }
+    word >>= row & DIRTY_WORD_BITS_LOG2_MASK;
+
+    if (word) {
+      row += DIRTY_CTZ(word);
+      return (row < height) ? row : height;
+    }
+
+    /* Nothing left in this word, go to the first row of the next one. */
+    row = (row | DIRTY_WORD_BITS_LOG2_MASK) + 1;
+  }
+
+  return height;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Update the display from the front framebuffer when double buffering.
+*
+*  @details
+*  Waits for the previous update to be sent, copies the dirty rows of the
+*  active framebuffer to the front framebuffer and starts sending them.
+*
+*  @return
+*  Returns DMD_OK if successful, error otherwise.
+******************************************************************************/
+static EMSTATUS updateFrontBuffer(void)
+{
+  EMSTATUS      status;
+  unsigned int  row;
+  unsigned int  height      = displayDevice.geometry.height;
+  int           bytesPerRow = displayDevice.geometry.stride >> 3;
+  int           pixelBytes  = displayDevice.geometry.width >> 3;
+  uint8_t      *pBack       = (uint8_t*) pixelMatrixBuffer;
+  uint8_t      *pFront      = (uint8_t*) frontBuffer;
+
+  status = displayDevice.pPixelMatrixDrawWait(&displayDevice);
+  if (DISPLAY_EMSTATUS_OK != status) {
+    return status;
+  }
+
+  for (row = findDirtyRow(0, true, height);
+       row < height;
+       row = findDirtyRow(row + 1, true, height)) {
+    memcpy(pFront + row * bytesPerRow, pBack + row * bytesPerRow,
+           pixelBytes);
+  }
+
+  status = displayDevice.pPixelMatrixDrawRows(&displayDevice,
+                                              frontBuffer,
+                                              dirtyRows,
+                                              height);
+  if (DISPLAY_EMSTATUS_OK != status) {
+    return status;
+  }
+
+  /* Clear dirty rows flags. */
+  memset(dirtyRows, 0x0, sizeof(dirtyRows));
+
+  return DMD_OK;
+}
+
 /**************************************************************************//**
 *  @brief
 *  Update the display device with contents of active framebuffer.
@@ -830,6 +1626,8 @@ EMSTATUS DMD_copyFramebuffer(void *dst, void *src)
 *  Only the dirty rows/lines are updated on the display device. Dirty rows/lines
 *  are those that have been written to since the last display update. When a
 *  new active framebuffer is selected, all lines/rows will be marked as dirty.
+*  With double buffering enabled the function returns once the transfer of
+*  the dirty rows has been started.
 *
 *  @return
 *  Returns DMD_OK if successful, error otherwise.
@@ -838,62 +1636,46 @@ EMSTATUS DMD_updateDisplay(void)
 {
   EMSTATUS      status;
   unsigned int  startRow;
-  unsigned int  consecutiveDirtyRows;
+  unsigned int  endRow;
+#if DMD_DIRTY_GAP_MERGE > 0
+  unsigned int  nextRow;
+#endif
   uint8_t      *pStartRow;
-  int           bytesPerRow  = displayDevice.geometry.stride >> 3;
-  uint32_t      dirtyFlags   = dirtyRows[0];
-  int           dirtyWordCnt = 1;
+  unsigned int  height      = displayDevice.geometry.height;
+  int           bytesPerRow = displayDevice.geometry.stride >> 3;
 
-  startRow             = 0;
-  consecutiveDirtyRows = 0;
-
-  while (startRow + consecutiveDirtyRows < displayDevice.geometry.height) {
-    if (dirtyFlags & 0x1) {
-      consecutiveDirtyRows++;
-    } else {
-      if (consecutiveDirtyRows) {
-        /* We have reached the end of a series of consecutive dirty rows,
-           update display now. */
-        pStartRow = (uint8_t*) pixelMatrixBuffer + startRow * bytesPerRow;
-        status = displayDevice.pPixelMatrixDraw(&displayDevice,
-                                                pStartRow,
-                                                0,
-                                                displayDevice.geometry.width,
-                                                startRow,
-                                                consecutiveDirtyRows);
-        if (DISPLAY_EMSTATUS_OK != status) {
-          return status;
-        }
+  if (NULL != frontBuffer) {
+    return updateFrontBuffer();
+  }
 
-        startRow += consecutiveDirtyRows + 1;
-        consecutiveDirtyRows = 0;
-      } else {
-        startRow++;
+  startRow = findDirtyRow(0, true, height);
+  while (startRow < height) {
+    endRow = findDirtyRow(startRow, false, height);
+
+#if DMD_DIRTY_GAP_MERGE > 0
+    /* Bridge short clean gaps, resending a few unchanged rows is cheaper
+       than another SCS setup and update command. */
+    while (endRow < height) {
+      nextRow = findDirtyRow(endRow, true, height);
+      if ((nextRow >= height) || (nextRow - endRow > DMD_DIRTY_GAP_MERGE)) {
+        break;
       }
+      endRow = findDirtyRow(nextRow, false, height);
     }
+#endif
 
-    /* Shift down dirtyFlags until
-       all dirtyFlags in the current dirty word have been checked,
-       then set to next dirty word.  */
-    if ( (startRow + consecutiveDirtyRows) & DIRTY_WORD_BITS_LOG2_MASK ) {
-      dirtyFlags >>= 1;
-    } else {
-      dirtyFlags = dirtyRows[dirtyWordCnt++];
-    }
-  }
-
-  /* Check if there dirty rows at end that have not been written yet. */
-  if (consecutiveDirtyRows) {
     pStartRow = (uint8_t*) pixelMatrixBuffer + startRow * bytesPerRow;
     status = displayDevice.pPixelMatrixDraw(&displayDevice,
                                             pStartRow,
                                             0,
                                             displayDevice.geometry.width,
                                             startRow,
-                                            consecutiveDirtyRows);
+                                            endRow - startRow);
     if (DISPLAY_EMSTATUS_OK != status) {
       return status;
     }
+
+    startRow = findDirtyRow(endRow, true, height);
   }
 
   /* Clear dirty rows flags. */
@@ -142,11 +142,18 @@ EMSTATUS DMD_readData(uint16_t x, uint16_t y,
                       uint8_t data[], uint32_t numPixels);
 EMSTATUS DMD_writeColor(uint16_t x, uint16_t y, uint8_t red,
                         uint8_t green, uint8_t blue, uint32_t numPixels);
+EMSTATUS DMD_writeColorMask(uint16_t x, uint16_t y, uint8_t red,
+                            uint8_t green, uint8_t blue, uint32_t mask);
+EMSTATUS DMD_writeColorSpan(uint16_t x, uint16_t y, uint16_t length,
+                            uint8_t red, uint8_t green, uint8_t blue);
+EMSTATUS DMD_writeColorLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
+                            uint8_t red, uint8_t green, uint8_t blue);
 EMSTATUS DMD_sleep(void);
 EMSTATUS DMD_wakeUp(void);
 EMSTATUS DMD_flipDisplay(int horizontal, int vertical);
 
 EMSTATUS DMD_selectFramebuffer (void *framebuffer);
+EMSTATUS DMD_enableDoubleBuffering (void);
 EMSTATUS DMD_getFrameBuffer (void **framebuffer);
 EMSTATUS DMD_updateDisplay (void);
 
@@ -20,6 +20,7 @@
 
 /* C Standard header files */
 #include <stdint.h>
+#include <string.h>
 
 /* EM types */
 #include "em_types.h"
@@ -29,6 +30,10 @@
 #define MODE_RLE     (0)
 #define MODE_8BIT    (1)
 
+/* Bytes of raw data BMP_readMonoRow converts at a time. Multiple of 6 so
+   that it holds whole 24-bit pixels and whole RLE8 pairs. */
+#define MONO_CHUNK_SIZE    (48)
+
 BMP_Header     bmpHeader;
 BMP_Palette    bmpPalette;
 
@@ -40,6 +45,15 @@ static uint32_t fileReset    = 0;
 static uint32_t paletteRead  = 0;
 static uint32_t bytesInImage = 0;
 static uint32_t dataIdx      = 0;
+static uint32_t monoRowIdx   = 0;
+
+/* 4x4 Bayer matrix used by BMP_MONO_DITHER */
+static const uint8_t bayer4x4[4][4] = {
+  { 0, 8, 2, 10 },
+  { 12, 4, 14, 6 },
+  { 3, 11, 1, 9 },
+  { 15, 7, 13, 5 }
+};
 
 /** RLE Info structure. */
 typedef struct __BMP_RleInfo{
@@ -67,6 +81,8 @@ static EMSTATUS BMP_readRawDataRLE8(BMP_DataType *dataType, uint8_t buffer[], ui
 static EMSTATUS BMP_readPaddingBytes(uint8_t paddingBytes);
 static EMSTATUS BMP_readRleData(BMP_DataType *dataType, uint8_t buffer[], uint32_t bufLength);
 static EMSTATUS BMP_readRgbDataRLE8(uint8_t buffer[], uint32_t bufLength, uint32_t *pixelsRead);
+static void BMP_putMonoPixels(uint8_t buffer[], uint32_t *col, uint32_t count, uint32_t row,
+                              const uint8_t *rgb, BMP_MonoMode mode, uint8_t threshold);
 
 /**************************************************************************//**
 *  @brief
@@ -219,6 +235,7 @@ EMSTATUS BMP_reset()
   /* Reset static variables */
   fileReset               = 1;
   dataIdx                 = 0;
+  monoRowIdx              = 0;
   rleInfo.mode            = MODE_RLE;
   rleInfo.isPadding       = 0;
   rleInfo.pixelsRemaining = 0;
@@ -913,6 +930,144 @@ EMSTATUS BMP_readRawData(BMP_DataType *dataType, uint8_t buffer[], uint32_t bufL
   return status;
 }
 
+/**************************************************************************//**
+*  @brief
+*  Help function used by BMP_readMonoRow to convert pixels of one color to
+*  1 bit per pixel and append them to the row.
+*
+*  @param buffer
+*  Row buffer, 8 pixels per byte, starting at the least significant bit.
+*  @param col
+*  Column of the first pixel, advanced by the number of pixels appended.
+*  @param count
+*  Number of pixels of this color. Pixels beyond the width are dropped.
+*  @param row
+*  Image row, selects the dither matrix row.
+*  @param rgb
+*  Red, green and blue value of the pixels.
+*  @param mode
+*  Conversion mode.
+*  @param threshold
+*  Luminance threshold.
+******************************************************************************/
+static void BMP_putMonoPixels(uint8_t buffer[], uint32_t *col, uint32_t count, uint32_t row,
+                              const uint8_t *rgb, BMP_MonoMode mode, uint8_t threshold)
+{
+  /* Integer ITU-R BT.601 luma */
+  int32_t  luma = (77 * rgb[0] + 150 * rgb[1] + 29 * rgb[2]) >> 8;
+  int32_t  limit;
+  uint32_t x = *col;
+  uint32_t end = x + count;
+
+  if (end > bmpHeader.width) {
+    end = bmpHeader.width;
+  }
+
+  for (; x < end; x++) {
+    limit = threshold;
+    if (mode == BMP_MONO_DITHER) {
+      /* Spread the threshold over [threshold - 120, threshold + 120] */
+      limit += 16 * bayer4x4[row & 3][x & 3] + 8 - 128;
+    }
+    if (luma >= limit) {
+      buffer[x >> 3] |= 1 << (x & 0x7);
+    }
+  }
+
+  *col += count;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Reads in the next row of the BMP file and converts it to 1 bit per pixel.
+*
+*  The row is decoded from the raw 8-bit, 24-bit or RLE8 data in small chunks,
+*  so only one row of 1 bpp data is needed in RAM, no matter the size or color
+*  depth of the image. The output format matches DMD_writeData on monochrome
+*  displays: 8 pixels per byte starting at the least significant bit, 1 means
+*  white. Pixels not given by an RLE8 row are black.
+*
+*  @param buffer
+*  Buffer to hold the row. Must hold at least (width + 7) / 8 bytes.
+*  @param bufLength
+*  Buffer length in bytes.
+*  @param mode
+*  How colors are converted to black and white.
+*  @param threshold
+*  Luminance (0-255) at which pixels turn white.
+*  @param row
+*  Pointer to a uint32_t which is set to the image row that was read, counted
+*  from the top. BMP files store the bottom row first.
+*
+*  @return
+*  - Returns BMP_OK on success
+*  - Returns BMP_ERROR_END_OF_FILE if all rows have been read
+*  - Returns error code otherwise.
+******************************************************************************/
+EMSTATUS BMP_readMonoRow(uint8_t buffer[], uint32_t bufLength, BMP_MonoMode mode, uint8_t threshold, uint32_t *row)
+{
+  EMSTATUS     status;
+  BMP_DataType dataType;
+  uint8_t      chunk[MONO_CHUNK_SIZE];
+  uint32_t     col = 0;
+  uint32_t     i;
+
+  /* Check if module is initialized */
+  if (moduleInit == 0) {
+    return BMP_ERROR_MODULE_NOT_INITIALIZED;
+  }
+
+  /* Check file is reset */
+  if (fileReset == 0) {
+    return BMP_ERROR_FILE_NOT_RESET;
+  }
+
+  if (buffer == NULL || row == NULL) {
+    return BMP_ERROR_INVALID_ARGUMENT;
+  }
+
+  if (bufLength < (bmpHeader.width + 7) / 8) {
+    return BMP_ERROR_BUFFER_TOO_SMALL;
+  }
+
+  if (monoRowIdx >= bmpHeader.height || dataIdx >= bytesInImage) {
+    return BMP_ERROR_END_OF_FILE;
+  }
+
+  memset(buffer, 0, (bmpHeader.width + 7) / 8);
+
+  do {
+    status = BMP_readRawData(&dataType, chunk, MONO_CHUNK_SIZE);
+    if (status != BMP_OK && status != BMP_ERROR_END_OF_FILE) {
+      return status;
+    }
+
+    /* Convert what was read, also when the end of the file was reached */
+    if (dataType.bitsPerPixel == 24) {
+      for (i = 0; i + 2 < dataType.size; i += 3) {
+        BMP_putMonoPixels(buffer, &col, 1, monoRowIdx, &chunk[i], mode, threshold);
+      }
+    } else if (dataType.compressionType == RLE8_COMPRESSION) {
+      /* Pairs of run length and palette index */
+      for (i = 0; i + 1 < dataType.size; i += 2) {
+        BMP_putMonoPixels(buffer, &col, chunk[i], monoRowIdx,
+                          &bmpPalette.data[4 * chunk[i + 1]], mode, threshold);
+      }
+    } else {
+      /* Palette indices */
+      for (i = 0; i < dataType.size; i++) {
+        BMP_putMonoPixels(buffer, &col, 1, monoRowIdx,
+                          &bmpPalette.data[4 * chunk[i]], mode, threshold);
+      }
+    }
+  } while (status == BMP_OK && dataType.endOfRow == 0);
+
+  *row = bmpHeader.height - 1 - monoRowIdx;
+  monoRowIdx++;
+
+  return BMP_OK;
+}
+
 /**************************************************************************//**
 *  @brief
 *  Get width of BMP image in pixels
@@ -150,11 +150,21 @@ typedef struct __BMP_DataType{
   uint32_t endOfRow;
 } BMP_DataType;
 
+/** @brief Conversion of BMP colors to 1 bit per pixel, see BMP_readMonoRow()
+ */
+typedef enum __BMP_MonoMode{
+  /** Pixels with a luminance at or above the threshold become white */
+  BMP_MONO_THRESHOLD,
+  /** 4x4 ordered (Bayer) dithering centered on the threshold */
+  BMP_MONO_DITHER
+} BMP_MonoMode;
+
 /* Module prototypes */
 EMSTATUS BMP_init(uint8_t *palette, uint32_t paletteSize, EMSTATUS (*fp)(uint8_t buffer[], uint32_t bufLength, uint32_t bytesToRead));
 EMSTATUS BMP_reset(void);
 EMSTATUS BMP_readRgbData(uint8_t buffer[], uint32_t bufLength, uint32_t *pixelsRead);
 EMSTATUS BMP_readRawData(BMP_DataType *dataType, uint8_t buffer[], uint32_t bufLength);
+EMSTATUS BMP_readMonoRow(uint8_t buffer[], uint32_t bufLength, BMP_MonoMode mode, uint8_t threshold, uint32_t *row);
 
 /* Accessor functions */
 int32_t BMP_getWidth(void);
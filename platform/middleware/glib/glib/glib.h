@@ -139,6 +139,13 @@
  *   height of each character and it also contains the bitmap of each
  *   character.
  *
+ *   Each font is also available in a run-length encoded format which takes
+ *   less flash, @ref GLIB_FontNormal8x8Rle, @ref GLIB_FontNarrow6x8Rle and
+ *   @ref GLIB_FontNumber16x20Rle. They draw exactly like the raw fonts. The
+ *   class of these fonts has @ref RleFontFlag set and their pixel map is a
+ *   @ref GLIB_FontRle_t. They are generated from the raw fonts by the host
+ *   tool platform/middleware/glib/tools/glib_font_rle.py.
+ *
  * @n @section glib_bitmap Draw Bitmap
  *
  *   To draw an image or custom bitmaps on the display the @ref GLIB_drawBitmap()
@@ -150,6 +157,11 @@
  *   foreground and background color settings, and that the format of the bitmap
  *   depends on the DMD implementation of the display.
  *
+ *   On monochrome displays, 8-bit, 24-bit and RLE8 BMP files can be drawn with
+ *   @ref GLIB_drawBMP(). It reads the file through the BMP module one row at a
+ *   time and converts the colors to black and white with a threshold or with
+ *   ordered dithering, so the image never has to fit in RAM.
+ *
  * @n @section glib_example Example
  *
  *   This examples shows how to initialize a GLIB context and draw something
@@ -180,6 +192,9 @@
 /* Display Driver header files */
 #include "dmd/dmd.h"
 
+/* BMP decoder, used by GLIB_drawBMP */
+#include "bmp.h"
+
 #include "em_types.h"
 
 #ifdef __cplusplus
@@ -217,15 +232,55 @@ typedef enum __GLIB_Font_Class{
   InvalidFont = 0,  /**< Invalid font. */
   FullFont,         /**< Characters and numbers font. */
   NumbersOnlyFont,  /**< Numbers only font. */
+  RleFontFlag = 0x80, /**< Set for fonts in the run-length encoded format. */
+  FullFontRle = FullFont | RleFontFlag,               /**< Run-length encoded FullFont. */
+  NumbersOnlyFontRle = NumbersOnlyFont | RleFontFlag, /**< Run-length encoded NumbersOnlyFont. */
 } GLIB_Font_Class;
 
+/** @brief Pixel map of a run-length encoded font
+ *
+ *  The rows of each glyph are stored top down as runs of identical rows.
+ *  A run is one little endian element of runElementSize bytes. Its lowest
+ *  valueBits bits are the pixels of the row, shifted right by columnShift,
+ *  and the bits above them are the number of rows in the run minus one.
+ *  Blank rows at the bottom of a glyph are not stored.
+ *
+ *  Glyph g starts at pRunData[pBlockOffset[g >> blockShift] + pGlyphOffset[g]]
+ *  and ends where glyph g + 1 starts, so both tables have an entry for one
+ *  glyph more than the font contains.
+ */
+typedef struct __GLIB_FontRle_t{
+  /** Runs of all glyphs. */
+  const uint8_t *pRunData;
+
+  /** Offset in pRunData of every (1 << blockShift)th glyph. */
+  const uint16_t *pBlockOffset;
+
+  /** Offset of each glyph from the offset of its block. */
+  const uint8_t *pGlyphOffset;
+
+  /** Log2 of the number of glyphs per block. */
+  uint8_t blockShift;
+
+  /** Size of each run in bytes, 1 to 4. */
+  uint8_t runElementSize;
+
+  /** Number of pixel bits in each run. */
+  uint8_t valueBits;
+
+  /** Left shift which puts the pixel bits in place. */
+  uint8_t columnShift;
+} GLIB_FontRle_t;
+
 /** @brief Font definition structure
  */
 typedef struct __GLIB_Font_t{
-  /** Pointer to the pixel map for the font. */
+  /** Pointer to the pixel map for the font, a GLIB_FontRle_t for fonts with
+   *  RleFontFlag set in their class. */
   void *pFontPixMap;
 
-  /** Number of elements in the font pixel map. */
+  /** Number of elements in the font pixel map, or the number of glyphs for
+   *  run-length encoded fonts. */
   uint16_t cntOfMapElements;
 
   /** Size of each element in the font pixel map. */
@@ -331,6 +386,9 @@ EMSTATUS GLIB_drawChar(GLIB_Context_t *pContext, char myChar, int32_t x,
 EMSTATUS GLIB_drawBitmap(GLIB_Context_t *pContext, int32_t x, int32_t y,
                          uint32_t width, uint32_t height, const uint8_t *picData);
 
+EMSTATUS GLIB_drawBMP(GLIB_Context_t *pContext, int32_t x, int32_t y,
+                      BMP_MonoMode mode, uint8_t threshold);
+
 void GLIB_invertBitmap(GLIB_Context_t *pContext, uint32_t bitmapSize,
                        uint8_t *picData);
 
@@ -366,6 +424,9 @@ EMSTATUS GLIB_drawPixelColor(GLIB_Context_t *pContext, int32_t x, int32_t y,
 extern const GLIB_Font_t GLIB_FontNormal8x8; /* Default */
 extern const GLIB_Font_t GLIB_FontNarrow6x8;
 extern const GLIB_Font_t GLIB_FontNumber16x20;
+extern const GLIB_Font_t GLIB_FontNormal8x8Rle;
+extern const GLIB_Font_t GLIB_FontNarrow6x8Rle;
+extern const GLIB_Font_t GLIB_FontNumber16x20Rle;
 
 /** @} (end addtogroup glib) */
 
@@ -24,6 +24,13 @@
 /* GLIB header files */
 #include "glib.h"
 
+/** Widest BMP image GLIB_drawBMP can draw, in pixels */
+#ifndef GLIB_BMP_MAX_WIDTH
+#define GLIB_BMP_MAX_WIDTH    (256)
+#endif
+
+static EMSTATUS bmpToGlibStatus(EMSTATUS status);
+
 /**************************************************************************//**
 *  @brief
 *  Draws a bitmap
@@ -86,6 +93,103 @@ EMSTATUS GLIB_drawBitmap(GLIB_Context_t *pContext, int32_t x, int32_t y,
   return GLIB_applyClippingRegion(pContext);
 }
 
+/**************************************************************************//**
+*  @brief
+*  Draws a BMP file on a monochrome display
+*
+*  The image is decoded one row at a time with BMP_readMonoRow() and written
+*  to the display with its top left corner at x,y. Only one row of 1 bit per
+*  pixel data is kept on the stack, so BMP files of any color depth supported
+*  by the BMP module can be drawn straight from flash or external storage.
+*
+*  BMP_init() and BMP_reset() must have been called on the file before this
+*  function is called.
+*
+*  @param pContext
+*  Pointer to a GLIB_Context_t in which the bitmap is drawn.
+*  @param x
+*  Start x-coordinate for bitmap
+*  @param y
+*  Start y-coordinate for bitmap
+*  @param mode
+*  How colors are converted to black and white
+*  @param threshold
+*  Luminance (0-255) at which pixels turn white
+*
+*  @return
+*  Returns GLIB_OK on success, or else error code
+******************************************************************************/
+EMSTATUS GLIB_drawBMP(GLIB_Context_t *pContext, int32_t x, int32_t y,
+                      BMP_MonoMode mode, uint8_t threshold)
+{
+  EMSTATUS status;
+  uint8_t  rowData[(GLIB_BMP_MAX_WIDTH + 7) / 8];
+  int32_t  width  = BMP_getWidth();
+  int32_t  height = BMP_getHeight();
+  int32_t  rows;
+  uint32_t row;
+
+  if (pContext == NULL) {
+    return GLIB_ERROR_INVALID_ARGUMENT;
+  }
+
+  if (width <= 0 || width > GLIB_BMP_MAX_WIDTH || height <= 0) {
+    return GLIB_ERROR_FILE_NOT_SUPPORTED;
+  }
+
+  /* Set display clipping area for bitmap */
+  status = DMD_setClippingArea(x, y, width, height);
+  if (status != DMD_OK) {
+    return status;
+  }
+
+  /* Rows are stored bottom-up, write each one where it belongs */
+  for (rows = 0; rows < height; rows++) {
+    status = BMP_readMonoRow(rowData, sizeof(rowData), mode, threshold, &row);
+    if (status != BMP_OK) {
+      GLIB_applyClippingRegion(pContext);
+      return bmpToGlibStatus(status);
+    }
+
+    status = DMD_writeData(0, row, rowData, width);
+    if (status != DMD_OK) {
+      GLIB_applyClippingRegion(pContext);
+      return status;
+    }
+  }
+
+  /* Reset driver clipping area to GLIB clipping region */
+  return GLIB_applyClippingRegion(pContext);
+}
+
+/**************************************************************************//**
+*  @brief
+*  Translates a BMP module error code to a GLIB error code.
+*
+*  @param status
+*  BMP error code, not BMP_OK
+*
+*  @return
+*  Returns the matching GLIB error code
+******************************************************************************/
+static EMSTATUS bmpToGlibStatus(EMSTATUS status)
+{
+  switch (status) {
+    case BMP_ERROR_IO:
+      return GLIB_ERROR_IO;
+    case BMP_ERROR_FILE_NOT_SUPPORTED:
+      return GLIB_ERROR_FILE_NOT_SUPPORTED;
+    case BMP_ERROR_INVALID_ARGUMENT:
+    case BMP_ERROR_MODULE_NOT_INITIALIZED:
+    case BMP_ERROR_FILE_NOT_RESET:
+    case BMP_ERROR_PALETTE_NOT_READ:
+      return GLIB_ERROR_INVALID_ARGUMENT;
+    default:
+      /* Truncated file or corrupt data */
+      return GLIB_ERROR_INVALID_FILE;
+  }
+}
+
 /**************************************************************************//**
 *  @brief
 *  Inverts each bit of the bitmap.
@@ -22,6 +22,7 @@
 
 /* GLIB header files */
 #include "glib.h"
+#include "glib_private.h"
 
 /* Local function prototypes */
 static EMSTATUS GLIB_drawPartialCirclePoints(GLIB_Context_t *pContext,
@@ -156,14 +157,24 @@ EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter,
   int32_t y = radius;
   int32_t d = 1 - radius;
   uint32_t drawnElements = 0;
+  uint8_t red;
+  uint8_t green;
+  uint8_t blue;
 
   /* Check arguments */
   if (pContext == NULL) {
     return GLIB_ERROR_INVALID_ARGUMENT;
   }
 
+  /* Spans are written straight to the display driver in display coordinates */
+  status = GLIB_resetDisplayClippingArea(pContext);
+  if (status != DMD_OK) {
+    return status;
+  }
+  GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
+
   /* Draws the initial circle fill line */
-  status = GLIB_drawLineH(pContext, xCenter - y, yCenter, xCenter + y);
+  status = GLIB_fillSpan(pContext, xCenter - y, yCenter, xCenter + y, red, green, blue);
   if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
     return status;
   }
@@ -182,7 +193,7 @@ EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter,
     }
 
     /* Draws horizontal fill lines using 4 way symmetry */
-    status = GLIB_drawLineH(pContext, xCenter - x, yCenter + y, xCenter + x);
+    status = GLIB_fillSpan(pContext, xCenter - x, yCenter + y, xCenter + x, red, green, blue);
     if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
       return status;
     }
@@ -190,7 +201,7 @@ EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter,
       drawnElements++;
     }
 
-    status = GLIB_drawLineH(pContext, xCenter - y, yCenter + x, xCenter + y);
+    status = GLIB_fillSpan(pContext, xCenter - y, yCenter + x, xCenter + y, red, green, blue);
     if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
       return status;
     }
@@ -198,7 +209,7 @@ EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter,
       drawnElements++;
     }
 
-    status = GLIB_drawLineH(pContext, xCenter - x, yCenter - y, xCenter + x);
+    status = GLIB_fillSpan(pContext, xCenter - x, yCenter - y, xCenter + x, red, green, blue);
     if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
       return status;
     }
@@ -206,7 +217,7 @@ EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter,
       drawnElements++;
     }
 
-    status = GLIB_drawLineH(pContext, xCenter - y, yCenter - x, xCenter + y);
+    status = GLIB_fillSpan(pContext, xCenter - y, yCenter - x, xCenter + y, red, green, blue);
     if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
       return status;
     }
@@ -216,6 +227,12 @@ EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter,
 
     x++;
   }
+
+  /* Reset driver clipping area to GLIB clipping region */
+  status = GLIB_applyClippingRegion(pContext);
+  if (status != DMD_OK) {
+    return status;
+  }
   return ((drawnElements == 0) ? GLIB_ERROR_NOTHING_TO_DRAW : GLIB_OK);
 }
 
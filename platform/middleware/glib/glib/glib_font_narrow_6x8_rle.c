@@ -0,0 +1,94 @@
+/***************************************************************************//**
+ * @file
+ * @brief Silicon Labs Graphics Library: GLIB font narrow 6x8, run-length encoded
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc.  Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.  This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* Generated from glib_font_narrow_6x8.c by tools/glib_font_rle.py, do not edit. */
+
+/* Standard C header files */
+#include <stdint.h>
+#include "glib.h"
+
+/** @brief Runs of the "GLIB_FontNarrow6x8Rle" font. */
+static const uint8_t GLIB_FontNarrow6x8RleRuns[] =
+{
+  0x64, 0x20, 0x04, 0x4a, 0x2a, 0x1f, 0x0a, 0x1f, 0x2a, 0x04, 0x1e, 0x01,
+  0x0e, 0x10, 0x0f, 0x04, 0x03, 0x13, 0x08, 0x04, 0x02, 0x19, 0x18, 0x06,
+  0x09, 0x05, 0x02, 0x15, 0x09, 0x16, 0x06, 0x04, 0x02, 0x08, 0x04, 0x42,
+  0x04, 0x08, 0x02, 0x04, 0x48, 0x04, 0x02, 0x00, 0x04, 0x15, 0x0e, 0x15,
+  0x04, 0x00, 0x24, 0x1f, 0x24, 0x60, 0x06, 0x04, 0x02, 0x40, 0x1f, 0x80,
+  0x26, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x0e, 0x11, 0x19, 0x15, 0x13,
+  0x11, 0x0e, 0x04, 0x06, 0x64, 0x0e, 0x0e, 0x11, 0x10, 0x08, 0x04, 0x02,
+  0x1f, 0x1f, 0x08, 0x04, 0x08, 0x10, 0x11, 0x0e, 0x08, 0x0c, 0x0a, 0x09,
+  0x1f, 0x28, 0x1f, 0x01, 0x0f, 0x30, 0x11, 0x0e, 0x0c, 0x02, 0x01, 0x0f,
+  0x31, 0x0e, 0x1f, 0x10, 0x08, 0x04, 0x42, 0x0e, 0x31, 0x0e, 0x31, 0x0e,
+  0x0e, 0x31, 0x1e, 0x10, 0x08, 0x06, 0x00, 0x26, 0x00, 0x26, 0x00, 0x26,
+  0x00, 0x06, 0x04, 0x02, 0x10, 0x08, 0x04, 0x02, 0x04, 0x08, 0x10, 0x20,
+  0x1f, 0x00, 0x1f, 0x01, 0x02, 0x04, 0x08, 0x04, 0x02, 0x01, 0x0e, 0x11,
+  0x10, 0x08, 0x04, 0x00, 0x04, 0x0e, 0x30, 0x16, 0x35, 0x0e, 0x0e, 0x51,
+  0x1f, 0x31, 0x0f, 0x31, 0x0f, 0x31, 0x0f, 0x0e, 0x11, 0x41, 0x11, 0x0e,
+  0x07, 0x09, 0x51, 0x09, 0x07, 0x1f, 0x21, 0x0f, 0x21, 0x1f, 0x1f, 0x21,
+  0x0f, 0x41, 0x0e, 0x11, 0x01, 0x1d, 0x31, 0x0e, 0x51, 0x1f, 0x51, 0x0e,
+  0x84, 0x0e, 0x1c, 0x68, 0x09, 0x06, 0x11, 0x09, 0x05, 0x03, 0x05, 0x09,
+  0x11, 0xa1, 0x1f, 0x11, 0x1b, 0x35, 0x51, 0x31, 0x13, 0x15, 0x19, 0x31,
+  0x0e, 0x91, 0x0e, 0x0f, 0x31, 0x0f, 0x41, 0x0e, 0x51, 0x15, 0x09, 0x16,
+  0x0f, 0x31, 0x0f, 0x05, 0x09, 0x11, 0x1e, 0x21, 0x0e, 0x30, 0x0f, 0x1f,
+  0xa4, 0xb1, 0x0e, 0x91, 0x0a, 0x04, 0x51, 0x55, 0x0a, 0x31, 0x0a, 0x04,
+  0x0a, 0x31, 0x51, 0x0a, 0x44, 0x1f, 0x10, 0x08, 0x04, 0x02, 0x01, 0x1f,
+  0x0e, 0x82, 0x0e, 0x20, 0x01, 0x02, 0x04, 0x08, 0x10, 0x0e, 0x88, 0x0e,
+  0x04, 0x0a, 0x11, 0xa0, 0x1f, 0x02, 0x04, 0x08, 0x20, 0x0e, 0x10, 0x1e,
+  0x11, 0x1e, 0x21, 0x0d, 0x13, 0x31, 0x0f, 0x20, 0x0e, 0x21, 0x11, 0x0e,
+  0x30, 0x16, 0x19, 0x31, 0x1e, 0x20, 0x0e, 0x11, 0x1f, 0x01, 0x0e, 0x0c,
+  0x12, 0x02, 0x07, 0x42, 0x00, 0x1e, 0x31, 0x1e, 0x10, 0x0e, 0x21, 0x0d,
+  0x13, 0x51, 0x04, 0x00, 0x06, 0x44, 0x0e, 0x08, 0x00, 0x0c, 0x28, 0x09,
+  0x06, 0x21, 0x09, 0x05, 0x03, 0x05, 0x09, 0x06, 0x84, 0x0e, 0x20, 0x0b,
+  0x35, 0x31, 0x20, 0x0d, 0x13, 0x51, 0x20, 0x0e, 0x51, 0x0e, 0x20, 0x0f,
+  0x11, 0x0f, 0x21, 0x20, 0x16, 0x19, 0x1e, 0x30, 0x20, 0x0d, 0x13, 0x41,
+  0x20, 0x0e, 0x01, 0x0e, 0x10, 0x0f, 0x22, 0x07, 0x22, 0x12, 0x0c, 0x20,
+  0x51, 0x19, 0x16, 0x20, 0x51, 0x0a, 0x04, 0x20, 0x31, 0x35, 0x0a, 0x20,
+  0x11, 0x0a, 0x04, 0x0a, 0x11, 0x20, 0x31, 0x1e, 0x10, 0x0e, 0x20, 0x1f,
+  0x08, 0x04, 0x02, 0x1f, 0x0c, 0x22, 0x01, 0x22, 0x0c, 0xc4, 0x06, 0x28,
+  0x10, 0x28, 0x06, 0x00, 0x02, 0x15, 0x08
+};
+
+/** @brief Offset of every 32. glyph in the runs. */
+static const uint16_t GLIB_FontNarrow6x8RleBlocks[] =
+{
+  0, 161, 293
+};
+
+/** @brief Offset of each glyph from the offset of its block. */
+static const uint8_t GLIB_FontNarrow6x8RleGlyphs[] =
+{
+  0x00, 0x00, 0x03, 0x04, 0x09, 0x10, 0x17, 0x1e, 0x21, 0x26, 0x2b, 0x31,
+  0x35, 0x39, 0x3b, 0x3d, 0x43, 0x4a, 0x4e, 0x55, 0x5c, 0x62, 0x68, 0x6e,
+  0x73, 0x78, 0x7e, 0x82, 0x88, 0x8f, 0x93, 0x9a, 0x00, 0x05, 0x09, 0x0e,
+  0x13, 0x18, 0x1d, 0x21, 0x27, 0x2a, 0x2d, 0x31, 0x38, 0x3a, 0x3e, 0x43,
+  0x46, 0x4a, 0x4f, 0x55, 0x5a, 0x5c, 0x5e, 0x61, 0x64, 0x69, 0x6c, 0x73,
+  0x76, 0x7c, 0x7f, 0x82, 0x00, 0x03, 0x09, 0x0e, 0x13, 0x18, 0x1e, 0x23,
+  0x29, 0x2d, 0x32, 0x38, 0x3e, 0x41, 0x45, 0x49, 0x4d, 0x52, 0x57, 0x5b,
+  0x61, 0x66, 0x6a, 0x6e, 0x72, 0x78, 0x7d, 0x83, 0x88, 0x89, 0x8e, 0x92
+};
+
+/** @brief Pixel map of the "GLIB_FontNarrow6x8Rle" font. */
+static const GLIB_FontRle_t GLIB_FontNarrow6x8RlePixMap =
+{ GLIB_FontNarrow6x8RleRuns, GLIB_FontNarrow6x8RleBlocks, GLIB_FontNarrow6x8RleGlyphs,
+  5, 1, 5, 0 };
+
+/**
+ * @brief Run-length encoded version of GLIB_FontNarrow6x8.
+ */
+const GLIB_Font_t GLIB_FontNarrow6x8Rle = { (void *)&GLIB_FontNarrow6x8RlePixMap,
+                                            95, 1, 0, 6, 8, 2, 0, FullFontRle };
@@ -0,0 +1,98 @@
+/***************************************************************************//**
+ * @file
+ * @brief Silicon Labs Graphics Library: GLIB font normal 8x8, run-length encoded
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc.  Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.  This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* Generated from glib_font_normal_8x8.c by tools/glib_font_rle.py, do not edit. */
+
+/* Standard C header files */
+#include <stdint.h>
+#include "glib.h"
+
+/** @brief Runs of the "GLIB_FontNormal8x8Rle" font. */
+static const uint8_t GLIB_FontNormal8x8RleRuns[] =
+{
+  0x8c, 0x8c, 0x00, 0x8c, 0xb6, 0x24, 0x36, 0xff, 0x36, 0xff, 0x36, 0x08,
+  0x7e, 0x0b, 0x3e, 0x68, 0x3f, 0x08, 0x67, 0x35, 0x17, 0x08, 0x74, 0x56,
+  0x73, 0x1c, 0x96, 0x6e, 0xb3, 0x6e, 0x04, 0x8c, 0x30, 0x18, 0x8c, 0x0c,
+  0x18, 0x30, 0x06, 0x0c, 0x98, 0x18, 0x0c, 0x06, 0x00, 0x36, 0x1c, 0x7f,
+  0x1c, 0x36, 0x00, 0x8c, 0xbf, 0x8c, 0x80, 0x00, 0x8e, 0x0c, 0x06, 0x80,
+  0x00, 0xbf, 0x80, 0x80, 0x8e, 0x0e, 0x00, 0x60, 0x30, 0x18, 0x0c, 0x06,
+  0x03, 0x3e, 0xe3, 0xe3, 0x63, 0x3e, 0x18, 0x1c, 0x98, 0x98, 0x3c, 0x3e,
+  0x63, 0x30, 0x18, 0x0c, 0x06, 0x7f, 0x3e, 0x63, 0x60, 0x38, 0x60, 0x63,
+  0x3e, 0xe3, 0x63, 0x7f, 0xe0, 0x60, 0x7f, 0x83, 0x3f, 0x60, 0x63, 0x3e,
+  0x3e, 0x63, 0x03, 0x3f, 0xe3, 0x3e, 0x7f, 0x60, 0x30, 0x18, 0x0c, 0x06,
+  0x03, 0x3e, 0xe3, 0x3e, 0xe3, 0x3e, 0x3e, 0xe3, 0x7e, 0x60, 0x63, 0x3e,
+  0x00, 0x8c, 0x00, 0x8c, 0x00, 0x8c, 0x00, 0x8c, 0x06, 0x38, 0x1c, 0x0e,
+  0x07, 0x0e, 0x1c, 0x38, 0x00, 0xbe, 0x00, 0xbe, 0x0e, 0x1c, 0x38, 0x70,
+  0x38, 0x1c, 0x0e, 0x3e, 0xe3, 0x38, 0x18, 0x00, 0x18, 0x3e, 0x63, 0xfb,
+  0x3b, 0x03, 0x3e, 0x3e, 0xe3, 0x7f, 0xe3, 0x63, 0x3f, 0xe3, 0x3f, 0xe3,
+  0x3f, 0x3e, 0x63, 0x83, 0x03, 0x63, 0x3e, 0x3f, 0xe3, 0xe3, 0x63, 0x3f,
+  0x7f, 0x83, 0x0f, 0x83, 0x7f, 0x7f, 0x83, 0x0f, 0x83, 0x03, 0x3e, 0x63,
+  0x03, 0x7b, 0xe3, 0x7e, 0xe3, 0x63, 0x7f, 0xe3, 0x63, 0x1e, 0x8c, 0x8c,
+  0x0c, 0x1e, 0x3c, 0x98, 0x98, 0x1b, 0x0e, 0x63, 0x33, 0x1b, 0x0f, 0x1b,
+  0x33, 0x63, 0x83, 0x83, 0x83, 0x7f, 0x63, 0x77, 0x7f, 0x6b, 0xe3, 0x63,
+  0x63, 0x67, 0x6f, 0x7b, 0x73, 0xe3, 0x3e, 0xe3, 0xe3, 0x63, 0x3e, 0x3f,
+  0xe3, 0x3f, 0x83, 0x03, 0x3e, 0xe3, 0x63, 0x5b, 0x33, 0x6e, 0x3f, 0xe3,
+  0x3f, 0xe3, 0x63, 0x3e, 0x63, 0x03, 0x3e, 0x60, 0x63, 0x3e, 0x3f, 0x8c,
+  0x8c, 0x8c, 0xe3, 0xe3, 0xe3, 0x3e, 0xe3, 0xe3, 0x63, 0x36, 0x1c, 0xe3,
+  0x63, 0x6b, 0x7f, 0x77, 0x63, 0xe3, 0x36, 0x1c, 0x36, 0xe3, 0xe3, 0x63,
+  0x7e, 0xe0, 0x3f, 0x7f, 0x60, 0x30, 0x18, 0x0c, 0x06, 0x7f, 0x3e, 0x86,
+  0x86, 0x06, 0x3e, 0x00, 0x03, 0x06, 0x0c, 0x18, 0x30, 0x60, 0x3e, 0xb0,
+  0xb0, 0x30, 0x3e, 0x08, 0x1c, 0x36, 0x63, 0x80, 0x80, 0x00, 0xff, 0x86,
+  0x02, 0x80, 0x1e, 0x30, 0x3e, 0x33, 0x3e, 0x83, 0x1f, 0xb3, 0x33, 0x1f,
+  0x80, 0x1e, 0x83, 0x03, 0x1e, 0xb0, 0x3e, 0xb3, 0x33, 0x3e, 0x80, 0x1e,
+  0x33, 0x3f, 0x03, 0x1e, 0x1c, 0x06, 0x1e, 0x86, 0x86, 0x80, 0x1e, 0x33,
+  0x3e, 0x30, 0x1f, 0x83, 0x1f, 0xb3, 0xb3, 0x00, 0x0c, 0x00, 0x8c, 0x0c,
+  0x38, 0x00, 0x18, 0x00, 0x98, 0x1b, 0x0e, 0x83, 0x33, 0x1b, 0x0f, 0x1b,
+  0x33, 0x86, 0x86, 0x86, 0x1c, 0x80, 0x37, 0xeb, 0xe3, 0x80, 0x1f, 0xb3,
+  0xb3, 0x80, 0x1e, 0xb3, 0x33, 0x1e, 0x80, 0x1f, 0x33, 0x1f, 0x83, 0x80,
+  0x1e, 0x33, 0x2b, 0x13, 0x2e, 0x80, 0x1b, 0x37, 0x83, 0x03, 0x80, 0x1e,
+  0x03, 0x1e, 0x30, 0x1f, 0x00, 0x8c, 0x3e, 0x8c, 0x38, 0x80, 0xb3, 0xb3,
+  0x3e, 0x80, 0xb3, 0x33, 0x1e, 0x0c, 0x80, 0xe3, 0xeb, 0x7e, 0x80, 0x33,
+  0x1e, 0x0c, 0x1e, 0x33, 0x80, 0xb3, 0x3e, 0x30, 0x1f, 0x80, 0x3f, 0x18,
+  0x0c, 0x06, 0x3f, 0x18, 0x8c, 0x06, 0x8c, 0x18, 0x8c, 0x0c, 0x00, 0x8c,
+  0x0c, 0x0c, 0x98, 0x30, 0x98, 0x0c, 0x46, 0x6b, 0x31
+};
+
+/** @brief Offset of every 32. glyph in the runs. */
+static const uint16_t GLIB_FontNormal8x8RleBlocks[] =
+{
+  0, 165, 335
+};
+
+/** @brief Offset of each glyph from the offset of its block. */
+static const uint8_t GLIB_FontNormal8x8RleGlyphs[] =
+{
+  0x00, 0x00, 0x04, 0x06, 0x0b, 0x12, 0x19, 0x1e, 0x20, 0x26, 0x2c, 0x32,
+  0x36, 0x3b, 0x3e, 0x42, 0x49, 0x4e, 0x53, 0x5a, 0x61, 0x66, 0x6c, 0x72,
+  0x79, 0x7e, 0x84, 0x88, 0x8d, 0x94, 0x98, 0x9f, 0x00, 0x06, 0x0b, 0x10,
+  0x16, 0x1b, 0x20, 0x25, 0x2b, 0x30, 0x35, 0x3a, 0x41, 0x45, 0x4b, 0x51,
+  0x56, 0x5b, 0x61, 0x66, 0x6d, 0x71, 0x75, 0x7a, 0x80, 0x85, 0x8a, 0x91,
+  0x96, 0x9d, 0xa2, 0xa6, 0x00, 0x02, 0x08, 0x0d, 0x12, 0x17, 0x1d, 0x22,
+  0x28, 0x2c, 0x32, 0x38, 0x3e, 0x42, 0x46, 0x4a, 0x4f, 0x54, 0x5a, 0x5f,
+  0x65, 0x6a, 0x6e, 0x73, 0x77, 0x7d, 0x82, 0x88, 0x8d, 0x92, 0x97, 0x9a
+};
+
+/** @brief Pixel map of the "GLIB_FontNormal8x8Rle" font. */
+static const GLIB_FontRle_t GLIB_FontNormal8x8RlePixMap =
+{ GLIB_FontNormal8x8RleRuns, GLIB_FontNormal8x8RleBlocks, GLIB_FontNormal8x8RleGlyphs,
+  5, 1, 7, 1 };
+
+/**
+ * @brief Run-length encoded version of GLIB_FontNormal8x8.
+ */
+const GLIB_Font_t GLIB_FontNormal8x8Rle = { (void *)&GLIB_FontNormal8x8RlePixMap,
+                                            95, 1, 0, 8, 8, 2, 0, FullFontRle };
@@ -0,0 +1,73 @@
+/***************************************************************************//**
+ * @file
+ * @brief Silicon Labs Graphics Library: GLIB font number '0'-'9', ':' and ' ', 16x20 pixels, run-length encoded
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc.  Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.  This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* Generated from glib_font_number_16x20.c by tools/glib_font_rle.py, do not edit. */
+
+/* Standard C header files */
+#include <stdint.h>
+#include "glib.h"
+
+/** @brief Runs of the "GLIB_FontNumber16x20Rle" font. */
+static const uint8_t GLIB_FontNumber16x20RleRuns[] =
+{
+  0x00, 0x20, 0xf0, 0x00, 0xfc, 0x03, 0x9e, 0x07, 0x0e, 0x07, 0x07, 0xee,
+  0x07, 0x0e, 0x0e, 0x07, 0x9e, 0x07, 0xfc, 0x03, 0xf0, 0x00, 0x00, 0x20,
+  0xc0, 0x00, 0xf8, 0x00, 0xff, 0x00, 0xef, 0x00, 0xe0, 0xe0, 0xe0, 0x40,
+  0xff, 0x3f, 0x00, 0x20, 0xf0, 0x01, 0xf8, 0x03, 0x1c, 0x07, 0x0e, 0x4e,
+  0x00, 0x0f, 0x00, 0x07, 0x80, 0x03, 0xc0, 0x01, 0xe0, 0x00, 0x70, 0x00,
+  0x38, 0x00, 0x1c, 0x00, 0x0e, 0x00, 0xff, 0x2f, 0x00, 0x20, 0xf8, 0x00,
+  0xfc, 0x03, 0x8e, 0x03, 0x06, 0x07, 0x00, 0x27, 0x80, 0x03, 0xf0, 0x21,
+  0x80, 0x07, 0x00, 0x0f, 0x00, 0x4e, 0x03, 0x07, 0xff, 0x07, 0xfc, 0x01,
+  0x00, 0x20, 0xc0, 0x03, 0xe0, 0x23, 0xf0, 0x03, 0xb8, 0x23, 0x9c, 0x23,
+  0x8e, 0x03, 0x87, 0x03, 0xff, 0x2f, 0x80, 0x43, 0xf0, 0x2f, 0x00, 0x20,
+  0xfe, 0x27, 0x0e, 0x40, 0xee, 0x01, 0xfe, 0x03, 0x0e, 0x07, 0x06, 0x0e,
+  0x00, 0x8e, 0x03, 0x07, 0xff, 0x03, 0xfc, 0x01, 0x00, 0x20, 0xc0, 0x07,
+  0xf0, 0x0f, 0x78, 0x0c, 0x1c, 0x00, 0x0e, 0x20, 0xf7, 0x01, 0xff, 0x03,
+  0x1f, 0x07, 0x0f, 0x0f, 0x0f, 0x0e, 0x07, 0x2e, 0x0e, 0x0e, 0x0e, 0x07,
+  0xfc, 0x07, 0xf0, 0x01, 0x00, 0x20, 0xff, 0x27, 0x03, 0x27, 0x80, 0x43,
+  0xc0, 0x41, 0xe0, 0x01, 0xe0, 0x40, 0x70, 0x40, 0x00, 0x20, 0xf8, 0x01,
+  0xfe, 0x03, 0x0e, 0x07, 0x07, 0x4e, 0x0e, 0x07, 0xfc, 0x23, 0x0e, 0x07,
+  0x07, 0x6e, 0x0e, 0x07, 0xfe, 0x07, 0xf8, 0x01, 0x00, 0x20, 0xf8, 0x00,
+  0xfc, 0x01, 0x8e, 0x03, 0x07, 0x07, 0x07, 0x06, 0x07, 0x2e, 0x07, 0x0f,
+  0x8e, 0x0f, 0xfc, 0x0f, 0xf8, 0x0e, 0x00, 0x0f, 0x00, 0x07, 0x80, 0x03,
+  0xe3, 0x03, 0xff, 0x00, 0x3e, 0x00, 0x00, 0x60, 0x60, 0x00, 0xf0, 0x20,
+  0x60, 0x00, 0x00, 0x60, 0x60, 0x00, 0xf0, 0x20, 0x60, 0x00
+};
+
+/** @brief Offset of every 8. glyph in the runs. */
+static const uint16_t GLIB_FontNumber16x20RleBlocks[] =
+{
+  0, 188
+};
+
+/** @brief Offset of each glyph from the offset of its block. */
+static const uint8_t GLIB_FontNumber16x20RleGlyphs[] =
+{
+  0x00, 0x16, 0x26, 0x44, 0x60, 0x76, 0x8c, 0xac, 0x00, 0x18, 0x3a, 0x4a,
+  0x4a
+};
+
+/** @brief Pixel map of the "GLIB_FontNumber16x20Rle" font. */
+static const GLIB_FontRle_t GLIB_FontNumber16x20RlePixMap =
+{ GLIB_FontNumber16x20RleRuns, GLIB_FontNumber16x20RleBlocks, GLIB_FontNumber16x20RleGlyphs,
+  3, 2, 13, 2 };
+
+/**
+ * @brief Run-length encoded version of GLIB_FontNumber16x20.
+ */
+const GLIB_Font_t GLIB_FontNumber16x20Rle = { (void *)&GLIB_FontNumber16x20RlePixMap,
+                                              12, 2, 0, 16, 20, 5, 0, NumbersOnlyFontRle };
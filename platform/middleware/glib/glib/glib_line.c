@@ -24,12 +24,66 @@
 
 /* GLIB Header files */
 #include "glib.h"
+#include "glib_private.h"
 
 /* Local function prototypes */
 static uint8_t GLIB_getClipCode(GLIB_Context_t *pContext, int32_t x, int32_t y);
 static bool GLIB_clipLine(GLIB_Context_t *pContext, int32_t *pX1, int32_t *pY1,
                           int32_t *pX2, int32_t *pY2);
 
+/**************************************************************************//**
+*  @brief
+*  Fills the pixels from x1 to x2 on row y, clipped to the clipping region
+*
+*  Building block for the filled primitives: the caller translates the color
+*  once and resets the display driver clipping area to the whole display
+*  (GLIB_resetDisplayClippingArea) before drawing its spans.
+*
+*  @param pContext
+*  Pointer to a GLIB_Context_t holding the clipping region
+*  @param x1
+*  Start x-coordinate
+*  @param y
+*  Row y-coordinate
+*  @param x2
+*  End x-coordinate, the span is empty if x2 < x1
+*  @param red
+*  Red component of the color
+*  @param green
+*  Green component of the color
+*  @param blue
+*  Blue component of the color
+*
+*  @return
+*  Returns GLIB_OK on success, GLIB_ERROR_NOTHING_TO_DRAW if the span is
+*  clipped away, or else error code
+******************************************************************************/
+EMSTATUS GLIB_fillSpan(const GLIB_Context_t *pContext, int32_t x1, int32_t y,
+                       int32_t x2, uint8_t red, uint8_t green, uint8_t blue)
+{
+  EMSTATUS status;
+
+  /* Clip the span, nothing is left if it is outside the clipping region */
+  if ((y < pContext->clippingRegion.yMin) || (y > pContext->clippingRegion.yMax)) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+  if (x1 < pContext->clippingRegion.xMin) {
+    x1 = pContext->clippingRegion.xMin;
+  }
+  if (x2 > pContext->clippingRegion.xMax) {
+    x2 = pContext->clippingRegion.xMax;
+  }
+  if (x1 > x2) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+
+  status = DMD_writeColorSpan(x1, y, x2 - x1 + 1, red, green, blue);
+  if (status != DMD_OK) {
+    return status;
+  }
+  return GLIB_OK;
+}
+
 /**************************************************************************//**
 *  @brief
 *  Draws a horizontal line from x1, y1 to x2, y2
@@ -56,7 +110,6 @@ EMSTATUS GLIB_drawLineH(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
   uint8_t red;
   uint8_t green;
   uint8_t blue;
-  uint32_t length;
 
   /* Check arguments */
   if (pContext == NULL) {
@@ -80,24 +133,15 @@ EMSTATUS GLIB_drawLineH(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
     return GLIB_ERROR_NOTHING_TO_DRAW;
   }
 
-  /* Clip the line if necessary */
-  if (x1 < pContext->clippingRegion.xMin) {
-    x1 = pContext->clippingRegion.xMin;
-  }
-  if (x2 > pContext->clippingRegion.xMax) {
-    x2 = pContext->clippingRegion.xMax;
-  }
-
   /* Translate color and draw line using display driver */
-  length = x2 - x1 + 1;
-  status = DMD_setClippingArea(x1, y1, length, 1);
+  status = GLIB_resetDisplayClippingArea(pContext);
   if (status != DMD_OK) {
     return status;
   }
 
   GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
-  status = DMD_writeColor(0, 0, red, green, blue, length);
-  if (status != DMD_OK) {
+  status = GLIB_fillSpan(pContext, x1, y1, x2, red, green, blue);
+  if (status != GLIB_OK) {
     return status;
   }
 
@@ -127,7 +171,6 @@ EMSTATUS GLIB_drawLineV(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
 {
   EMSTATUS status;
   int32_t swap;
-  int32_t length;
   uint8_t red;
   uint8_t green;
   uint8_t blue;
@@ -162,15 +205,14 @@ EMSTATUS GLIB_drawLineV(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
     y2 = pContext->clippingRegion.yMax;
   }
 
-  /* Translate color and draw line using display driver clipping (width = 1 => height <=> length) */
-  length = y2 - y1 + 1;
-  status = DMD_setClippingArea(x1, y1, 1, length);
+  /* Translate color and draw line using display driver */
+  status = GLIB_resetDisplayClippingArea(pContext);
   if (status != DMD_OK) {
     return status;
   }
 
   GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
-  status = DMD_writeColor(0, 0, red, green, blue, length);
+  status = DMD_writeColorLine(x1, y1, x1, y2, red, green, blue);
   if (status != DMD_OK) {
     return status;
   }
@@ -338,13 +380,10 @@ EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
                        int32_t x2, int32_t y2)
 {
   EMSTATUS status;
-  int32_t error;
-  int32_t deltaX;
-  int32_t deltaY;
-  int32_t yMotion;
-  int32_t xMotion;
-  bool steepLine = false;
-  int32_t yStep = 1;
+  DMD_DisplayGeometry clipArea;
+  uint8_t red;
+  uint8_t green;
+  uint8_t blue;
 
   /* Check arguments */
   if (pContext == NULL) {
@@ -366,68 +405,21 @@ EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
     return GLIB_ERROR_NOTHING_TO_DRAW;
   }
 
-  /* Determine if steep or not steep
-   * (Steep means more motion in Y-direction than X-direction) */
-  yMotion = (y2 > y1) ? (y2 - y1) : (y1 - y2);
-  xMotion = (x2 > x1) ? (x2 - x1) : (x1 - x2);
-  if (yMotion > xMotion) {
-    /* If line is steep, swap x and y values */
-    steepLine = true;
-
-    error = x1;
-    x1    = y1;
-    y1    = error;
-
-    error = x2;
-    x2    = y2;
-    y2    = error;
-  }
-
-  /* Place the leftmost point in x1, y1 */
-  if (x2 < x1) {
-    /* Swap x-values */
-    error = x1;
-    x1    = x2;
-    x2    = error;
-
-    /* Swap y-values */
-    error = y1;
-    y1    = y2;
-    y2    = error;
-  }
-
-  /* Compute the differences between the points */
-  deltaX = x2 - x1;
-  deltaY = (y2 > y1) ? (y2 - y1) : (y1 - y2);
-
-  /* Set error to negative half deltaX ? */
-  error = -deltaX / 2;
-
-  /* Determine which direction to step in */
-  if (y2 < y1) {
-    yStep = -1;
+  /* The clipped end points are inside the display, let the display driver
+   * step through the points in display coordinates and then restore its
+   * clipping area */
+  clipArea = *pContext->pDisplayGeometry;
+  status = GLIB_resetDisplayClippingArea(pContext);
+  if (status != DMD_OK) {
+    return status;
   }
 
-  /* Loop through all points along the x-axis */
-  for (; x1 <= x2; x1++) {
-    if (steepLine) {
-      /* If steep, swap x and y coordinates */
-      status = GLIB_drawPixel(pContext, y1, x1);
-    } else {
-      status = GLIB_drawPixel(pContext, x1, y1);
-    }
-
-    if (status != GLIB_OK) {
-      return status;
-    }
-
-    error += deltaY;
-
-    if (error > 0) {
-      y1    += yStep;
-      error -= deltaX;
-    }
+  GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
+  status = DMD_writeColorLine(x1, y1, x2, y2, red, green, blue);
+  if (status != DMD_OK) {
+    return status;
   }
 
-  return GLIB_OK;
+  return DMD_setClippingArea(clipArea.xClipStart, clipArea.yClipStart,
+                             clipArea.clipWidth, clipArea.clipHeight);
 }
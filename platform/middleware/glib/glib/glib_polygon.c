@@ -23,6 +23,7 @@
 
 /* GLIB header files */
 #include "glib.h"
+#include "glib_private.h"
 
 /* Polygon fill algorithm allocation sizes */
 enum {
@@ -134,6 +135,8 @@ EMSTATUS GLIB_drawPolygonFilled(GLIB_Context_t *pContext,
   int32_t cur_y, min_y, max_y;
   int32_t cross_x[MAX_CROSSES];
   int32_t curpoint_y, curpoint_x, prvpoint_y, prvpoint_x;
+  EMSTATUS status;
+  uint8_t red, green, blue;
 
   /* Check arguments */
   if (pContext == NULL || polyPoints == NULL || numPoints < 2
@@ -141,6 +144,13 @@ EMSTATUS GLIB_drawPolygonFilled(GLIB_Context_t *pContext,
     return GLIB_ERROR_INVALID_ARGUMENT;
   }
 
+  /* Spans are written straight to the display driver in display coordinates */
+  status = GLIB_resetDisplayClippingArea(pContext);
+  if (status != DMD_OK) {
+    return status;
+  }
+  GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
+
   /* Find bounding box (respecting clipping region) */
   min_y = max_y = polyPoints[1];
   for (i = 1; i < numPoints; i++) {
@@ -174,9 +184,14 @@ EMSTATUS GLIB_drawPolygonFilled(GLIB_Context_t *pContext,
 
     /* Draw horizontal lines between intersection point 2-tuples */
     for (i = 0; i < numcrosses; i += 2) {
-      GLIB_drawLineH(pContext, cross_x[i], cur_y, cross_x[i + 1]);
+      if (cross_x[i] <= cross_x[i + 1]) {
+        GLIB_fillSpan(pContext, cross_x[i], cur_y, cross_x[i + 1], red, green, blue);
+      } else {
+        GLIB_fillSpan(pContext, cross_x[i + 1], cur_y, cross_x[i], red, green, blue);
+      }
     }
   }
 
-  return GLIB_OK;
+  /* Reset driver clipping area to GLIB clipping region */
+  return GLIB_applyClippingRegion(pContext);
 }
@@ -0,0 +1,39 @@
+/***************************************************************************//**
+ * @file
+ * @brief Silicon Labs Graphics Library: Internal Routines
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc.  Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.  This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef __GLIB_PRIVATE_H
+#define __GLIB_PRIVATE_H
+
+/* Shared between the GLIB source files only, not part of the GLIB API. */
+
+#include <stdint.h>
+
+#include "em_types.h"
+#include "glib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EMSTATUS GLIB_fillSpan(const GLIB_Context_t *pContext, int32_t x1, int32_t y,
+                       int32_t x2, uint8_t red, uint8_t green, uint8_t blue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -26,6 +26,23 @@
 #include "glib.h"
 #include "glib_color.h"
 
+/* Position in the pixel map while the rows of a char are read */
+typedef struct {
+  const GLIB_Font_t *pFont;
+  uint16_t fontIdx;        /* Raw fonts: index of the next row */
+  const uint8_t *pRun;     /* RLE fonts: next run */
+  const uint8_t *pEnd;     /* RLE fonts: end of the runs of the char */
+  uint32_t runRow;         /* RLE fonts: row of the current run */
+  uint32_t runLeft;        /* RLE fonts: rows left in the current run */
+} GLIB_CharRows_t;
+
+/* Local function declarations */
+static void GLIB_charRowsInit(GLIB_CharRows_t *pRows, const GLIB_Font_t *pFont,
+                              uint16_t fontIdx);
+static uint32_t GLIB_charRowsNext(GLIB_CharRows_t *pRows);
+static EMSTATUS GLIB_drawCharRows(GLIB_Context_t *pContext, uint16_t fontIdx,
+                                  int32_t x, int32_t y, bool opaque);
+
 /**************************************************************************//**
 *  @brief
 *  Draws a char using the font supplied with the library.
@@ -54,9 +71,7 @@ EMSTATUS GLIB_drawChar(GLIB_Context_t *pContext, char myChar, int32_t x, int32_t
 {
   EMSTATUS status;
   uint16_t fontIdx;
-  uint8_t *pPixMap8;
-  uint16_t *pPixMap16;
-  uint32_t *pPixMap32;
+  GLIB_CharRows_t rows;
   uint16_t row;
   uint32_t currentRow;
   uint16_t xOffset;
@@ -73,7 +88,7 @@ EMSTATUS GLIB_drawChar(GLIB_Context_t *pContext, char myChar, int32_t x, int32_t
   }
 
   /* Sets the index in the font array */
-  if (pContext->font.class == NumbersOnlyFont) {
+  if ((pContext->font.class & ~RleFontFlag) == NumbersOnlyFont) {
     fontIdx = (myChar - '0');
     if (myChar == ':') {
       fontIdx = 10;
@@ -89,24 +104,16 @@ EMSTATUS GLIB_drawChar(GLIB_Context_t *pContext, char myChar, int32_t x, int32_t
     return GLIB_ERROR_INVALID_CHAR;
   }
 
+  /* Characters up to 32 pixels wide are drawn a whole row at a time */
+  if (pContext->font.fontWidth + pContext->font.charSpacing <= 32) {
+    return GLIB_drawCharRows(pContext, fontIdx, x, y, opaque);
+  }
+
   /* Loop through the rows and draw the font */
-  pPixMap8 = (uint8_t *)pContext->font.pFontPixMap;
-  pPixMap16 = (uint16_t *)pContext->font.pFontPixMap;
-  pPixMap32 = (uint32_t *)pContext->font.pFontPixMap;
+  GLIB_charRowsInit(&rows, &pContext->font, fontIdx);
 
   for (row = 0; row < pContext->font.fontHeight; row++) {
-    switch (pContext->font.sizeOfMapElement) {
-      case 1:
-        currentRow = pPixMap8[fontIdx];
-        break;
-
-      case 2:
-        currentRow = pPixMap16[fontIdx];
-        break;
-
-      default:
-        currentRow = pPixMap32[fontIdx];
-    }
+    currentRow = GLIB_charRowsNext(&rows);
 
     for (xOffset = 0; xOffset < pContext->font.fontWidth; ++xOffset) {
       /* Bit 1 means draw, Bit 0 means do not draw */
@@ -144,11 +151,187 @@ EMSTATUS GLIB_drawChar(GLIB_Context_t *pContext, char myChar, int32_t x, int32_t
         }
       }
     }
+  }
+  return ((drawnElements == 0) ? GLIB_ERROR_NOTHING_TO_DRAW : GLIB_OK);
+}
+
+/**************************************************************************//**
+*  @brief
+*  Starts reading the rows of a char from the font pixel map.
+*  @param pRows
+*  Read position to initialize
+*  @param pFont
+*  Font of the char
+*  @param fontIdx
+*  Index of the char in the font
+******************************************************************************/
+static void GLIB_charRowsInit(GLIB_CharRows_t *pRows, const GLIB_Font_t *pFont,
+                              uint16_t fontIdx)
+{
+  const GLIB_FontRle_t *pRle;
+  uint32_t next = fontIdx + 1;
+
+  pRows->pFont = pFont;
+  pRows->fontIdx = fontIdx;
+  pRows->runLeft = 0;
+
+  if (pFont->class & RleFontFlag) {
+    /* The runs of a char end where the runs of the next char start */
+    pRle = (const GLIB_FontRle_t *)pFont->pFontPixMap;
+    pRows->pRun = pRle->pRunData + pRle->pBlockOffset[fontIdx >> pRle->blockShift]
+                  + pRle->pGlyphOffset[fontIdx];
+    pRows->pEnd = pRle->pRunData + pRle->pBlockOffset[next >> pRle->blockShift]
+                  + pRle->pGlyphOffset[next];
+  }
+}
+
+/**************************************************************************//**
+*  @brief
+*  Reads the next row of a char from the font pixel map.
+*  @param pRows
+*  Read position, set up by GLIB_charRowsInit()
+*  @return
+*  The pixels of the row, bit 0 is the leftmost pixel.
+******************************************************************************/
+static uint32_t GLIB_charRowsNext(GLIB_CharRows_t *pRows)
+{
+  const GLIB_FontRle_t *pRle;
+  uint32_t currentRow;
+  uint32_t run;
+  uint8_t i;
+
+  if (!(pRows->pFont->class & RleFontFlag)) {
+    switch (pRows->pFont->sizeOfMapElement) {
+      case 1:
+        currentRow = ((uint8_t *)pRows->pFont->pFontPixMap)[pRows->fontIdx];
+        break;
+
+      case 2:
+        currentRow = ((uint16_t *)pRows->pFont->pFontPixMap)[pRows->fontIdx];
+        break;
+
+      default:
+        currentRow = ((uint32_t *)pRows->pFont->pFontPixMap)[pRows->fontIdx];
+    }
 
     /* fontIdx offset for a new row */
-    fontIdx += pContext->font.fontRowOffset;
+    pRows->fontIdx += pRows->pFont->fontRowOffset;
+    return currentRow;
   }
-  return ((drawnElements == 0) ? GLIB_ERROR_NOTHING_TO_DRAW : GLIB_OK);
+
+  if (pRows->runLeft == 0) {
+    if (pRows->pRun >= pRows->pEnd) {
+      /* Blank rows at the bottom of the char are not stored */
+      return 0;
+    }
+
+    /* Read a little endian run */
+    pRle = (const GLIB_FontRle_t *)pRows->pFont->pFontPixMap;
+    run = pRows->pRun[0];
+    for (i = 1; i < pRle->runElementSize; i++) {
+      run |= (uint32_t)pRows->pRun[i] << (8 * i);
+    }
+    pRows->pRun += pRle->runElementSize;
+
+    if (pRle->valueBits < 32) {
+      pRows->runRow = (run & ((1UL << pRle->valueBits) - 1)) << pRle->columnShift;
+      pRows->runLeft = (run >> pRle->valueBits) + 1;
+    } else {
+      pRows->runRow = run;
+      pRows->runLeft = 1;
+    }
+  }
+
+  pRows->runLeft--;
+  return pRows->runRow;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Draws a char row by row, each row handed to the display driver as a bit
+*  mask of foreground and background pixels.
+*  @param pContext
+*  Pointer to the GLIB_Context_t
+*  @param fontIdx
+*  Index of the first row of the char in the font pixel map
+*  @param x
+*  Start x-coordinate for the char (Upper left corner)
+*  @param y
+*  Start y-coordinate for the char (Upper left corner)
+*  @param opaque
+*  Determines whether to show the background or color it with the background
+*  color specified by the GLIB_Context_t. If opaque == true, the background color is used.
+*  @return
+*  Returns GLIB_OK on success, or else error code
+******************************************************************************/
+static EMSTATUS GLIB_drawCharRows(GLIB_Context_t *pContext, uint16_t fontIdx,
+                                  int32_t x, int32_t y, bool opaque)
+{
+  EMSTATUS status;
+  uint32_t cellWidth = pContext->font.fontWidth + pContext->font.charSpacing;
+  uint32_t cellMask = (cellWidth == 32) ? 0xFFFFFFFF : ((1UL << cellWidth) - 1);
+  uint32_t glyphMask = (pContext->font.fontWidth == 32)
+                       ? 0xFFFFFFFF : ((1UL << pContext->font.fontWidth) - 1);
+  uint32_t clipMask = cellMask;
+  int32_t firstCol = pContext->clippingRegion.xMin - x;
+  int32_t lastCol = pContext->clippingRegion.xMax - x;
+  uint32_t currentRow;
+  uint32_t rowMask;
+  uint16_t row;
+  GLIB_CharRows_t rows;
+  uint8_t fgRed, fgGreen, fgBlue;
+  uint8_t bgRed, bgGreen, bgBlue;
+  bool drawn = false;
+
+  /* Columns of the char cell inside the clipping region */
+  if ((lastCol < 0) || (firstCol >= (int32_t)cellWidth)) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+  if (firstCol > 0) {
+    clipMask &= ~((1UL << firstCol) - 1);
+  } else {
+    firstCol = 0;
+  }
+  if (lastCol < (int32_t)cellWidth - 1) {
+    clipMask &= (1UL << (lastCol + 1)) - 1;
+  }
+
+  GLIB_colorTranslate24bpp(pContext->foregroundColor, &fgRed, &fgGreen, &fgBlue);
+  GLIB_colorTranslate24bpp(pContext->backgroundColor, &bgRed, &bgGreen, &bgBlue);
+
+  GLIB_charRowsInit(&rows, &pContext->font, fontIdx);
+
+  for (row = 0; row < pContext->font.fontHeight; row++) {
+    /* Rows are read in order, also the ones outside the clipping region */
+    currentRow = GLIB_charRowsNext(&rows) & glyphMask;
+
+    if ((y + row < pContext->clippingRegion.yMin)
+        || (y + row > pContext->clippingRegion.yMax)) {
+      continue;
+    }
+
+    /* Bit 1 means draw, Bit 0 means background */
+    rowMask = currentRow & clipMask;
+    if (rowMask) {
+      status = DMD_writeColorMask(x + firstCol, y + row, fgRed, fgGreen, fgBlue,
+                                  rowMask >> firstCol);
+      if (status != DMD_OK) {
+        return status;
+      }
+      drawn = true;
+    }
+
+    rowMask = opaque ? (~currentRow & clipMask) : 0;
+    if (rowMask) {
+      status = DMD_writeColorMask(x + firstCol, y + row, bgRed, bgGreen, bgBlue,
+                                  rowMask >> firstCol);
+      if (status != DMD_OK) {
+        return status;
+      }
+      drawn = true;
+    }
+  }
+  return (drawn ? GLIB_OK : GLIB_ERROR_NOTHING_TO_DRAW);
 }
 
 /**************************************************************************//**
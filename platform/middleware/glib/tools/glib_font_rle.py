@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""Convert a raw GLIB font source file to the run-length encoded format.
+
+Reads one of the glib_font_*.c files, encodes its glyphs as described for
+GLIB_FontRle_t in glib.h and prints the encoded font as a C source file.
+The encoded font is decoded again and compared against the raw font before
+anything is printed. Sizes go to stderr.
+
+Usage, from platform/middleware/glib:
+
+  python3 tools/glib_font_rle.py glib/glib_font_narrow_6x8.c \
+      > glib/glib_font_narrow_6x8_rle.c
+"""
+
+import os
+import re
+import sys
+
+# Largest log2 block size tried for the glyph offset tables
+MAX_BLOCK_SHIFT = 8
+
+HEADER = """\
+/***************************************************************************//**
+ * @file
+ * @brief {brief}, run-length encoded
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc.  Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.  This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* Generated from {source} by tools/glib_font_rle.py, do not edit. */
+
+/* Standard C header files */
+#include <stdint.h>
+#include "glib.h"
+"""
+
+
+class Font:
+    """Raw GLIB font parsed from its source file."""
+
+    def __init__(self, path):
+        text = open(path).read()
+        pixmap = re.search(r'static const uint(8|16|32)_t (\w+)\[\]\s*=\s*\{([^}]*)\}',
+                           text)
+        font = re.search(r'const GLIB_Font_t (\w+)\s*=\s*\{([^}]*)\}', text)
+        if pixmap is None or font is None:
+            raise ValueError('%s: no GLIB font found' % path)
+
+        self.element_size = int(pixmap.group(1)) // 8
+        self.pixmap = [int(v, 0) for v in re.findall(r'0x[0-9a-fA-F]+|\d+',
+                                                     pixmap.group(3))]
+        self.name = font.group(1)
+        brief = re.search(r'@brief (.*)', text)
+        self.brief = brief.group(1).strip() if brief else self.name
+        fields = [f.strip() for f in font.group(2).split(',')]
+        # pFontPixMap, cntOfMapElements, sizeOfMapElement, fontRowOffset,
+        # fontWidth, fontHeight, lineSpacing, charSpacing, class
+        (self.row_offset, self.width, self.height, self.line_spacing,
+         self.char_spacing) = [int(f, 0) for f in fields[3:8]]
+        self.font_class = fields[8]
+        if self.font_class not in ('FullFont', 'NumbersOnlyFont'):
+            raise ValueError('%s: font class %s not supported' % (path, self.font_class))
+
+        # Glyphs GLIB_drawChar can reach
+        self.glyphs = self.row_offset
+        if self.font_class == 'FullFont':
+            self.glyphs = min(self.glyphs, ord('~') - ord(' ') + 1)
+
+    def row(self, glyph, row):
+        return self.pixmap[glyph + row * self.row_offset]
+
+    def raw_size(self):
+        return self.row_offset * self.height * self.element_size
+
+
+def encode(font):
+    """Returns the run data, glyph start offsets and the run format."""
+    used = 0
+    for glyph in range(font.glyphs):
+        for row in range(font.height):
+            used |= font.row(glyph, row)
+
+    # Drop the columns no glyph uses, on the right as well as on the left
+    column_shift = 0
+    while used and not used & 1:
+        used >>= 1
+        column_shift += 1
+    value_bits = max(used.bit_length(), 1)
+    element_size = (value_bits + 7) // 8
+    max_run = 1 << (8 * element_size - value_bits)
+
+    data = bytearray()
+    offsets = []
+    for glyph in range(font.glyphs):
+        offsets.append(len(data))
+
+        # Blank rows at the bottom are not stored
+        rows = font.height
+        while rows > 0 and font.row(glyph, rows - 1) == 0:
+            rows -= 1
+
+        row = 0
+        while row < rows:
+            value = font.row(glyph, row)
+            run = 1
+            while row + run < rows and run < max_run and font.row(glyph, row + run) == value:
+                run += 1
+            element = (value >> column_shift) | ((run - 1) << value_bits)
+            data += element.to_bytes(element_size, 'little')
+            row += run
+    offsets.append(len(data))
+
+    return data, offsets, element_size, value_bits, column_shift
+
+
+def offset_tables(offsets):
+    """Returns the block shift, block offsets and glyph offsets with the
+    smallest size, the glyph offsets have to fit in a byte."""
+    best = None
+    for shift in range(MAX_BLOCK_SHIFT + 1):
+        blocks = [offsets[i] for i in range(0, len(offsets), 1 << shift)]
+        glyphs = [offsets[i] - blocks[i >> shift] for i in range(len(offsets))]
+        if max(glyphs) > 0xff:
+            continue
+        size = len(glyphs) + 2 * len(blocks)
+        if best is None or size < best[0]:
+            best = (size, shift, blocks, glyphs)
+    if best is None:
+        raise ValueError('glyphs too large for the offset tables')
+    return best[1:]
+
+
+def decode_row(data, start, end, element_size, value_bits, column_shift, row):
+    """Decodes a glyph row the way GLIB_drawChar does."""
+    pos = start
+    while pos < end:
+        element = int.from_bytes(data[pos:pos + element_size], 'little')
+        pos += element_size
+        run = (element >> value_bits) + 1
+        if row < run:
+            return (element & ((1 << value_bits) - 1)) << column_shift
+        row -= run
+    return 0
+
+
+def c_list(values, fmt):
+    lines = []
+    for i in range(0, len(values), 12):
+        lines.append('  ' + ', '.join(fmt % v for v in values[i:i + 12]))
+    return ',\n'.join(lines)
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write(__doc__)
+        return 1
+
+    path = sys.argv[1]
+    font = Font(path)
+    data, offsets, element_size, value_bits, column_shift = encode(font)
+    shift, blocks, glyph_offsets = offset_tables(offsets)
+
+    for glyph in range(font.glyphs):
+        start = blocks[glyph >> shift] + glyph_offsets[glyph]
+        end = blocks[(glyph + 1) >> shift] + glyph_offsets[glyph + 1]
+        for row in range(font.height):
+            if decode_row(data, start, end, element_size, value_bits,
+                          column_shift, row) != font.row(glyph, row):
+                raise ValueError('glyph %d row %d does not match' % (glyph, row))
+
+    raw_size = font.raw_size()
+    rle_size = len(data) + len(glyph_offsets) + 2 * len(blocks)
+    sys.stderr.write('%s: %d bytes raw, %d bytes RLE (%d runs, %d offsets), %d%% saved\n'
+                     % (font.name, raw_size, rle_size, len(data), rle_size - len(data),
+                        100 - 100 * rle_size // raw_size))
+
+    name = font.name + 'Rle'
+    declaration = 'const GLIB_Font_t %s = { ' % name
+    rle_class = 'FullFontRle' if font.font_class == 'FullFont' else 'NumbersOnlyFontRle'
+
+    out = [HEADER.format(brief=font.brief, source=os.path.basename(path))]
+    out.append('/** @brief Runs of the "%s" font. */\n'
+               'static const uint8_t %sRuns[] =\n{\n%s\n};\n'
+               % (name, name, c_list(data, '0x%02x')))
+    out.append('/** @brief Offset of every %d. glyph in the runs. */\n'
+               'static const uint16_t %sBlocks[] =\n{\n%s\n};\n'
+               % (1 << shift, name, c_list(blocks, '%d')))
+    out.append('/** @brief Offset of each glyph from the offset of its block. */\n'
+               'static const uint8_t %sGlyphs[] =\n{\n%s\n};\n'
+               % (name, c_list(glyph_offsets, '0x%02x')))
+    out.append('/** @brief Pixel map of the "%s" font. */\n'
+               'static const GLIB_FontRle_t %sPixMap =\n'
+               '{ %sRuns, %sBlocks, %sGlyphs,\n  %d, %d, %d, %d };\n'
+               % (name, name, name, name, name, shift, element_size, value_bits,
+                  column_shift))
+    out.append('/**\n * @brief Run-length encoded version of %s.\n */\n'
+               '%s(void *)&%sPixMap,\n%s%d, %d, 0, %d, %d, %d, %d, %s };'
+               % (font.name, declaration, name, ' ' * len(declaration), font.glyphs,
+                  element_size, font.width, font.height, font.line_spacing,
+                  font.char_spacing, rle_class))
+    sys.stdout.write('\n'.join(out) + '\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
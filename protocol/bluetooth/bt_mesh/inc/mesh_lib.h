@@ -61,7 +61,9 @@ uint32_t mesh_lib_transition_time_to_ms(uint8_t transition_time);
  * @param generic_models Number of models on the device for which
  * event handlers will be registered; see
  * mesh_lib_generic_client_register_handler() and
- * mesh_lib_generic_server_register_handler()
+ * mesh_lib_generic_server_register_handler(); the handler lookup table
+ * is sized from this value, so registering more models than given here
+ * will fail
  *
  * @return bg_err_success on success; an error code otherwise
  */
@@ -21,13 +21,24 @@
 #include "mesh_device_properties.h"
 #include "mesh_sensor_model_capi_types.h"
 
+/** Length of one serialized Sensor Descriptor state */
+#define MESH_LIB_SENSOR_DESCRIPTOR_LEN    8
+/** Maximum number of Sensor Descriptors in one Sensor Server init command */
+#define MESH_LIB_SENSOR_DESCRIPTORS_MAX   ((256 - 3) / MESH_LIB_SENSOR_DESCRIPTOR_LEN)
+
 /**
  * @brief Sensor server init helper
  * @param elem_idx Index of the element containing the sensor server model
  * @param number_of_sensors Number of Sensor Descriptor states
  * @param descriptors Array of sensor_descriptor_t structs
  *
- * @return bg_err_success on success; an error code otherwise
+ * The descriptors are serialized directly into one command of at most
+ * MESH_LIB_SENSOR_DESCRIPTORS_MAX entries, the largest descriptor array
+ * the stack accepts in a single Sensor Server init.
+ *
+ * @return bg_err_success on success; bg_err_command_too_long if
+ *         number_of_sensors exceeds MESH_LIB_SENSOR_DESCRIPTORS_MAX;
+ *         an error code from the stack otherwise
  */
 errorcode_t mesh_lib_sensor_server_init(uint16_t elem_idx, uint8_t number_of_sensors, const sensor_descriptor_t *descriptors);
 
@@ -60,4 +71,54 @@ mesh_device_property_t mesh_sensor_data_from_buf (uint16_t property_id, const ui
  */
 errorcode_t mesh_lib_sensor_descriptors_from_buf(sensor_descriptor_t *descriptor, uint8_t *buf, int16_t input_len);
 
+/**
+ * @brief Convert possible error percentage to sensor descriptor tolerance
+ * @param error_percentage Possible error in percent, 0 to 100
+ *
+ * @return Tolerance value, 0 to 4095
+ */
+uint16_t error_percentage2tolerance_value(float error_percentage);
+
+/**
+ * @brief Convert sensor descriptor tolerance to possible error percentage
+ * @param tolerance Tolerance value, 0 to 4095
+ *
+ * @return Possible error in percent
+ */
+double tolerance_value2error_percentage(uint16_t tolerance);
+
+/**
+ * @brief Integer only variant of error_percentage2tolerance_value()
+ * @param error_centipercentage Possible error in hundredths of a percent,
+ * 0 to 10000
+ *
+ * @return Tolerance value, 0 to 4095
+ */
+uint16_t error_centipercentage2tolerance_value(uint16_t error_centipercentage);
+
+/**
+ * @brief Integer only variant of tolerance_value2error_percentage()
+ * @param tolerance Tolerance value, 0 to 4095
+ *
+ * @return Possible error in hundredths of a percent, rounded to nearest
+ */
+uint16_t tolerance_value2error_centipercentage(uint16_t tolerance);
+
+/**
+ * @brief Convert measurement period or update interval field to seconds
+ * @param mp Field value; values above 255 are treated as 255
+ *
+ * @return Time in whole seconds, 1.1 ^ (mp - 64) rounded down
+ */
+uint32_t time_exp_to_seconds(uint32_t mp);
+
+/**
+ * @brief Convert seconds to measurement period or update interval field
+ * @param seconds Time in seconds
+ *
+ * @return Largest field value whose period does not exceed the given time,
+ * at most 255; zero seconds gives 0
+ */
+uint32_t seconds_to_time_exp(uint32_t seconds);
+
 #endif
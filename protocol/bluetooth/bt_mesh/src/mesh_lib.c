@@ -60,31 +60,72 @@ struct reg {
   };
 };
 
+/* Registrations are kept in an open addressing hash table keyed on
+   (model_id, elem_index) so that event dispatch does not have to scan
+   every registered model. The table has a power of two number of slots,
+   at least twice the number of models given to mesh_lib_init(), so that
+   linear probe sequences stay short. An all-zero slot is free. */
 static struct reg *reg = NULL;
 static size_t regs = 0;
+static size_t regs_used = 0;
+static size_t regs_max = 0;
 
 static void *(*lib_malloc_fn)(size_t) = NULL;
 static void (*lib_free_fn)(void *) = NULL;
 
-static struct reg *find_reg(uint16_t model_id,
-                            uint16_t elem_index)
+static size_t reg_hash(uint16_t model_id,
+                       uint16_t elem_index)
+{
+  uint32_t key = ((uint32_t)model_id << 16) | elem_index;
+  return (size_t)((uint32_t)(key * 2654435761UL) >> 16) & (regs - 1);
+}
+
+static int reg_is_free(const struct reg *r)
 {
-  size_t r;
-  for (r = 0; r < regs; r++) {
-    if (reg[r].model_id == model_id && reg[r].elem_index == elem_index) {
+  return r->model_id == 0x0000 && r->elem_index == 0x0000;
+}
+
+/* Return the slot holding the given key, or the free slot where it
+   would be inserted; NULL only if the table is full */
+static struct reg *find_slot(uint16_t model_id,
+                             uint16_t elem_index)
+{
+  size_t r, n;
+  if (!regs) {
+    return NULL;
+  }
+  r = reg_hash(model_id, elem_index);
+  for (n = 0; n < regs; n++) {
+    if (reg_is_free(&reg[r])
+        || (reg[r].model_id == model_id && reg[r].elem_index == elem_index)) {
       return &reg[r];
     }
+    r = (r + 1) & (regs - 1);
+  }
+  return NULL;
+}
+
+static struct reg *find_reg(uint16_t model_id,
+                            uint16_t elem_index)
+{
+  struct reg *r = find_slot(model_id, elem_index);
+  if (r && !reg_is_free(r)) {
+    return r;
   }
   return NULL;
 }
 
-static struct reg *find_free(void)
+static struct reg *find_free(uint16_t model_id,
+                             uint16_t elem_index)
 {
-  size_t r;
-  for (r = 0; r < regs; r++) {
-    if (reg[r].model_id == 0x0000 && reg[r].elem_index == 0x0000) {
-      return &reg[r];
-    }
+  struct reg *r;
+  if (regs_used >= regs_max) {
+    return NULL;
+  }
+  r = find_slot(model_id, elem_index);
+  if (r && reg_is_free(r)) {
+    regs_used++;
+    return r;
   }
   return NULL;
 }
@@ -97,12 +138,18 @@ errorcode_t mesh_lib_init(void *(*malloc_fn)(size_t),
   lib_free_fn = free_fn;
 
   if (generic_models) {
-    reg = (lib_malloc_fn)(generic_models * sizeof(struct reg));
+    size_t slots = 1;
+    while (slots < 2 * generic_models) {
+      slots <<= 1;
+    }
+    reg = (lib_malloc_fn)(slots * sizeof(struct reg));
     if (!reg) {
       return bg_err_out_of_memory;
     }
-    memset(reg, 0, generic_models * sizeof(struct reg));
-    regs = generic_models;
+    memset(reg, 0, slots * sizeof(struct reg));
+    regs = slots;
+    regs_used = 0;
+    regs_max = generic_models;
   }
 
   return bg_err_success;
@@ -114,6 +161,8 @@ void mesh_lib_deinit(void)
     (lib_free_fn)(reg);
     reg = NULL;
     regs = 0;
+    regs_used = 0;
+    regs_max = 0;
   }
 }
 
@@ -131,7 +180,7 @@ mesh_lib_generic_server_register_handler(uint16_t model_id,
     return bg_err_wrong_state; // already exists
   }
 
-  reg = find_free();
+  reg = find_free(model_id, elem_index);
   if (!reg) {
     return bg_err_out_of_memory;
   }
@@ -156,7 +205,7 @@ mesh_lib_generic_client_register_handler(uint16_t model_id,
     return bg_err_wrong_state; // already exists
   }
 
-  reg = find_free();
+  reg = find_free(model_id, elem_index);
   if (!reg) {
     return bg_err_out_of_memory;
   }
@@ -15,7 +15,7 @@
  *
  ******************************************************************************/
 #include "stdint.h"
-#include "math.h"
+#include "stddef.h"
 #include "bg_errorcodes.h"
 
 /* Select BGAPI flavor */
@@ -30,46 +30,13 @@
 #include "mesh_device_properties.h"
 #include "mesh_sensor_model_capi_types.h"
 
-/* int 8 */
-static int8_t int8_from_buf(const uint8_t *ptr)
-{
-  return (int8_t)ptr[0];
-}
-
-static void int8_to_buf(uint8_t *ptr, int8_t n)
-{
-  ptr[0] = n & 0xff;
-}
-
 /* uint 8 */
-static uint8_t uint8_from_buf(const uint8_t *ptr)
-{
-  return (uint8_t)ptr[0];
-}
-
 static void uint8_to_buf(uint8_t *ptr, uint8_t n)
 {
   ptr[0] = n & 0xff;
 }
 
-/* int16 */
-static int16_t int16_from_buf(const uint8_t *ptr)
-{
-  return ((int16_t)ptr[0]) | ((int16_t)ptr[1] << 8);
-}
-
-static void int16_to_buf(uint8_t *ptr, int16_t n)
-{
-  ptr[0] = n & 0xff;
-  ptr[1] = (n >> 8) & 0xff;
-}
-
 /* uint16 */
-static int16_t uint16_from_buf(const uint8_t *ptr)
-{
-  return ((int16_t)ptr[0]) | ((int16_t)ptr[1] << 8);
-}
-
 static void uint16_to_buf(uint8_t *ptr, uint16_t n)
 {
   ptr[0] = n & 0xff;
@@ -77,11 +44,6 @@ static void uint16_to_buf(uint8_t *ptr, uint16_t n)
 }
 
 /* uint 24 */
-static uint32_t uint24_from_buf(const uint8_t *ptr)
-{
-  return ((uint32_t)ptr[0]) | ((uint32_t)ptr[1] << 8) | ((uint32_t)ptr[2] << 16);
-}
-
 static void uint24_to_buf(uint8_t *ptr, int32_t n)
 {
   ptr[0] = n & 0xff;
@@ -89,568 +51,316 @@ static void uint24_to_buf(uint8_t *ptr, int32_t n)
   ptr[2] = (n >> 16) & 0xff;
 }
 
-#if 0
-/* int32 */
-static int32_t int32_from_buf(const uint8_t *ptr)
-{
-  return
-    ((int32_t)ptr[0])
-    | ((int32_t)ptr[1] << 8)
-    | ((int32_t)ptr[2] << 16)
-    | ((int32_t)ptr[3] << 24)
-  ;
-}
+/*
+ * Sensor data is encoded through a constant format table instead of a
+ * switch over every property ID. Device property IDs are contiguous from
+ * 0x0001, so the property ID indexes the format table directly; each
+ * format lists the fields of the property value in wire order with their
+ * offset and size in the value structure and their width on the wire.
+ * Signed and unsigned fields share the same little endian copy.
+ */
 
-static void int32_to_buf(uint8_t *ptr, int32_t n)
-{
-  ptr[0] = n & 0xff;
-  ptr[1] = (n >> 8) & 0xff;
-  ptr[2] = (n >> 16) & 0xff;
-  ptr[3] = (n >> 24) & 0xff;
-}
-#endif
-/* uint32 */
-static int32_t uint32_from_buf(const uint8_t *ptr)
-{
-  return
-    ((uint32_t)ptr[0])
-    | ((uint32_t)ptr[1] << 8)
-    | ((uint32_t)ptr[2] << 16)
-    | ((uint32_t)ptr[3] << 24)
-  ;
-}
+/** Maximum number of fields in a sensor property value */
+#define SENSOR_MAX_FIELDS 5
 
-static void uint32_to_buf(uint8_t *ptr, uint32_t n)
-{
-  ptr[0] = n & 0xff;
-  ptr[1] = (n >> 8) & 0xff;
-  ptr[2] = (n >> 16) & 0xff;
-  ptr[3] = (n >> 24) & 0xff;
-}
+typedef enum {
+  SENSOR_FORMAT_NONE = 0,
+  SENSOR_FORMAT_8,
+  SENSOR_FORMAT_16,
+  SENSOR_FORMAT_24,
+  SENSOR_FORMAT_32,
+  SENSOR_FORMAT_AVERAGE,
+  SENSOR_FORMAT_RANGE,
+  SENSOR_FORMAT_SPECIFICATION,
+  SENSOR_FORMAT_STATISTICS,
+  SENSOR_FORMAT_ENERGY_IN_A_PERIOD_OF_DAY,
+  SENSOR_FORMAT_EVENT_STATISTICS,
+  SENSOR_FORMAT_POWER_SPECIFICATION,
+  SENSOR_FORMAT_TEMPERATURE_8_IN_A_PERIOD_OF_DAY,
+  SENSOR_FORMAT_TEMPERATURE_8_STATISTICS,
+  SENSOR_FORMAT_COUNT
+} sensor_format_t;
 
-#if 0
-/* float 32 */
-static float float_from_buf(const uint8_t *ptr)
-{
-  uint32_t n =
-    ((uint32_t)ptr[0])
-    | ((uint32_t)ptr[1] << 8)
-    | ((uint32_t)ptr[2] << 16)
-    | ((uint32_t)ptr[3] << 24);
-  return (float)n;
-}
+struct sensor_field {
+  uint8_t offset; /**< Offset of the field in the value structure */
+  uint8_t size;   /**< Size of the field in memory: 1, 2 or 4 bytes */
+  uint8_t width;  /**< Width of the field on the wire */
+};
+
+struct sensor_format {
+  uint8_t len;                                  /**< Encoded value length */
+  uint8_t fields;                               /**< Number of fields */
+  struct sensor_field field[SENSOR_MAX_FIELDS]; /**< Fields in wire order */
+};
+
+#define SENSOR_F(type, member, width) \
+  { offsetof(type, member), sizeof(((type *)0)->member), width }
+
+static const struct sensor_format sensor_formats[SENSOR_FORMAT_COUNT] = {
+  [SENSOR_FORMAT_8] = { 1, 1, { { 0, 1, 1 } } },
+  [SENSOR_FORMAT_16] = { 2, 1, { { 0, 2, 2 } } },
+  [SENSOR_FORMAT_24] = { 3, 1, { { 0, 4, 3 } } },
+  [SENSOR_FORMAT_32] = { 4, 1, { { 0, 4, 4 } } },
+  [SENSOR_FORMAT_AVERAGE] =
+  { 3, 2, { SENSOR_F(average_current_t, current, 2),
+            SENSOR_F(average_current_t, duration, 1) } },
+  [SENSOR_FORMAT_RANGE] =
+  { 4, 2, { SENSOR_F(electric_current_range_t, minimum, 2),
+            SENSOR_F(electric_current_range_t, maximum, 2) } },
+  [SENSOR_FORMAT_SPECIFICATION] =
+  { 6, 3, { SENSOR_F(electric_current_specification_t, minimum, 2),
+            SENSOR_F(electric_current_specification_t, typical, 2),
+            SENSOR_F(electric_current_specification_t, maximum, 2) } },
+  [SENSOR_FORMAT_STATISTICS] =
+  { 9, 5, { SENSOR_F(electric_current_statistics_t, current, 2),
+            SENSOR_F(electric_current_statistics_t, std_deviation, 2),
+            SENSOR_F(electric_current_statistics_t, minimum, 2),
+            SENSOR_F(electric_current_statistics_t, maximum, 2),
+            SENSOR_F(electric_current_statistics_t, sensing_duration, 1) } },
+  [SENSOR_FORMAT_ENERGY_IN_A_PERIOD_OF_DAY] =
+  { 4, 3, { SENSOR_F(energy_in_a_period_of_day_t, energy, 2),
+            SENSOR_F(energy_in_a_period_of_day_t, start_time, 1),
+            SENSOR_F(energy_in_a_period_of_day_t, end_time, 1) } },
+  [SENSOR_FORMAT_EVENT_STATISTICS] =
+  { 6, 4, { SENSOR_F(event_statistics_t, number_of_events, 2),
+            SENSOR_F(event_statistics_t, average_event_duration, 2),
+            SENSOR_F(event_statistics_t, time_since_last_event, 1),
+            SENSOR_F(event_statistics_t, sensing_duration, 1) } },
+  [SENSOR_FORMAT_POWER_SPECIFICATION] =
+  { 9, 3, { SENSOR_F(power_specification_t, minimum_power_value, 3),
+            SENSOR_F(power_specification_t, typical_power_value, 3),
+            SENSOR_F(power_specification_t, maximum_power_value, 3) } },
+  [SENSOR_FORMAT_TEMPERATURE_8_IN_A_PERIOD_OF_DAY] =
+  { 3, 3, { SENSOR_F(temperature_8_in_a_period_of_day_t, temperature, 1),
+            SENSOR_F(temperature_8_in_a_period_of_day_t, start_time, 1),
+            SENSOR_F(temperature_8_in_a_period_of_day_t, end_time, 1) } },
+  [SENSOR_FORMAT_TEMPERATURE_8_STATISTICS] =
+  { 5, 5, { SENSOR_F(temperature_8_statistics_t, average, 1),
+            SENSOR_F(temperature_8_statistics_t, standard_deviation_value, 1),
+            SENSOR_F(temperature_8_statistics_t, minimum_value, 1),
+            SENSOR_F(temperature_8_statistics_t, maximum_value, 1),
+            SENSOR_F(temperature_8_statistics_t, sensing_duration, 1) } },
+};
 
-static void float_to_buf(uint8_t *ptr, float f)
+/* Formats indexed by property ID; properties without a format
+   (strings, appearance etc.) are not supported by the codec */
+static const uint8_t sensor_property_format[] = {
+  [AVERAGE_AMBIENT_TEMPERATURE_IN_A_PERIOD_OF_DAY] = SENSOR_FORMAT_TEMPERATURE_8_IN_A_PERIOD_OF_DAY,
+  [AVERAGE_INPUT_CURRENT] = SENSOR_FORMAT_AVERAGE,
+  [AVERAGE_INPUT_VOLTAGE] = SENSOR_FORMAT_AVERAGE,
+  [AVERAGE_OUTPUT_CURRENT] = SENSOR_FORMAT_AVERAGE,
+  [AVERAGE_OUTPUT_VOLTAGE] = SENSOR_FORMAT_AVERAGE,
+  [CENTER_BEAM_INTENSITY_AT_FULL_POWER] = SENSOR_FORMAT_16,
+  [COLOR_RENDERING_INDEX_R9] = SENSOR_FORMAT_8,
+  [COLOR_RENDERING_INDEX_RA] = SENSOR_FORMAT_8,
+  [DEVICE_COUNTRY_OF_ORIGIN] = SENSOR_FORMAT_16,
+  [DEVICE_DATE_OF_MANUFACTURE] = SENSOR_FORMAT_24,
+  [DEVICE_ENERGY_USE_SINCE_TURN_ON] = SENSOR_FORMAT_24,
+  [DEVICE_OPERATING_TEMPERATURE_RANGE_SPECIFICATION] = SENSOR_FORMAT_RANGE,
+  [DEVICE_OPERATING_TEMPERATURE_STATISTICAL_VALUES] = SENSOR_FORMAT_STATISTICS,
+  [DEVICE_OVER_TEMPERATURE_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [DEVICE_POWER_RANGE_SPECIFICATION] = SENSOR_FORMAT_POWER_SPECIFICATION,
+  [DEVICE_RUNTIME_SINCE_TURN_ON] = SENSOR_FORMAT_24,
+  [DEVICE_RUNTIME_WARRANTY] = SENSOR_FORMAT_24,
+  [DEVICE_UNDER_TEMPERATURE_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [INDOOR_AMBIENT_TEMPERATURE_STATISTICAL_VALUES] = SENSOR_FORMAT_TEMPERATURE_8_STATISTICS,
+  [INITIAL_CIE_1931_CHROMATICITY_COORDINATES] = SENSOR_FORMAT_RANGE,
+  [INITIAL_CORRELATED_COLOR_TEMPERATURE] = SENSOR_FORMAT_16,
+  [INITIAL_LUMINOUS_FLUX] = SENSOR_FORMAT_16,
+  [INITIAL_PLANCKIAN_DISTANCE] = SENSOR_FORMAT_16,
+  [INPUT_CURRENT_RANGE_SPECIFICATION] = SENSOR_FORMAT_SPECIFICATION,
+  [INPUT_CURRENT_STATISTICS] = SENSOR_FORMAT_STATISTICS,
+  [INPUT_OVER_CURRENT_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [INPUT_OVER_RIPPLE_VOLTAGE_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [INPUT_OVER_VOLTAGE_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [INPUT_UNDER_CURRENT_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [INPUT_UNDER_VOLTAGE_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [INPUT_VOLTAGE_RANGE_SPECIFICATION] = SENSOR_FORMAT_SPECIFICATION,
+  [INPUT_VOLTAGE_RIPPLE_SPECIFICATION] = SENSOR_FORMAT_8,
+  [INPUT_VOLTAGE_STATISTICS] = SENSOR_FORMAT_STATISTICS,
+  [LIGHT_CONTROL_AMBIENT_LUXLEVEL_ON] = SENSOR_FORMAT_24,
+  [LIGHT_CONTROL_AMBIENT_LUXLEVEL_PROLONG] = SENSOR_FORMAT_24,
+  [LIGHT_CONTROL_AMBIENT_LUXLEVEL_STANDBY] = SENSOR_FORMAT_24,
+  [LIGHT_CONTROL_LIGHTNESS_ON] = SENSOR_FORMAT_16,
+  [LIGHT_CONTROL_LIGHTNESS_PROLONG] = SENSOR_FORMAT_16,
+  [LIGHT_CONTROL_LIGHTNESS_STANDBY] = SENSOR_FORMAT_16,
+  [LIGHT_CONTROL_REGULATOR_ACCURACY] = SENSOR_FORMAT_8,
+  [LIGHT_CONTROL_REGULATOR_KID] = SENSOR_FORMAT_32,
+  [LIGHT_CONTROL_REGULATOR_KIU] = SENSOR_FORMAT_32,
+  [LIGHT_CONTROL_REGULATOR_KPD] = SENSOR_FORMAT_32,
+  [LIGHT_CONTROL_REGULATOR_KPU] = SENSOR_FORMAT_32,
+  [LIGHT_CONTROL_TIME_FADE] = SENSOR_FORMAT_24,
+  [LIGHT_CONTROL_TIME_FADE_ON] = SENSOR_FORMAT_24,
+  [LIGHT_CONTROL_TIME_FADE_STANDBY_AUTO] = SENSOR_FORMAT_24,
+  [LIGHT_CONTROL_TIME_FADE_STANDBY_MANUAL] = SENSOR_FORMAT_24,
+  [LIGHT_CONTROL_TIME_OCCUPANCY_DELAY] = SENSOR_FORMAT_24,
+  [LIGHT_CONTROL_TIME_PROLONG] = SENSOR_FORMAT_24,
+  [LIGHT_CONTROL_TIME_RUN_ON] = SENSOR_FORMAT_24,
+  [LUMEN_MAINTENANCE_FACTOR] = SENSOR_FORMAT_8,
+  [LUMINOUS_ENERGY_SINCE_TURN_ON] = SENSOR_FORMAT_24,
+  [MOTION_SENSED] = SENSOR_FORMAT_8,
+  [MOTION_THRESHOLD] = SENSOR_FORMAT_8,
+  [OPEN_CIRCUIT_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [OUTDOOR_STATISTICAL_VALUES] = SENSOR_FORMAT_TEMPERATURE_8_STATISTICS,
+  [OUTPUT_CURRENT_RANGE] = SENSOR_FORMAT_RANGE,
+  [OUTPUT_CURRENT_STATISTICS] = SENSOR_FORMAT_STATISTICS,
+  [OUTPUT_RIPPLE_VOLTAGE_SPECIFICATION] = SENSOR_FORMAT_8,
+  [OUTPUT_VOLTAGE_RANGE] = SENSOR_FORMAT_SPECIFICATION,
+  [OUTPUT_VOLTAGE_STATISTICS] = SENSOR_FORMAT_STATISTICS,
+  [OVER_OUTPUT_RIPPLE_VOLTAGE_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [PEOPLE_COUNT] = SENSOR_FORMAT_16,
+  [PRESENCE_DETECTED] = SENSOR_FORMAT_8,
+  [PRESENT_AMBIENT_LIGHT_LEVEL] = SENSOR_FORMAT_24,
+  [PRESENT_AMBIENT_TEMPERATURE] = SENSOR_FORMAT_8,
+  [PRESENT_CIE_1931_CHROMATICITY_COORDINATES] = SENSOR_FORMAT_RANGE,
+  [PRESENT_CORRELATED_COLOR_TEMPERATURE] = SENSOR_FORMAT_16,
+  [PRESENT_DEVICE_INPUT_POWER] = SENSOR_FORMAT_24,
+  [PRESENT_DEVICE_OPERATING_EFFICIENCY] = SENSOR_FORMAT_8,
+  [PRESENT_DEVICE_OPERATING_TEMPERATURE] = SENSOR_FORMAT_16,
+  [PRESENT_ILLUMINANCE] = SENSOR_FORMAT_24,
+  [PRESENT_INDOOR_AMBIENT_TEMPERATURE] = SENSOR_FORMAT_8,
+  [PRESENT_INPUT_CURRENT] = SENSOR_FORMAT_16,
+  [PRESENT_INPUT_RIPPLE_VOLTAGE] = SENSOR_FORMAT_8,
+  [PRESENT_INPUT_VOLTAGE] = SENSOR_FORMAT_16,
+  [PRESENT_LUMINOUS_FLUX] = SENSOR_FORMAT_16,
+  [PRESENT_OUTDOOR_AMBIENT_TEMPERATURE] = SENSOR_FORMAT_8,
+  [PRESENT_OUTPUT_CURRENT] = SENSOR_FORMAT_16,
+  [PRESENT_OUTPUT_VOLTAGE] = SENSOR_FORMAT_16,
+  [PRESENT_PLANCKIAN_DISTANCE] = SENSOR_FORMAT_16,
+  [PRESENT_RELATIVE_OUTPUT_RIPPLE_VOLTAGE] = SENSOR_FORMAT_8,
+  [RELATIVE_DEVICE_ENERGY_USE_IN_A_PERIOD_OF_DAY] = SENSOR_FORMAT_ENERGY_IN_A_PERIOD_OF_DAY,
+  [RELATIVE_RUNTIME_IN_A_CORRELATED_COLOR_TEMPERATURE_RANGE] = SENSOR_FORMAT_24,
+  [SHORT_CIRCUIT_EVENT_STATISTICS] = SENSOR_FORMAT_EVENT_STATISTICS,
+  [TIME_SINCE_MOTION_SENSED] = SENSOR_FORMAT_16,
+  [TIME_SINCE_PRESENCE_DETECTED] = SENSOR_FORMAT_16,
+  [TOTAL_DEVICE_ENERGY_USE] = SENSOR_FORMAT_24,
+  [TOTAL_DEVICE_OFF_ON_CYCLES] = SENSOR_FORMAT_24,
+  [TOTAL_DEVICE_POWER_ON_CYCLES] = SENSOR_FORMAT_24,
+  [TOTAL_DEVICE_POWER_ON_TIME] = SENSOR_FORMAT_24,
+  [TOTAL_DEVICE_RUNTIME] = SENSOR_FORMAT_24,
+  [TOTAL_LIGHT_EXPOSURE_TIME] = SENSOR_FORMAT_24,
+  [TOTAL_LUMINOUS_ENERGY] = SENSOR_FORMAT_24,
+  [CHROMATICITY_TOLERANCE] = SENSOR_FORMAT_8,
+  [LUMINOUS_EFFICACY] = SENSOR_FORMAT_16,
+  [LUMINOUS_EXPOSURE] = SENSOR_FORMAT_24,
+};
+
+static const struct sensor_format *sensor_format_find(uint16_t property_id)
 {
-  uint32_t n = (uint32_t)f;
-  ptr[0] = n & 0xff;
-  ptr[1] = (n >> 8) & 0xff;
-  ptr[2] = (n >> 16) & 0xff;
-  ptr[3] = (n >> 24) & 0xff;
+  uint8_t format;
+  if (property_id >= sizeof(sensor_property_format)) {
+    return NULL;
+  }
+  format = sensor_property_format[property_id];
+  if (format == SENSOR_FORMAT_NONE) {
+    return NULL;
+  }
+  return &sensor_formats[format];
 }
-#endif
 
 uint8_t mesh_sensor_data_to_buf(uint16_t property_id, uint8_t *ptr, uint8_t *value)
 {
-  int ret = 2; // Initial length is the length of the property ID
+  const struct sensor_format *format = sensor_format_find(property_id);
+  uint8_t f, b;
+
+  if (!format) {
+    // Property ID has not been recognized, nothing is written
+    return 0;
+  }
+
   uint16_to_buf(ptr, property_id);
-  ptr += 2;
-
-  switch (property_id) {
-    case PRESENT_AMBIENT_TEMPERATURE:
-    case PRESENT_INDOOR_AMBIENT_TEMPERATURE:
-    case PRESENT_OUTDOOR_AMBIENT_TEMPERATURE:
-    case COLOR_RENDERING_INDEX_R9:
-    case COLOR_RENDERING_INDEX_RA:
-    {
-      uint8_to_buf(ptr++, 1);
-      int8_to_buf(ptr, *(int8_t*)value);
-      ret += 2;
-    } break;
-    case PRESENCE_DETECTED:
-    case CHROMATICITY_TOLERANCE:
-    case INPUT_VOLTAGE_RIPPLE_SPECIFICATION:
-    case LIGHT_CONTROL_REGULATOR_ACCURACY:
-    case LUMEN_MAINTENANCE_FACTOR:
-    case MOTION_SENSED:
-    case MOTION_THRESHOLD:
-    case OUTPUT_RIPPLE_VOLTAGE_SPECIFICATION:
-    case PRESENT_DEVICE_OPERATING_EFFICIENCY:
-    case PRESENT_INPUT_RIPPLE_VOLTAGE:
-    case PRESENT_RELATIVE_OUTPUT_RIPPLE_VOLTAGE:
-    {
-      uint8_to_buf(ptr++, 1);
-      uint8_to_buf(ptr++, *(uint8_t*)value);
-      ret += 2;
-    } break;
-    case INITIAL_PLANCKIAN_DISTANCE:
-    case PRESENT_PLANCKIAN_DISTANCE:
-    {
-      uint8_to_buf(ptr++, 2);
-      int16_to_buf(ptr, *(int16_t*)value);
-      ret += 3;
-    } break;
-    case INITIAL_CORRELATED_COLOR_TEMPERATURE:
-    case PRESENT_CORRELATED_COLOR_TEMPERATURE:
-    case PEOPLE_COUNT:
-    case DEVICE_COUNTRY_OF_ORIGIN:
-    case PRESENT_INPUT_CURRENT:
-    case PRESENT_OUTPUT_CURRENT:
-    case LUMINOUS_EFFICACY:
-    case INITIAL_LUMINOUS_FLUX:
-    case PRESENT_LUMINOUS_FLUX:
-    case CENTER_BEAM_INTENSITY_AT_FULL_POWER:
-    case LIGHT_CONTROL_LIGHTNESS_ON:
-    case LIGHT_CONTROL_LIGHTNESS_PROLONG:
-    case LIGHT_CONTROL_LIGHTNESS_STANDBY:
-    case PRESENT_DEVICE_OPERATING_TEMPERATURE:
-    case TIME_SINCE_MOTION_SENSED:
-    case TIME_SINCE_PRESENCE_DETECTED:
-    case PRESENT_INPUT_VOLTAGE:
-    case PRESENT_OUTPUT_VOLTAGE:
-    {
-      uint8_to_buf(ptr++, 2);
-      uint16_to_buf(ptr, *(uint16_t*)value);
-      ret += 3;
-    } break;
-    /** 24-bit values */
-    case TOTAL_DEVICE_OFF_ON_CYCLES:
-    case TOTAL_DEVICE_POWER_ON_CYCLES:
-    case DEVICE_DATE_OF_MANUFACTURE:
-    case DEVICE_ENERGY_USE_SINCE_TURN_ON:
-    case TOTAL_DEVICE_ENERGY_USE:
-    case DEVICE_RUNTIME_SINCE_TURN_ON:
-    case DEVICE_RUNTIME_WARRANTY:
-    case TOTAL_DEVICE_POWER_ON_TIME:
-    case TOTAL_DEVICE_RUNTIME:
-    case TOTAL_LIGHT_EXPOSURE_TIME:
-    case LIGHT_CONTROL_AMBIENT_LUXLEVEL_ON:
-    case LIGHT_CONTROL_AMBIENT_LUXLEVEL_PROLONG:
-    case LIGHT_CONTROL_AMBIENT_LUXLEVEL_STANDBY:
-    case LUMINOUS_ENERGY_SINCE_TURN_ON:
-    case RELATIVE_RUNTIME_IN_A_CORRELATED_COLOR_TEMPERATURE_RANGE:
-    case TOTAL_LUMINOUS_ENERGY:
-    case LUMINOUS_EXPOSURE:
-    case PRESENT_DEVICE_INPUT_POWER:
-    case LIGHT_CONTROL_TIME_FADE:
-    case LIGHT_CONTROL_TIME_FADE_ON:
-    case LIGHT_CONTROL_TIME_FADE_STANDBY_AUTO:
-    case LIGHT_CONTROL_TIME_FADE_STANDBY_MANUAL:
-    case LIGHT_CONTROL_TIME_OCCUPANCY_DELAY: \
-    case LIGHT_CONTROL_TIME_PROLONG:
-    case LIGHT_CONTROL_TIME_RUN_ON:
-    case PRESENT_AMBIENT_LIGHT_LEVEL:
-    case PRESENT_ILLUMINANCE:
-    {
-      uint8_to_buf(ptr++, 3);
-      uint24_to_buf(ptr, *(uint32_t*)value);
-      ret += 4;
-    } break;
-    /* 32-bit*/
-    case LIGHT_CONTROL_REGULATOR_KID:
-    case LIGHT_CONTROL_REGULATOR_KIU:
-    case LIGHT_CONTROL_REGULATOR_KPD:
-    case LIGHT_CONTROL_REGULATOR_KPU:
-    {
-      uint8_to_buf(ptr++, 4);
-      uint32_to_buf(ptr, *(uint32_t*)value);
-      ret += 5;
-    } break;
-    /* Average Current */
-    case AVERAGE_INPUT_CURRENT:
-    case AVERAGE_OUTPUT_CURRENT:
-    {
-      uint8_to_buf(ptr++, 3);
-      average_current_t *ac = (average_current_t*)value;
-      uint16_to_buf(ptr, ac->current);
-      uint8_to_buf(ptr + 2, ac->duration);
-      ret += 4;
-    } break;
-    /* Average Voltage */
-    case AVERAGE_INPUT_VOLTAGE:
-    case AVERAGE_OUTPUT_VOLTAGE:
-    {
-      uint8_to_buf(ptr++, 3);
-      average_voltage_t *av = (average_voltage_t*)value;
-      uint16_to_buf(ptr, av->voltage);
-      uint8_to_buf(ptr + 2, av->duration);
-      ret += 4;
-    } break;
-    /* Chromaticity Coordinates */
-    case INITIAL_CIE_1931_CHROMATICITY_COORDINATES:
-    case PRESENT_CIE_1931_CHROMATICITY_COORDINATES:
-    {
-      uint8_to_buf(ptr++, 4);
-      chromaticity_coordinates_t *cc = (chromaticity_coordinates_t*)value;
-      uint16_to_buf(ptr, cc->x);
-      uint16_to_buf(ptr + 2, cc->y);
-      ret += 5;
-    } break;
-    /* Electric Current Range */
-    case OUTPUT_CURRENT_RANGE:
-    {
-      uint8_to_buf(ptr++, 4);
-      electric_current_range_t *range = (electric_current_range_t*)value;
-      uint16_to_buf(ptr, range->minimum);
-      uint16_to_buf(ptr + 2, range->maximum);
-      ret += 5;
-    } break;
-    case INPUT_CURRENT_RANGE_SPECIFICATION:
-    {
-      uint8_to_buf(ptr++, 6);
-      electric_current_specification_t *spec = (electric_current_specification_t*)value;
-      uint16_to_buf(ptr, spec->minimum);
-      uint16_to_buf(ptr + 2, spec->typical);
-      uint16_to_buf(ptr + 4, spec->maximum);
-      ret += 7;
-    } break;
-    case INPUT_CURRENT_STATISTICS:
-    case OUTPUT_CURRENT_STATISTICS:
-    {
-      uint8_to_buf(ptr++, 9);
-      electric_current_statistics_t *stat = (electric_current_statistics_t*)value;
-      uint16_to_buf(ptr, stat->current);
-      uint16_to_buf(ptr + 2, stat->std_deviation);
-      uint16_to_buf(ptr + 4, stat->minimum);
-      uint16_to_buf(ptr + 6, stat->maximum);
-      uint8_to_buf(ptr + 8, stat->sensing_duration);
-      ret += 10;
-    } break;
-    case RELATIVE_DEVICE_ENERGY_USE_IN_A_PERIOD_OF_DAY:
-    {
-      uint8_to_buf(ptr++, 4);
-      energy_in_a_period_of_day_t *e = (energy_in_a_period_of_day_t*)value;
-      uint16_to_buf(ptr, e->energy);
-      uint8_to_buf(ptr + 2, e->start_time);
-      uint8_to_buf(ptr + 3, e->end_time);
-      ret += 5;
-    } break;
-    case DEVICE_OVER_TEMPERATURE_EVENT_STATISTICS:
-    case DEVICE_UNDER_TEMPERATURE_EVENT_STATISTICS:
-    case INPUT_OVER_CURRENT_EVENT_STATISTICS:
-    case INPUT_OVER_RIPPLE_VOLTAGE_EVENT_STATISTICS:
-    case INPUT_OVER_VOLTAGE_EVENT_STATISTICS:
-    case INPUT_UNDER_CURRENT_EVENT_STATISTICS:
-    case INPUT_UNDER_VOLTAGE_EVENT_STATISTICS:
-    case OPEN_CIRCUIT_EVENT_STATISTICS:
-    case OVER_OUTPUT_RIPPLE_VOLTAGE_EVENT_STATISTICS:
-    case SHORT_CIRCUIT_EVENT_STATISTICS:
-    {
-      uint8_to_buf(ptr++, 6);
-      event_statistics_t *stat = (event_statistics_t*)value;
-      uint16_to_buf(ptr, stat->number_of_events);
-      uint16_to_buf(ptr + 2, stat->average_event_duration);
-      uint8_to_buf(ptr + 4, stat->time_since_last_event);
-      uint8_to_buf(ptr + 5, stat->sensing_duration);
-      ret += 7;
-    } break;
-    case DEVICE_POWER_RANGE_SPECIFICATION:
-    {
-      uint8_to_buf(ptr++, 9);
-      power_specification_t *spec = (power_specification_t*)value;
-      uint24_to_buf(ptr, spec->minimum_power_value);
-      uint24_to_buf(ptr + 3, spec->typical_power_value);
-      uint24_to_buf(ptr + 6, spec->maximum_power_value);
-      ret += 10;
-    } break;
-    case AVERAGE_AMBIENT_TEMPERATURE_IN_A_PERIOD_OF_DAY:
-    {
-      uint8_to_buf(ptr++, 3);
-      temperature_8_in_a_period_of_day_t *t = (temperature_8_in_a_period_of_day_t*)value;
-      uint8_to_buf(ptr, t->temperature);
-      uint8_to_buf(ptr + 1, t->start_time);
-      uint8_to_buf(ptr + 2, t->end_time);
-      ret += 4;
-    } break;
-    case INDOOR_AMBIENT_TEMPERATURE_STATISTICAL_VALUES:
-    case OUTDOOR_STATISTICAL_VALUES:
-    {
-      uint8_to_buf(ptr++, 5);
-      temperature_8_statistics_t *stat = (temperature_8_statistics_t*)value;
-      uint8_to_buf(ptr, stat->average);
-      uint8_to_buf(ptr + 1, stat->standard_deviation_value);
-      uint8_to_buf(ptr + 2, stat->minimum_value);
-      uint8_to_buf(ptr + 3, stat->minimum_value);
-      uint8_to_buf(ptr + 4, stat->sensing_duration);
-      ret += 6;
-    } break;
-    case DEVICE_OPERATING_TEMPERATURE_RANGE_SPECIFICATION:
-    {
-      uint8_to_buf(ptr++, 4);
-      temperature_range_t *r = (temperature_range_t*)value;
-      uint16_to_buf(ptr, r->minimum);
-      uint16_to_buf(ptr, r->maximum);
-      ret += 5;
-    } break;
-    case DEVICE_OPERATING_TEMPERATURE_STATISTICAL_VALUES:
-    {
-      uint8_to_buf(ptr++, 9);
-      temperature_statistics_t *stat = (temperature_statistics_t*)value;
-      uint16_to_buf(ptr, stat->average);
-      uint16_to_buf(ptr + 2, stat->standard_deviation);
-      uint16_to_buf(ptr + 4, stat->minimum);
-      uint16_to_buf(ptr + 6, stat->maximum);
-      uint8_to_buf(ptr + 8, stat->duration);
-      ret += 10;
-    } break;
-    case INPUT_VOLTAGE_RANGE_SPECIFICATION:
-    case OUTPUT_VOLTAGE_RANGE:
-    {
-      uint8_to_buf(ptr++, 6);
-      voltage_specification_t *v = (voltage_specification_t*)value;
-      uint16_to_buf(ptr, v->minimum);
-      uint16_to_buf(ptr + 2, v->typical);
-      uint16_to_buf(ptr + 4, v->maximum);
-      ret += 7;
-    } break;
-    case INPUT_VOLTAGE_STATISTICS:
-    case OUTPUT_VOLTAGE_STATISTICS:
-    {
-      uint8_to_buf(ptr++, 9);
-      voltage_statistics_t *stat = (voltage_statistics_t*)value;
-      uint16_to_buf(ptr, stat->average);
-      uint16_to_buf(ptr + 2, stat->standard_deviation);
-      uint16_to_buf(ptr + 4, stat->minimum);
-      uint16_to_buf(ptr + 6, stat->maximum);
-      uint8_to_buf(ptr + 8, stat->duration);
-      ret += 10;
-    } break;
-    default:
-      // If Property ID has not been recognized, roll back the length and the pointer
-      ret -= 2;
-      ptr -= 2;
-      break;
+  uint8_to_buf(ptr + 2, format->len);
+  ptr += 3;
+
+  for (f = 0; f < format->fields; f++) {
+    const struct sensor_field *field = &format->field[f];
+    const uint8_t *src = value + field->offset;
+    uint32_t n;
+
+    switch (field->size) {
+      case 1:
+        n = *src;
+        break;
+      case 2:
+        n = *(const uint16_t *)src;
+        break;
+      default:
+        n = *(const uint32_t *)src;
+        break;
+    }
+    for (b = 0; b < field->width; b++) {
+      *ptr++ = (n >> (8 * b)) & 0xff;
+    }
   }
-  return ret;
+
+  return 3 + format->len;
 }
 
 mesh_device_property_t mesh_sensor_data_from_buf(uint16_t property_id, const uint8_t *ptr)
 {
   mesh_device_property_t property = { 0 };
-  switch (property_id) {
-    case PRESENT_AMBIENT_TEMPERATURE:
-    case PRESENT_INDOOR_AMBIENT_TEMPERATURE:
-    case PRESENT_OUTDOOR_AMBIENT_TEMPERATURE:
-    case COLOR_RENDERING_INDEX_R9:
-    case COLOR_RENDERING_INDEX_RA:
-    {
-      property.int8 = int8_from_buf(ptr);
-    } break;
-    case PRESENCE_DETECTED:
-    case CHROMATICITY_TOLERANCE:
-    case INPUT_VOLTAGE_RIPPLE_SPECIFICATION:
-    case LIGHT_CONTROL_REGULATOR_ACCURACY:
-    case LUMEN_MAINTENANCE_FACTOR:
-    case MOTION_SENSED:
-    case MOTION_THRESHOLD:
-    case OUTPUT_RIPPLE_VOLTAGE_SPECIFICATION:
-    case PRESENT_DEVICE_OPERATING_EFFICIENCY:
-    case PRESENT_INPUT_RIPPLE_VOLTAGE:
-    case PRESENT_RELATIVE_OUTPUT_RIPPLE_VOLTAGE:
-    {
-      property.uint8 = uint8_from_buf(ptr);
-    } break;
-    case INITIAL_PLANCKIAN_DISTANCE:
-    case PRESENT_PLANCKIAN_DISTANCE:
-    {
-      property.int16 = int16_from_buf(ptr);
-    } break;
-    case INITIAL_CORRELATED_COLOR_TEMPERATURE:
-    case PRESENT_CORRELATED_COLOR_TEMPERATURE:
-    case PEOPLE_COUNT:
-    case DEVICE_COUNTRY_OF_ORIGIN:
-    case PRESENT_INPUT_CURRENT:
-    case PRESENT_OUTPUT_CURRENT:
-    case LUMINOUS_EFFICACY:
-    case INITIAL_LUMINOUS_FLUX:
-    case PRESENT_LUMINOUS_FLUX:
-    case CENTER_BEAM_INTENSITY_AT_FULL_POWER:
-    case LIGHT_CONTROL_LIGHTNESS_ON:
-    case LIGHT_CONTROL_LIGHTNESS_PROLONG:
-    case LIGHT_CONTROL_LIGHTNESS_STANDBY:
-    case PRESENT_DEVICE_OPERATING_TEMPERATURE:
-    case TIME_SINCE_MOTION_SENSED:
-    case TIME_SINCE_PRESENCE_DETECTED:
-    case PRESENT_INPUT_VOLTAGE:
-    case PRESENT_OUTPUT_VOLTAGE:
-    {
-      property.uint16 = uint16_from_buf(ptr);
-    } break;
-    /** 24-bit values */
-    case TOTAL_DEVICE_OFF_ON_CYCLES:
-    case TOTAL_DEVICE_POWER_ON_CYCLES:
-    case DEVICE_DATE_OF_MANUFACTURE:
-    case DEVICE_ENERGY_USE_SINCE_TURN_ON:
-    case TOTAL_DEVICE_ENERGY_USE:
-    case DEVICE_RUNTIME_SINCE_TURN_ON:
-    case DEVICE_RUNTIME_WARRANTY:
-    case TOTAL_DEVICE_POWER_ON_TIME:
-    case TOTAL_DEVICE_RUNTIME:
-    case TOTAL_LIGHT_EXPOSURE_TIME:
-    case LIGHT_CONTROL_AMBIENT_LUXLEVEL_ON:
-    case LIGHT_CONTROL_AMBIENT_LUXLEVEL_PROLONG:
-    case LIGHT_CONTROL_AMBIENT_LUXLEVEL_STANDBY:
-    case LUMINOUS_ENERGY_SINCE_TURN_ON:
-    case RELATIVE_RUNTIME_IN_A_CORRELATED_COLOR_TEMPERATURE_RANGE:
-    case TOTAL_LUMINOUS_ENERGY:
-    case LUMINOUS_EXPOSURE:
-    case PRESENT_DEVICE_INPUT_POWER:
-    case LIGHT_CONTROL_TIME_FADE:
-    case LIGHT_CONTROL_TIME_FADE_ON:
-    case LIGHT_CONTROL_TIME_FADE_STANDBY_AUTO:
-    case LIGHT_CONTROL_TIME_FADE_STANDBY_MANUAL:
-    case LIGHT_CONTROL_TIME_OCCUPANCY_DELAY: \
-    case LIGHT_CONTROL_TIME_PROLONG:
-    case LIGHT_CONTROL_TIME_RUN_ON:
-    case PRESENT_AMBIENT_LIGHT_LEVEL:
-    case PRESENT_ILLUMINANCE:
-    {
-      property.uint32 = uint24_from_buf(ptr);
-    } break;
-    /* 32-bit*/
-    case LIGHT_CONTROL_REGULATOR_KID:
-    case LIGHT_CONTROL_REGULATOR_KIU:
-    case LIGHT_CONTROL_REGULATOR_KPD:
-    case LIGHT_CONTROL_REGULATOR_KPU:
-    {
-      property.uint32 = uint32_from_buf(ptr);
-    } break;
-    /* Average Current */
-    case AVERAGE_INPUT_CURRENT:
-    case AVERAGE_OUTPUT_CURRENT:
-    {
-      property.average_current.current = uint16_from_buf(ptr);
-      property.average_current.duration = uint8_from_buf(ptr + 2);
-    } break;
-    /* Average Voltage */
-    case AVERAGE_INPUT_VOLTAGE:
-    case AVERAGE_OUTPUT_VOLTAGE:
-    {
-      property.average_voltage.voltage = uint16_from_buf(ptr);
-      property.average_voltage.duration = uint8_from_buf(ptr + 2);
-    } break;
-    /* Chromaticity Coordinates */
-    case INITIAL_CIE_1931_CHROMATICITY_COORDINATES:
-    case PRESENT_CIE_1931_CHROMATICITY_COORDINATES:
-    {
-      property.chromaticity_coordinates.x = uint16_from_buf(ptr);
-      property.chromaticity_coordinates.y = uint16_from_buf(ptr + 2);
-    } break;
-    /* Electric Current Range */
-    case OUTPUT_CURRENT_RANGE:
-    {
-      property.electric_current_range.minimum = uint16_from_buf(ptr);
-      property.electric_current_range.maximum = uint16_from_buf(ptr + 2);
-    } break;
-    case INPUT_CURRENT_RANGE_SPECIFICATION:
-    {
-      property.electric_current_specification.minimum = uint16_from_buf(ptr);
-      property.electric_current_specification.typical = uint16_from_buf(ptr + 2);
-      property.electric_current_specification.maximum = uint16_from_buf(ptr + 4);
-    } break;
-    case INPUT_CURRENT_STATISTICS:
-    case OUTPUT_CURRENT_STATISTICS:
-    {
-      property.electric_current_statistics.current = uint16_from_buf(ptr);
-      property.electric_current_statistics.std_deviation = uint16_from_buf(ptr + 2);
-      property.electric_current_statistics.minimum = uint16_from_buf(ptr + 4);
-      property.electric_current_statistics.maximum = uint16_from_buf(ptr + 6);
-      property.electric_current_statistics.sensing_duration = uint8_from_buf(ptr + 8);
-    } break;
-    case RELATIVE_DEVICE_ENERGY_USE_IN_A_PERIOD_OF_DAY:
-    {
-      property.energy_in_a_period_of_day.energy = uint16_from_buf(ptr);
-      property.energy_in_a_period_of_day.start_time = uint8_from_buf(ptr + 2);
-      property.energy_in_a_period_of_day.end_time = uint8_from_buf(ptr + 3);
-    } break;
-    case DEVICE_OVER_TEMPERATURE_EVENT_STATISTICS:
-    case DEVICE_UNDER_TEMPERATURE_EVENT_STATISTICS:
-    case INPUT_OVER_CURRENT_EVENT_STATISTICS:
-    case INPUT_OVER_RIPPLE_VOLTAGE_EVENT_STATISTICS:
-    case INPUT_OVER_VOLTAGE_EVENT_STATISTICS:
-    case INPUT_UNDER_CURRENT_EVENT_STATISTICS:
-    case INPUT_UNDER_VOLTAGE_EVENT_STATISTICS:
-    case OPEN_CIRCUIT_EVENT_STATISTICS:
-    case OVER_OUTPUT_RIPPLE_VOLTAGE_EVENT_STATISTICS:
-    case SHORT_CIRCUIT_EVENT_STATISTICS:
-    {
-      property.event_statistics.number_of_events = uint16_from_buf(ptr);
-      property.event_statistics.average_event_duration = uint16_from_buf(ptr + 2);
-      property.event_statistics.time_since_last_event = uint8_from_buf(ptr + 4);
-      property.event_statistics.sensing_duration = uint8_from_buf(ptr + 5);
-    } break;
-    case DEVICE_POWER_RANGE_SPECIFICATION:
-    {
-      property.power_specification.minimum_power_value = uint24_from_buf(ptr);
-      property.power_specification.typical_power_value = uint24_from_buf(ptr + 3);
-      property.power_specification.maximum_power_value = uint24_from_buf(ptr + 6);
-    } break;
-    case AVERAGE_AMBIENT_TEMPERATURE_IN_A_PERIOD_OF_DAY:
-    {
-      property.temperature_8_in_a_period_of_day.temperature = uint8_from_buf(ptr);
-      property.temperature_8_in_a_period_of_day.start_time = uint8_from_buf(ptr + 1);
-      property.temperature_8_in_a_period_of_day.end_time = uint8_from_buf(ptr + 2);
-    } break;
-    case INDOOR_AMBIENT_TEMPERATURE_STATISTICAL_VALUES:
-    case OUTDOOR_STATISTICAL_VALUES:
-    {
-      property.temperature_8_statistics.average = uint8_from_buf(ptr);
-      property.temperature_8_statistics.standard_deviation_value = uint8_from_buf(ptr + 1);
-      property.temperature_8_statistics.minimum_value = uint8_from_buf(ptr + 2);
-      property.temperature_8_statistics.maximum_value = uint8_from_buf(ptr + 3);
-      property.temperature_8_statistics.sensing_duration = uint8_from_buf(ptr + 4);
-    } break;
-    case DEVICE_OPERATING_TEMPERATURE_RANGE_SPECIFICATION:
-    {
-      property.temperature_range.minimum = uint16_from_buf(ptr);
-      property.temperature_range.maximum = uint16_from_buf(ptr + 2);
-    } break;
-    case DEVICE_OPERATING_TEMPERATURE_STATISTICAL_VALUES:
-    {
-      property.temperature_statistics.average = uint16_from_buf(ptr);
-      property.temperature_statistics.standard_deviation = uint16_from_buf(ptr + 2);
-      property.temperature_statistics.minimum = uint16_from_buf(ptr + 4);
-      property.temperature_statistics.maximum = uint16_from_buf(ptr + 6);
-      property.temperature_statistics.duration = uint8_from_buf(ptr + 8);
-    } break;
-    case INPUT_VOLTAGE_RANGE_SPECIFICATION:
-    case OUTPUT_VOLTAGE_RANGE:
-    {
-      property.voltage_specification.minimum = uint16_from_buf(ptr);
-      property.voltage_specification.typical = uint16_from_buf(ptr + 2);
-      property.voltage_specification.maximum = uint16_from_buf(ptr + 2);
-    } break;
-    case INPUT_VOLTAGE_STATISTICS:
-    case OUTPUT_VOLTAGE_STATISTICS:
-    {
-      property.voltage_statistics.average = uint16_from_buf(ptr);
-      property.voltage_statistics.standard_deviation = uint16_from_buf(ptr + 2);
-      property.voltage_statistics.minimum = uint16_from_buf(ptr + 4);
-      property.voltage_statistics.maximum = uint16_from_buf(ptr + 6);
-      property.voltage_statistics.duration = uint8_from_buf(ptr + 8);
-    } break;
-    default:
-      break;
+  const struct sensor_format *format = sensor_format_find(property_id);
+  uint8_t f, b;
+
+  if (!format) {
+    return property;
+  }
+
+  for (f = 0; f < format->fields; f++) {
+    const struct sensor_field *field = &format->field[f];
+    uint8_t *dst = (uint8_t *)&property + field->offset;
+    uint32_t n = 0;
+
+    for (b = 0; b < field->width; b++) {
+      n |= (uint32_t)(*ptr++) << (8 * b);
+    }
+    switch (field->size) {
+      case 1:
+        *dst = (uint8_t)n;
+        break;
+      case 2:
+        *(uint16_t *)dst = (uint16_t)n;
+        break;
+      default:
+        *(uint32_t *)dst = n;
+        break;
+    }
   }
   return property;
 }
 
+/** Serialize one Sensor Descriptor state into its 8 octet wire format */
+static uint8_t *sensor_descriptor_to_buf(uint8_t *ptr, const sensor_descriptor_t *d)
+{
+  uint32_t tolerance = (d->positive_tolerance & 0xfff) | ((uint32_t)(d->negative_tolerance & 0xfff) << 12);
+
+  uint16_to_buf(ptr, d->property_id);
+  uint24_to_buf(ptr + 2, tolerance);
+  uint8_to_buf(ptr + 5, d->sampling_function);
+  uint8_to_buf(ptr + 6, d->measurement_period);
+  uint8_to_buf(ptr + 7, d->update_interval);
+  return ptr + MESH_LIB_SENSOR_DESCRIPTOR_LEN;
+}
+
 errorcode_t mesh_lib_sensor_server_init(uint16_t elem_idx, uint8_t number_of_sensors, const sensor_descriptor_t *descriptors)
 {
-  uint8_t buf[128]; // temporary buffer allowing maximum 16 sensors for one element
-  for (int i = 0; i < number_of_sensors; i++) {
-    sensor_descriptor_t d = descriptors[i];
-    uint8_t *ptr = &buf[i * 8];
-
-    uint16_to_buf(ptr, d.property_id);
-    uint32_t tolerance = (d.positive_tolerance & 0xfff) | (d.negative_tolerance << 12);
-    uint24_to_buf(ptr + 2, tolerance);
-    uint8_to_buf(ptr + 5, d.sampling_function);
-    uint8_to_buf(ptr + 6, d.measurement_period);
-    uint8_to_buf(ptr + 7, d.update_interval);
+  // sized by the stack command limit rather than an arbitrary sensor count
+  uint8_t buf[MESH_LIB_SENSOR_DESCRIPTORS_MAX * MESH_LIB_SENSOR_DESCRIPTOR_LEN];
+  uint8_t *ptr = buf;
+  uint8_t i;
+
+  if (number_of_sensors > MESH_LIB_SENSOR_DESCRIPTORS_MAX) {
+    return bg_err_command_too_long;
   }
-  gecko_cmd_mesh_sensor_server_init(elem_idx, number_of_sensors * 8, buf);
-  return bg_err_success;
+  if (number_of_sensors > 0 && descriptors == NULL) {
+    return bg_err_invalid_param;
+  }
+  for (i = 0; i < number_of_sensors; i++) {
+    ptr = sensor_descriptor_to_buf(ptr, &descriptors[i]);
+  }
+  return gecko_cmd_mesh_sensor_server_init(elem_idx,
+                                           (uint8_t)(ptr - buf),
+                                           buf)->result;
 }
 
 errorcode_t mesh_lib_sensor_descriptors_from_buf(sensor_descriptor_t *descriptor, uint8_t *buf, int16_t input_len)
@@ -676,9 +386,9 @@ errorcode_t mesh_lib_sensor_descriptors_from_buf(sensor_descriptor_t *descriptor
 }
 
 /**
- * The following functions are to convert fields for the Sensor Descriptor
- * These are highly inefficient due to the fact that they require floating point calculations
- * and therefore probable better avoided by just pre-calculating the values since they are constants.
+ * The following functions are to convert fields for the Sensor Descriptor.
+ * They avoid floating point library calls: the time exponent conversions use
+ * a precomputed table and the tolerance conversions have integer variants.
  */
 
 /**
@@ -698,19 +408,103 @@ double tolerance_value2error_percentage(uint16_t tolerance)
   return (double)tolerance / 4095 * 100;
 }
 
+uint16_t error_centipercentage2tolerance_value(uint16_t error_centipercentage)
+{
+  if (error_centipercentage > 10000) {
+    error_centipercentage = 10000;
+  }
+  return (uint16_t)(((uint32_t)error_centipercentage * 4095) / 10000);
+}
+
+uint16_t tolerance_value2error_centipercentage(uint16_t tolerance)
+{
+  if (tolerance > 4095) {
+    tolerance = 4095;
+  }
+  return (uint16_t)(((uint32_t)tolerance * 10000 + 4095 / 2) / 4095);
+}
+
 /**
  * Converting Measurement Period or Update Interval values between seconds and the representation if the standard
  * The formula is:
  *  time period = 1.1 ^ (value - 64)
  *  and
  *  descriptor fields' value = (base 1.1 logarithm of time_period_in_seconds ) + 64
+ *
+ * The table holds floor(1.1 ^ (value - 64)) for every 8-bit field value,
+ * computed exactly; values below 64 represent periods under one second.
  */
+static const uint32_t time_exp_seconds[256] = {
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 1, 1,
+  1, 1, 1, 1, 1, 1,
+  2, 2, 2, 2, 3, 3,
+  3, 4, 4, 5, 5, 6,
+  6, 7, 8, 8, 9, 10,
+  11, 13, 14, 15, 17, 19,
+  21, 23, 25, 28, 30, 34,
+  37, 41, 45, 49, 54, 60,
+  66, 72, 80, 88, 97, 106,
+  117, 129, 142, 156, 171, 189,
+  207, 228, 251, 276, 304, 334,
+  368, 405, 445, 490, 539, 593,
+  652, 717, 789, 868, 955, 1051,
+  1156, 1271, 1399, 1538, 1692, 1862,
+  2048, 2253, 2478, 2726, 2999, 3298,
+  3628, 3991, 4390, 4830, 5313, 5844,
+  6428, 7071, 7778, 8556, 9412, 10353,
+  11388, 12527, 13780, 15158, 16674, 18341,
+  20176, 22193, 24413, 26854, 29539, 32493,
+  35743, 39317, 43249, 47574, 52331, 57565,
+  63321, 69653, 76619, 84280, 92709, 101979,
+  112177, 123395, 135735, 149308, 164239, 180663,
+  198730, 218603, 240463, 264509, 290960, 320056,
+  352062, 387268, 425995, 468595, 515454, 567000,
+  623700, 686070, 754677, 830145, 913159, 1004475,
+  1104923, 1215415, 1336956, 1470652, 1617717, 1779489,
+  1957438, 2153182, 2368500, 2605350, 2865885, 3152474,
+  3467721, 3814494, 4195943, 4615537, 5077091, 5584800,
+  6143280, 6757608, 7433369, 8176706, 8994377, 9893815,
+  10883196, 11971516, 13168667, 14485534, 15934088, 17527497,
+  19280246, 21208271, 23329098, 25662008, 28228209, 31051030,
+  34156133, 37571746, 41328921, 45461813, 50007994, 55008794,
+  60509673, 66560640, 73216704, 80538375
+};
+
 uint32_t time_exp_to_seconds(uint32_t mp)
 {
-  return (uint32_t)pow((double)1.1, mp - 64);
+  if (mp > 255) {
+    mp = 255;
+  }
+  return time_exp_seconds[mp];
 }
 
 uint32_t seconds_to_time_exp(uint32_t seconds)
 {
-  return (uint32_t)(log((double)seconds) / log((double)1.1) + 64);
+  uint32_t lo = 64;
+  uint32_t hi = 256;
+
+  if (seconds == 0) {
+    return 0;
+  }
+  /* 1.1 ^ k is never an integer for k > 0, so 1.1 ^ k <= seconds exactly
+     when floor(1.1 ^ k) < seconds; find the largest such field value */
+  while (hi - lo > 1) {
+    uint32_t mid = (lo + hi) / 2;
+    if (time_exp_seconds[mid] < seconds) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
 }
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include <stdint.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <errno.h>
 #include <string.h>
@@ -26,17 +27,6 @@
 #include "mesh_generic_model_capi_types.h"
 #include "mesh_serdeser.h"
 
-static int16_t int16_from_buf(const uint8_t *ptr)
-{
-  return ((int16_t)ptr[0]) | ((int16_t)ptr[1] << 8);
-}
-
-static void int16_to_buf(uint8_t *ptr, int16_t n)
-{
-  ptr[0] = n & 0xff;
-  ptr[1] = (n >> 8) & 0xff;
-}
-
 static uint16_t uint16_from_buf(const uint8_t *ptr)
 {
   return ((uint16_t)ptr[0]) | ((uint16_t)ptr[1] << 8);
@@ -66,206 +56,355 @@ static void int32_to_buf(uint8_t *ptr, int32_t n)
   ptr[3] = (n >> 24) & 0xff;
 }
 
-int mesh_lib_serialize_request(const struct mesh_generic_request *req,
-                               uint8_t *msg_buf,
-                               size_t msg_len,
-                               size_t *msg_used)
-{
-  size_t msg_off = 0;
-
-  switch (req->kind) {
-    case mesh_generic_request_on_off:
-      if (msg_len < 1) {
-        return -1;
-      }
-      msg_buf[msg_off++] = req->on_off;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_request_on_power_up:
-      if (msg_len < 1) {
-        return -1;
-      }
-      msg_buf[msg_off++] = req->on_power_up;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_request_transition_time:
-      if (msg_len < 1) {
-        return -1;
-      }
-      msg_buf[msg_off++] = req->transition_time;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_request_level:
-    case mesh_generic_request_level_move:
-    case mesh_generic_request_level_halt:
-      if (msg_len < 2) {
-        return -1;
-      }
-      int16_to_buf(&msg_buf[msg_off], req->level);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_request_level_delta:
-      if (msg_len < 4) {
-        return -1;
-      }
-      int32_to_buf(&msg_buf[msg_off], req->delta);
-      msg_off += 4;
-      *msg_used = msg_off;
-      break;
+/*
+ * Every request and state kind is described by a constant descriptor
+ * listing its fixed fields in wire order. Each field is stored in the
+ * request/state structure with the same width it has on the wire, so
+ * signed and unsigned fields share the same little endian copy; a width
+ * of 3 denotes a raw byte array (battery times). Kinds carrying property
+ * data additionally reference where the variable length tail is kept.
+ * Adding a new model kind only needs a new table entry.
+ */
+
+/** Maximum number of fixed fields of any kind */
+#define SD_MAX_FIELDS 5
+
+/** State may be followed by a target state with the same layout */
+#define SD_TARGET     0x01
+/** Variable length data follows the fixed fields */
+#define SD_TAIL       0x02
+/** Variable length data must have even length */
+#define SD_TAIL_EVEN  0x04
+/** Kind has a tail reference but no data on the wire; cleared on decode */
+#define SD_TAIL_NONE  0x08
+
+struct sd_field {
+  uint8_t offset; /**< Offset of the field in the request/state structure */
+  uint8_t width;  /**< Width of the field in bytes */
+};
+
+struct sd_tail {
+  uint8_t length; /**< Offset of the uint16_t data length */
+  uint8_t offset; /**< Offset of the uint16_t data offset */
+  uint8_t buffer; /**< Offset of the data buffer pointer */
+};
+
+struct sd_desc {
+  uint8_t flags;                          /**< SD_xxx flags */
+  uint8_t len;                            /**< Serialized length of fields */
+  uint8_t fields;                         /**< Number of fields in use */
+  struct sd_field field[SD_MAX_FIELDS];   /**< Fields in wire order */
+  const struct sd_tail *tail;             /**< Tail reference, if any */
+};
+
+#define REQ_F(member, width) \
+  { offsetof(struct mesh_generic_request, member), width }
+#define STATE_F(member, width) \
+  { offsetof(struct mesh_generic_state, member), width }
+
+#define REQ_TAIL(member)                                      \
+  {                                                           \
+    offsetof(struct mesh_generic_request, member.length),     \
+    offsetof(struct mesh_generic_request, member.offset),     \
+    offsetof(struct mesh_generic_request, member.buffer)      \
+  }
+#define STATE_TAIL(member)                                    \
+  {                                                           \
+    offsetof(struct mesh_generic_state, member.length),       \
+    offsetof(struct mesh_generic_state, member.offset),       \
+    offsetof(struct mesh_generic_state, member.buffer)        \
+  }
 
-    case mesh_generic_request_location_global:
-      if (msg_len < 10) {
-        return -1;
-      }
-      int32_to_buf(&msg_buf[msg_off], req->location_global.lat);
-      msg_off += 4;
-      int32_to_buf(&msg_buf[msg_off], req->location_global.lon);
-      msg_off += 4;
-      int16_to_buf(&msg_buf[msg_off], req->location_global.alt);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+static const struct sd_tail request_property_tail = REQ_TAIL(property);
+static const struct sd_tail state_property_tail = STATE_TAIL(property);
+static const struct sd_tail state_property_list_tail = STATE_TAIL(property_list);
+
+static const struct sd_desc generic_request_desc[] = {
+  [mesh_generic_request_on_off] =
+  { 0, 1, 1, { REQ_F(on_off, 1) }, NULL },
+  [mesh_generic_request_on_power_up] =
+  { 0, 1, 1, { REQ_F(on_power_up, 1) }, NULL },
+  [mesh_generic_request_level] =
+  { 0, 2, 1, { REQ_F(level, 2) }, NULL },
+  [mesh_generic_request_level_delta] =
+  { 0, 4, 1, { REQ_F(delta, 4) }, NULL },
+  [mesh_generic_request_level_move] =
+  { 0, 2, 1, { REQ_F(level, 2) }, NULL },
+  [mesh_generic_request_level_halt] =
+  { 0, 2, 1, { REQ_F(level, 2) }, NULL },
+  [mesh_generic_request_power_level] =
+  { 0, 2, 1, { REQ_F(power_level, 2) }, NULL },
+  [mesh_generic_request_power_level_default] =
+  { 0, 2, 1, { REQ_F(power_level, 2) }, NULL },
+  [mesh_generic_request_power_level_range] =
+  { 0, 4, 2, { REQ_F(power_range[0], 2), REQ_F(power_range[1], 2) }, NULL },
+  [mesh_generic_request_transition_time] =
+  { 0, 1, 1, { REQ_F(transition_time, 1) }, NULL },
+  [mesh_generic_request_location_global] =
+  { 0, 10, 3, { REQ_F(location_global.lat, 4),
+                REQ_F(location_global.lon, 4),
+                REQ_F(location_global.alt, 2) }, NULL },
+  [mesh_generic_request_location_local] =
+  { 0, 9, 5, { REQ_F(location_local.north, 2),
+               REQ_F(location_local.east, 2),
+               REQ_F(location_local.alt, 2),
+               REQ_F(location_local.floor, 1),
+               REQ_F(location_local.uncertainty, 2) }, NULL },
+  [mesh_generic_request_property_user] =
+  { SD_TAIL, 2, 1, { REQ_F(property.id, 2) }, &request_property_tail },
+  [mesh_generic_request_property_admin] =
+  { SD_TAIL, 3, 2, { REQ_F(property.id, 2),
+                     REQ_F(property.access, 1) }, &request_property_tail },
+  [mesh_generic_request_property_manuf] =
+  { SD_TAIL_NONE, 3, 2, { REQ_F(property.id, 2),
+                          REQ_F(property.access, 1) }, &request_property_tail },
+};
+
+static const struct sd_desc lighting_request_desc[] = {
+  [mesh_lighting_request_lightness_actual - 0x80] =
+  { 0, 2, 1, { REQ_F(lightness, 2) }, NULL },
+  [mesh_lighting_request_lightness_linear - 0x80] =
+  { 0, 2, 1, { REQ_F(lightness, 2) }, NULL },
+  [mesh_lighting_request_lightness_default - 0x80] =
+  { 0, 2, 1, { REQ_F(lightness, 2) }, NULL },
+  [mesh_lighting_request_lightness_range - 0x80] =
+  { 0, 4, 2, { REQ_F(lightness_range.min, 2),
+               REQ_F(lightness_range.max, 2) }, NULL },
+  [mesh_lighting_request_ctl - 0x80] =
+  { 0, 6, 3, { REQ_F(ctl.lightness, 2),
+               REQ_F(ctl.temperature, 2),
+               REQ_F(ctl.deltauv, 2) }, NULL },
+  [mesh_lighting_request_ctl_temperature - 0x80] =
+  { 0, 4, 2, { REQ_F(ctl_temperature.temperature, 2),
+               REQ_F(ctl_temperature.deltauv, 2) }, NULL },
+  [mesh_lighting_request_ctl_default - 0x80] =
+  { 0, 6, 3, { REQ_F(ctl.lightness, 2),
+               REQ_F(ctl.temperature, 2),
+               REQ_F(ctl.deltauv, 2) }, NULL },
+  [mesh_lighting_request_ctl_temperature_range - 0x80] =
+  { 0, 4, 2, { REQ_F(ctl_temperature_range.min, 2),
+               REQ_F(ctl_temperature_range.max, 2) }, NULL },
+};
+
+static const struct sd_desc generic_state_desc[] = {
+  [mesh_generic_state_on_off] =
+  { SD_TARGET, 1, 1, { STATE_F(on_off.on, 1) }, NULL },
+  [mesh_generic_state_on_power_up] =
+  { 0, 1, 1, { STATE_F(on_power_up.on_power_up, 1) }, NULL },
+  [mesh_generic_state_level] =
+  { SD_TARGET, 2, 1, { STATE_F(level.level, 2) }, NULL },
+  [mesh_generic_state_power_level] =
+  { SD_TARGET, 2, 1, { STATE_F(power_level.level, 2) }, NULL },
+  [mesh_generic_state_power_level_last] =
+  { 0, 2, 1, { STATE_F(power_level_last.level, 2) }, NULL },
+  [mesh_generic_state_power_level_default] =
+  { 0, 2, 1, { STATE_F(power_level_default.level, 2) }, NULL },
+  [mesh_generic_state_power_level_range] =
+  { 0, 5, 3, { STATE_F(power_level_range.status, 1),
+               STATE_F(power_level_range.min, 2),
+               STATE_F(power_level_range.max, 2) }, NULL },
+  [mesh_generic_state_transition_time] =
+  { 0, 1, 1, { STATE_F(transition_time.time, 1) }, NULL },
+  [mesh_generic_state_battery] =
+  { 0, 8, 4, { STATE_F(battery.level, 1),
+               STATE_F(battery.discharge_time, 3),
+               STATE_F(battery.charge_time, 3),
+               STATE_F(battery.flags, 1) }, NULL },
+  [mesh_generic_state_location_global] =
+  { 0, 10, 3, { STATE_F(location_global.lat, 4),
+                STATE_F(location_global.lon, 4),
+                STATE_F(location_global.alt, 2) }, NULL },
+  [mesh_generic_state_location_local] =
+  { 0, 9, 5, { STATE_F(location_local.north, 2),
+               STATE_F(location_local.east, 2),
+               STATE_F(location_local.alt, 2),
+               STATE_F(location_local.floor, 1),
+               STATE_F(location_local.uncertainty, 2) }, NULL },
+  [mesh_generic_state_property_user] =
+  { SD_TAIL, 3, 2, { STATE_F(property.id, 2),
+                     STATE_F(property.access, 1) }, &state_property_tail },
+  [mesh_generic_state_property_admin] =
+  { SD_TAIL, 3, 2, { STATE_F(property.id, 2),
+                     STATE_F(property.access, 1) }, &state_property_tail },
+  [mesh_generic_state_property_manuf] =
+  { SD_TAIL, 3, 2, { STATE_F(property.id, 2),
+                     STATE_F(property.access, 1) }, &state_property_tail },
+  [mesh_generic_state_property_list_user] =
+  { SD_TAIL | SD_TAIL_EVEN, 0, 0, { { 0, 0 } }, &state_property_list_tail },
+  [mesh_generic_state_property_list_admin] =
+  { SD_TAIL | SD_TAIL_EVEN, 0, 0, { { 0, 0 } }, &state_property_list_tail },
+  [mesh_generic_state_property_list_manuf] =
+  { SD_TAIL | SD_TAIL_EVEN, 0, 0, { { 0, 0 } }, &state_property_list_tail },
+  [mesh_generic_state_property_list_client] =
+  { SD_TAIL | SD_TAIL_EVEN, 0, 0, { { 0, 0 } }, &state_property_list_tail },
+};
+
+static const struct sd_desc lighting_state_desc[] = {
+  [mesh_lighting_state_lightness_actual - 0x80] =
+  { SD_TARGET, 2, 1, { STATE_F(lightness.level, 2) }, NULL },
+  [mesh_lighting_state_lightness_linear - 0x80] =
+  { SD_TARGET, 2, 1, { STATE_F(lightness.level, 2) }, NULL },
+  [mesh_lighting_state_lightness_last - 0x80] =
+  { 0, 2, 1, { STATE_F(lightness.level, 2) }, NULL },
+  [mesh_lighting_state_lightness_default - 0x80] =
+  { 0, 2, 1, { STATE_F(lightness.level, 2) }, NULL },
+  [mesh_lighting_state_lightness_range - 0x80] =
+  { 0, 4, 2, { STATE_F(lightness_range.min, 2),
+               STATE_F(lightness_range.max, 2) }, NULL },
+  [mesh_lighting_state_ctl - 0x80] =
+  { SD_TARGET, 6, 3, { STATE_F(ctl.lightness, 2),
+                       STATE_F(ctl.temperature, 2),
+                       STATE_F(ctl.deltauv, 2) }, NULL },
+  [mesh_lighting_state_ctl_temperature - 0x80] =
+  { SD_TARGET, 4, 2, { STATE_F(ctl_temperature.temperature, 2),
+                       STATE_F(ctl_temperature.deltauv, 2) }, NULL },
+  [mesh_lighting_state_ctl_default - 0x80] =
+  { 0, 6, 3, { STATE_F(ctl.lightness, 2),
+               STATE_F(ctl.temperature, 2),
+               STATE_F(ctl.deltauv, 2) }, NULL },
+  [mesh_lighting_state_ctl_temperature_range - 0x80] =
+  { 0, 4, 2, { STATE_F(ctl_temperature_range.min, 2),
+               STATE_F(ctl_temperature_range.max, 2) }, NULL },
+  [mesh_lighting_state_ctl_lightness_temperature - 0x80] =
+  { SD_TARGET, 4, 2, { STATE_F(ctl_lightness_temperature.lightness, 2),
+                       STATE_F(ctl_lightness_temperature.temperature, 2) }, NULL },
+};
+
+#define SD_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+
+static const struct sd_desc *request_desc(mesh_generic_request_t kind)
+{
+  uint32_t k = (uint32_t)kind;
+  if (k < SD_COUNT(generic_request_desc)) {
+    return &generic_request_desc[k];
+  }
+  if (k >= 0x80 && k - 0x80 < SD_COUNT(lighting_request_desc)) {
+    return &lighting_request_desc[k - 0x80];
+  }
+  return NULL;
+}
 
-    case mesh_generic_request_location_local:
-      if (msg_len < 9) {
-        return -1;
-      }
-      int16_to_buf(&msg_buf[msg_off], req->location_local.north);
-      msg_off += 2;
-      int16_to_buf(&msg_buf[msg_off], req->location_local.east);
-      msg_off += 2;
-      int16_to_buf(&msg_buf[msg_off], req->location_local.alt);
-      msg_off += 2;
-      msg_buf[msg_off++] = req->location_local.floor;
-      uint16_to_buf(&msg_buf[msg_off], req->location_local.uncertainty);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+static const struct sd_desc *state_desc(mesh_generic_state_t kind)
+{
+  uint32_t k = (uint32_t)kind;
+  if (k < SD_COUNT(generic_state_desc)) {
+    return &generic_state_desc[k];
+  }
+  if (k >= 0x80 && k - 0x80 < SD_COUNT(lighting_state_desc)) {
+    return &lighting_state_desc[k - 0x80];
+  }
+  return NULL;
+}
 
-    case mesh_generic_request_power_level:
-    case mesh_generic_request_power_level_default:
-      if (msg_len < 2) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->power_level);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+static void fields_to_buf(uint8_t *msg_buf,
+                          const void *obj,
+                          const struct sd_desc *desc)
+{
+  const uint8_t *base = (const uint8_t *)obj;
+  uint8_t f;
+
+  for (f = 0; f < desc->fields; f++) {
+    const uint8_t *src = base + desc->field[f].offset;
+    switch (desc->field[f].width) {
+      case 1:
+        *msg_buf = *src;
+        break;
+      case 2:
+        uint16_to_buf(msg_buf, *(const uint16_t *)src);
+        break;
+      case 4:
+        int32_to_buf(msg_buf, *(const int32_t *)src);
+        break;
+      default:
+        memcpy(msg_buf, src, desc->field[f].width);
+        break;
+    }
+    msg_buf += desc->field[f].width;
+  }
+}
 
-    case mesh_generic_request_power_level_range:
-      if (msg_len < 4) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->power_range[0]);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], req->power_range[1]);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+static void fields_from_buf(void *obj,
+                            const uint8_t *msg_buf,
+                            const struct sd_desc *desc)
+{
+  uint8_t *base = (uint8_t *)obj;
+  uint8_t f;
+
+  for (f = 0; f < desc->fields; f++) {
+    uint8_t *dst = base + desc->field[f].offset;
+    switch (desc->field[f].width) {
+      case 1:
+        *dst = *msg_buf;
+        break;
+      case 2:
+        *(uint16_t *)dst = uint16_from_buf(msg_buf);
+        break;
+      case 4:
+        *(int32_t *)dst = int32_from_buf(msg_buf);
+        break;
+      default:
+        memcpy(dst, msg_buf, desc->field[f].width);
+        break;
+    }
+    msg_buf += desc->field[f].width;
+  }
+}
 
-    case mesh_generic_request_property_user:
-      if (msg_len < 2 + req->property.length) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->property.id);
-      msg_off += 2;
-      memcpy(msg_buf + msg_off,
-             req->property.buffer + req->property.offset,
-             req->property.length);
-      msg_off += req->property.length;
-      *msg_used = msg_off;
-      break;
+static uint16_t tail_length(const void *obj, const struct sd_desc *desc)
+{
+  const uint8_t *base = (const uint8_t *)obj;
+  return *(const uint16_t *)(base + desc->tail->length);
+}
 
-    case mesh_generic_request_property_admin:
-      if (msg_len < 3 + req->property.length) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->property.id);
-      msg_off += 2;
-      msg_buf[msg_off++] = req->property.access;
-      memcpy(msg_buf + msg_off,
-             req->property.buffer + req->property.offset,
-             req->property.length);
-      msg_off += req->property.length;
-      *msg_used = msg_off;
-      break;
+static void tail_to_buf(uint8_t *msg_buf,
+                        const void *obj,
+                        const struct sd_desc *desc)
+{
+  const uint8_t *base = (const uint8_t *)obj;
+  const uint8_t *buffer = *(const uint8_t * const *)(base + desc->tail->buffer);
+  uint16_t offset = *(const uint16_t *)(base + desc->tail->offset);
 
-    case mesh_generic_request_property_manuf:
-      if (msg_len < 3) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->property.id);
-      msg_off += 2;
-      msg_buf[msg_off++] = req->property.access;
-      *msg_used = msg_off;
-      break;
+  memcpy(msg_buf, buffer + offset, tail_length(obj, desc));
+}
 
-    case mesh_lighting_request_lightness_actual:
-    case mesh_lighting_request_lightness_linear:
-    case mesh_lighting_request_lightness_default:
-      if (msg_len < 2) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->lightness);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+static void tail_from_buf(void *obj,
+                          const uint8_t *msg_buf,
+                          size_t msg_off,
+                          size_t msg_len,
+                          const struct sd_desc *desc)
+{
+  uint8_t *base = (uint8_t *)obj;
 
-    case mesh_lighting_request_lightness_range:
-      if (msg_len < 4) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->lightness_range.min);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], req->lightness_range.max);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+  *(const uint8_t **)(base + desc->tail->buffer) = msg_buf;
+  *(uint16_t *)(base + desc->tail->offset) = msg_off;
+  *(uint16_t *)(base + desc->tail->length) = msg_len - msg_off;
+}
 
-    case mesh_lighting_request_ctl:
-    case mesh_lighting_request_ctl_default:
-      if (msg_len < 6) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->ctl.lightness);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], req->ctl.temperature);
-      msg_off += 2;
-      int16_to_buf(&msg_buf[msg_off], req->ctl.deltauv);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+int mesh_lib_serialize_request(const struct mesh_generic_request *req,
+                               uint8_t *msg_buf,
+                               size_t msg_len,
+                               size_t *msg_used)
+{
+  const struct sd_desc *desc = request_desc(req->kind);
+  size_t msg_off;
 
-    case mesh_lighting_request_ctl_temperature:
-      if (msg_len < 4) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->ctl_temperature.temperature);
-      msg_off += 2;
-      int16_to_buf(&msg_buf[msg_off], req->ctl_temperature.deltauv);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+  if (!desc) {
+    return -1;
+  }
 
-    case mesh_lighting_request_ctl_temperature_range:
-      if (msg_len < 4) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], req->ctl_temperature_range.min);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], req->ctl_temperature_range.max);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+  msg_off = desc->len;
+  if (desc->flags & SD_TAIL) {
+    msg_off += tail_length(req, desc);
+  }
+  if (msg_len < msg_off) {
+    return -1;
+  }
 
-    default:
-      return -1;
+  fields_to_buf(msg_buf, req, desc);
+  if (desc->flags & SD_TAIL) {
+    tail_to_buf(msg_buf + desc->len, req, desc);
   }
+  *msg_used = msg_off;
 
   return 0;
 }
@@ -275,186 +414,21 @@ int mesh_lib_deserialize_request(struct mesh_generic_request *req,
                                  const uint8_t *msg_buf,
                                  size_t msg_len)
 {
-  size_t msg_off = 0;
-
-  switch (kind) {
-    case mesh_generic_request_on_off:
-      if (msg_len - msg_off != 1) {
-        return -1;
-      }
-      req->kind = kind;
-      req->on_off = msg_buf[msg_off];
-      break;
-
-    case mesh_generic_request_on_power_up:
-      if (msg_len - msg_off != 1) {
-        return -1;
-      }
-      req->kind = kind;
-      req->on_power_up = msg_buf[msg_off];
-      break;
-
-    case mesh_generic_request_transition_time:
-      if (msg_len - msg_off != 1) {
-        return -1;
-      }
-      req->kind = kind;
-      req->transition_time = msg_buf[msg_off];
-      break;
-
-    case mesh_generic_request_level:
-    case mesh_generic_request_level_move:
-    case mesh_generic_request_level_halt:
-      if (msg_len - msg_off != 2) {
-        return -1;
-      }
-      req->kind = kind;
-      req->level = int16_from_buf(&msg_buf[msg_off]);
-      break;
-
-    case mesh_generic_request_level_delta:
-      if (msg_len - msg_off != 4) {
-        return -1;
-      }
-      req->kind = kind;
-      req->delta = int32_from_buf(&msg_buf[msg_off]);
-      break;
-
-    case mesh_generic_request_location_global:
-      if (msg_len - msg_off != 10) {
-        return -1;
-      }
-      req->kind = kind;
-      req->location_global.lat = int32_from_buf(&msg_buf[msg_off]);
-      msg_off += 4;
-      req->location_global.lon = int32_from_buf(&msg_buf[msg_off]);
-      msg_off += 4;
-      req->location_global.alt = int16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      break;
-
-    case mesh_generic_request_location_local:
-      if (msg_len - msg_off != 9) {
-        return -1;
-      }
-      req->kind = kind;
-      req->location_local.north = int16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      req->location_local.east = int16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      req->location_local.alt = int16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      req->location_local.floor = msg_buf[msg_off++];
-      req->location_local.uncertainty = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      break;
-
-    case mesh_generic_request_power_level:
-    case mesh_generic_request_power_level_default:
-      if (msg_len - msg_off != 2) {
-        return -1;
-      }
-      req->kind = kind;
-      req->power_level = uint16_from_buf(&msg_buf[msg_off]);
-      break;
-
-    case mesh_generic_request_power_level_range:
-      if (msg_len - msg_off != 4) {
-        return -1;
-      }
-      req->kind = kind;
-      req->power_range[0] = uint16_from_buf(&msg_buf[msg_off]);
-      req->power_range[1] = uint16_from_buf(&msg_buf[msg_off + 2]);
-      break;
-
-    case mesh_generic_request_property_user:
-      if (msg_len - msg_off < 2) {
-        return -1;
-      }
-      req->kind = kind;
-      req->property.id = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      req->property.buffer = msg_buf;
-      req->property.offset = msg_off;
-      req->property.length = msg_len - msg_off;
-      break;
+  const struct sd_desc *desc = request_desc(kind);
 
-    case mesh_generic_request_property_admin:
-      if (msg_len - msg_off < 3) {
-        return -1;
-      }
-      req->kind = kind;
-      req->property.id = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      req->property.access = msg_buf[msg_off++];
-      req->property.buffer = msg_buf;
-      req->property.offset = msg_off;
-      req->property.length = msg_len - msg_off;
-      break;
-
-    case mesh_generic_request_property_manuf:
-      if (msg_len - msg_off != 3) {
-        return -1;
-      }
-      req->kind = kind;
-      req->property.id = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      req->property.access = msg_buf[msg_off++];
-      req->property.buffer = NULL;
-      req->property.offset = 0;
-      req->property.length = 0;
-      break;
-
-    case mesh_lighting_request_lightness_actual:
-    case mesh_lighting_request_lightness_linear:
-    case mesh_lighting_request_lightness_default:
-      if (msg_len - msg_off != 2) {
-        return -1;
-      }
-      req->kind = kind;
-      req->lightness = uint16_from_buf(&msg_buf[msg_off]);
-      break;
-
-    case mesh_lighting_request_lightness_range:
-      if (msg_len - msg_off != 4) {
-        return -1;
-      }
-      req->kind = kind;
-      req->lightness_range.min = uint16_from_buf(&msg_buf[msg_off]);
-      req->lightness_range.max = uint16_from_buf(&msg_buf[msg_off + 2]);
-      break;
-
-    case mesh_lighting_request_ctl:
-    case mesh_lighting_request_ctl_default:
-      if (msg_len - msg_off != 6) {
-        return -1;
-      }
-      req->kind = kind;
-      req->ctl.lightness = uint16_from_buf(&msg_buf[msg_off]);
-      req->ctl.temperature = uint16_from_buf(&msg_buf[msg_off + 2]);
-      req->ctl.deltauv = int16_from_buf(&msg_buf[msg_off + 4]);
-      break;
-
-    case mesh_lighting_request_ctl_temperature:
-      if (msg_len - msg_off != 4) {
-        return -1;
-      }
-      req->kind = kind;
-      req->ctl_temperature.temperature = uint16_from_buf(&msg_buf[msg_off]);
-      req->ctl_temperature.deltauv = int16_from_buf(&msg_buf[msg_off + 2]);
-      break;
-
-    case mesh_lighting_request_ctl_temperature_range:
-      if (msg_len - msg_off != 4) {
-        return -1;
-      }
-      req->kind = kind;
-      req->ctl_temperature_range.min = uint16_from_buf(&msg_buf[msg_off]);
-      req->ctl_temperature_range.max = uint16_from_buf(&msg_buf[msg_off + 2]);
-      break;
+  if (!desc) {
+    return -1;
+  }
+  if ((desc->flags & SD_TAIL) ? msg_len < desc->len : msg_len != desc->len) {
+    return -1;
+  }
 
-    default:
-      return -1;
+  req->kind = kind;
+  fields_from_buf(req, msg_buf, desc);
+  if (desc->flags & SD_TAIL) {
+    tail_from_buf(req, msg_buf, desc->len, msg_len, desc);
+  } else if (desc->flags & SD_TAIL_NONE) {
+    tail_from_buf(req, NULL, 0, 0, desc);
   }
 
   return 0;
@@ -466,282 +440,32 @@ int mesh_lib_serialize_state(const struct mesh_generic_state *current,
                              size_t msg_len,
                              size_t *msg_used)
 {
-  size_t msg_off = 0;
-
-  switch (current->kind) {
-    case mesh_generic_state_on_off:
-      if (msg_len < (target ? 2 : 1)) {
-        return -1;
-      }
-      msg_buf[msg_off++] = current->on_off.on;
-      if (target) {
-        msg_buf[msg_off++] = target->on_off.on;
-      }
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_on_power_up:
-      if (msg_len < 1) {
-        return -1;
-      }
-      msg_buf[msg_off++] = current->on_power_up.on_power_up;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_transition_time:
-      if (msg_len < 1) {
-        return -1;
-      }
-      msg_buf[msg_off++] = current->transition_time.time;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_level:
-      if (msg_len < (target ? 4 : 2)) {
-        return -1;
-      }
-      int16_to_buf(&msg_buf[msg_off], current->level.level);
-      msg_off += 2;
-      if (target) {
-        int16_to_buf(&msg_buf[msg_off], target->level.level);
-        msg_off += 2;
-      }
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_location_global:
-      if (msg_len < 10) {
-        return -1;
-      }
-      int32_to_buf(&msg_buf[msg_off], current->location_global.lat);
-      msg_off += 4;
-      int32_to_buf(&msg_buf[msg_off], current->location_global.lon);
-      msg_off += 4;
-      int16_to_buf(&msg_buf[msg_off], current->location_global.alt);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_location_local:
-      if (msg_len < 9) {
-        return -1;
-      }
-      int16_to_buf(&msg_buf[msg_off], current->location_local.north);
-      msg_off += 2;
-      int16_to_buf(&msg_buf[msg_off], current->location_local.east);
-      msg_off += 2;
-      int16_to_buf(&msg_buf[msg_off], current->location_local.alt);
-      msg_off += 2;
-      msg_buf[msg_off++] = current->location_local.floor;
-      uint16_to_buf(&msg_buf[msg_off], current->location_local.uncertainty);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+  const struct sd_desc *desc = state_desc(current->kind);
+  size_t msg_off;
 
-    case mesh_generic_state_battery:
-      if (msg_len < 8) {
-        return -1;
-      }
-      msg_buf[msg_off++] = current->battery.level;
-      memcpy(msg_buf + msg_off, current->battery.discharge_time, 3);
-      msg_off += 3;
-      memcpy(msg_buf + msg_off, current->battery.charge_time, 3);
-      msg_off += 3;
-      msg_buf[msg_off++] = current->battery.flags;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_power_level:
-      if (msg_len < (target ? 4 : 2)) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->power_level.level);
-      msg_off += 2;
-      if (target) {
-        uint16_to_buf(&msg_buf[msg_off], target->power_level.level);
-        msg_off += 2;
-      }
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_power_level_last:
-      if (msg_len < 2) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->power_level_last.level);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_power_level_default:
-      if (msg_len < 2) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->power_level_default.level);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_power_level_range:
-      if (msg_len < 5) {
-        return -1;
-      }
-      msg_buf[msg_off++] = current->power_level_range.status;
-      uint16_to_buf(&msg_buf[msg_off], current->power_level_range.min);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], current->power_level_range.max);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_property_user:
-    case mesh_generic_state_property_admin:
-    case mesh_generic_state_property_manuf:
-      if (msg_len < 3 + current->property.length) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->property.id);
-      msg_off += 2;
-      msg_buf[msg_off++] = current->property.access;
-      memcpy(msg_buf + msg_off,
-             current->property.buffer + current->property.offset,
-             current->property.length);
-      msg_off += current->property.length;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_generic_state_property_list_user:
-    case mesh_generic_state_property_list_admin:
-    case mesh_generic_state_property_list_manuf:
-    case mesh_generic_state_property_list_client:
-      if (msg_len < current->property_list.length) {
-        return -1;
-      }
-      memcpy(msg_buf + msg_off,
-             current->property_list.buffer + current->property_list.offset,
-             current->property_list.length);
-      msg_off += current->property_list.length;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_lighting_state_lightness_actual:
-    case mesh_lighting_state_lightness_linear:
-      if (msg_len < (target ? 4 : 2)) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->lightness.level);
-      msg_off += 2;
-      if (target) {
-        uint16_to_buf(&msg_buf[msg_off], target->lightness.level);
-        msg_off += 2;
-      }
-      *msg_used = msg_off;
-      break;
-
-    case mesh_lighting_state_lightness_last:
-    case mesh_lighting_state_lightness_default:
-      if (msg_len < 2) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->lightness.level);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_lighting_state_lightness_range:
-      if (msg_len < 4) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->lightness_range.min);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], current->lightness_range.max);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
-
-    case mesh_lighting_state_ctl:
-      if (msg_len < (target ? 12 : 6)) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->ctl.lightness);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], current->ctl.temperature);
-      msg_off += 2;
-      int16_to_buf(&msg_buf[msg_off], current->ctl.deltauv);
-      msg_off += 2;
-      if (target) {
-        uint16_to_buf(&msg_buf[msg_off], target->ctl.lightness);
-        msg_off += 2;
-        uint16_to_buf(&msg_buf[msg_off], target->ctl.temperature);
-        msg_off += 2;
-        int16_to_buf(&msg_buf[msg_off], target->ctl.deltauv);
-        msg_off += 2;
-      }
-      *msg_used = msg_off;
-      break;
-
-    case mesh_lighting_state_ctl_temperature:
-      if (msg_len < (target ? 8 : 4)) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->ctl_temperature.temperature);
-      msg_off += 2;
-      int16_to_buf(&msg_buf[msg_off], current->ctl_temperature.deltauv);
-      msg_off += 2;
-      if (target) {
-        uint16_to_buf(&msg_buf[msg_off], target->ctl_temperature.temperature);
-        msg_off += 2;
-        int16_to_buf(&msg_buf[msg_off], target->ctl_temperature.deltauv);
-        msg_off += 2;
-      }
-      *msg_used = msg_off;
-      break;
-
-    case mesh_lighting_state_ctl_lightness_temperature:
-      if (msg_len < (target ? 8 : 4)) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->ctl_lightness_temperature.lightness);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], current->ctl_lightness_temperature.temperature);
-      msg_off += 2;
-      if (target) {
-        uint16_to_buf(&msg_buf[msg_off], target->ctl_lightness_temperature.lightness);
-        msg_off += 2;
-        uint16_to_buf(&msg_buf[msg_off], target->ctl_lightness_temperature.temperature);
-        msg_off += 2;
-      }
-      *msg_used = msg_off;
-      break;
-
-    case mesh_lighting_state_ctl_default:
-      if (msg_len < 6) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->ctl.lightness);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], current->ctl.temperature);
-      msg_off += 2;
-      int16_to_buf(&msg_buf[msg_off], current->ctl.deltauv);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+  if (!desc) {
+    return -1;
+  }
+  if (!(desc->flags & SD_TARGET)) {
+    target = NULL;
+  }
 
-    case mesh_lighting_state_ctl_temperature_range:
-      if (msg_len < 4) {
-        return -1;
-      }
-      uint16_to_buf(&msg_buf[msg_off], current->ctl_temperature_range.min);
-      msg_off += 2;
-      uint16_to_buf(&msg_buf[msg_off], current->ctl_temperature_range.max);
-      msg_off += 2;
-      *msg_used = msg_off;
-      break;
+  msg_off = target ? 2 * desc->len : desc->len;
+  if (desc->flags & SD_TAIL) {
+    msg_off += tail_length(current, desc);
+  }
+  if (msg_len < msg_off) {
+    return -1;
+  }
 
-    case mesh_generic_state_last:
-    default:
-      return -1;
+  fields_to_buf(msg_buf, current, desc);
+  if (target) {
+    fields_to_buf(msg_buf + desc->len, target, desc);
+  }
+  if (desc->flags & SD_TAIL) {
+    tail_to_buf(msg_buf + desc->len, current, desc);
   }
+  *msg_used = msg_off;
 
   return 0;
 }
@@ -753,349 +477,36 @@ int mesh_lib_deserialize_state(struct mesh_generic_state *current,
                                const uint8_t *msg_buf,
                                size_t msg_len)
 {
-  size_t msg_off = 0;
-
-  switch (kind) {
-    case mesh_generic_state_on_off:
-      if (msg_len - msg_off == 1) {
-        current->kind = kind;
-        current->on_off.on = msg_buf[msg_off++];
-        *has_target = 0;
-      } else if (msg_len - msg_off == 2) {
-        current->kind = kind;
-        current->on_off.on = msg_buf[msg_off++];
-        target->kind = kind;
-        target->on_off.on = msg_buf[msg_off++];
-        *has_target = 1;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_generic_state_on_power_up:
-      if (msg_len - msg_off == 1) {
-        current->kind = kind;
-        current->on_power_up.on_power_up = msg_buf[msg_off++];
-        *has_target = 0;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_generic_state_transition_time:
-      if (msg_len - msg_off == 1) {
-        current->kind = kind;
-        current->transition_time.time = msg_buf[msg_off++];
-        *has_target = 0;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_generic_state_level:
-      if (msg_len - msg_off == 2) {
-        current->kind = kind;
-        current->level.level = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else if (msg_len - msg_off == 4) {
-        current->kind = kind;
-        current->level.level = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->kind = kind;
-        target->level.level = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 1;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_generic_state_location_global:
-      if (msg_len - msg_off != 10) {
-        return -1;
-      }
-      current->kind = kind;
-      current->location_global.lat = int32_from_buf(&msg_buf[msg_off]);
-      msg_off += 4;
-      current->location_global.lon = int32_from_buf(&msg_buf[msg_off]);
-      msg_off += 4;
-      current->location_global.alt = int16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      *has_target = 0;
-      break;
-
-    case mesh_generic_state_location_local:
-      if (msg_len - msg_off != 9) {
-        return -1;
-      }
-      current->kind = kind;
-      current->location_local.north = int16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      current->location_local.east = int16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      current->location_local.alt = int16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      current->location_local.floor = msg_buf[msg_off++];
-      current->location_local.uncertainty = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      *has_target = 0;
-      break;
-
-    case mesh_generic_state_battery:
-      if (msg_len - msg_off != 8) {
-        return -1;
-      }
-      current->kind = kind;
-      current->battery.level = msg_buf[msg_off++];
-      memcpy(current->battery.discharge_time, msg_buf + msg_off, 3);
-      msg_off += 3;
-      memcpy(current->battery.charge_time, msg_buf + msg_off, 3);
-      msg_off += 3;
-      current->battery.flags = msg_buf[msg_off++];
-      *has_target = 0;
-      break;
-
-    case mesh_generic_state_power_level:
-      if (msg_len - msg_off == 2) {
-        current->kind = kind;
-        current->power_level.level = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else if (msg_len - msg_off == 4) {
-        current->kind = kind;
-        current->power_level.level = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->kind = kind;
-        target->power_level.level = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 1;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_generic_state_power_level_last:
-      if (msg_len - msg_off != 2) {
-        return -1;
-      }
-      current->kind = kind;
-      current->power_level_last.level = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      *has_target = 0;
-      break;
-
-    case mesh_generic_state_power_level_default:
-      if (msg_len - msg_off != 2) {
-        return -1;
-      }
-      current->kind = kind;
-      current->power_level_default.level = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      *has_target = 0;
-      break;
-
-    case mesh_generic_state_power_level_range:
-      if (msg_len - msg_off != 5) {
-        return -1;
-      }
-      current->kind = kind;
-      current->power_level_range.status = msg_buf[msg_off++];
-      current->power_level_range.min = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      current->power_level_range.max = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      *has_target = 0;
-      break;
+  const struct sd_desc *desc = state_desc(kind);
+  int with_target = 0;
 
-    case mesh_generic_state_property_user:
-    case mesh_generic_state_property_admin:
-    case mesh_generic_state_property_manuf:
-      if (msg_len - msg_off < 3) {
-        return -1;
-      }
-      current->kind = kind;
-      current->property.id = uint16_from_buf(&msg_buf[msg_off]);
-      msg_off += 2;
-      current->property.access = msg_buf[msg_off++];
-      current->property.buffer = msg_buf;
-      current->property.offset = msg_off;
-      current->property.length = msg_len - msg_off;
-      *has_target = 0;
-      break;
-
-    case mesh_generic_state_property_list_user:
-    case mesh_generic_state_property_list_admin:
-    case mesh_generic_state_property_list_manuf:
-    case mesh_generic_state_property_list_client:
-      if ((msg_len - msg_off) & 0x01) {
-        return -1;
-      }
-      current->kind = kind;
-      current->property_list.buffer = msg_buf;
-      current->property_list.offset = msg_off;
-      current->property_list.length = msg_len - msg_off;
-      *has_target = 0;
-      break;
-
-    case mesh_lighting_state_lightness_actual:
-    case mesh_lighting_state_lightness_linear:
-      if (msg_len - msg_off == 2) {
-        current->kind = kind;
-        current->lightness.level = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else if (msg_len - msg_off == 4) {
-        current->kind = kind;
-        current->lightness.level = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->kind = kind;
-        target->lightness.level = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 1;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_lighting_state_lightness_last:
-    case mesh_lighting_state_lightness_default:
-      if (msg_len - msg_off == 2) {
-        current->kind = kind;
-        current->lightness.level = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_lighting_state_lightness_range:
-      if (msg_len - msg_off == 4) {
-        current->kind = kind;
-        current->lightness_range.min = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->lightness_range.max = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_lighting_state_ctl:
-      if (msg_len - msg_off == 6) {
-        current->kind = kind;
-        current->ctl.lightness = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl.temperature = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl.deltauv = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else if (msg_len - msg_off == 12) {
-        current->kind = kind;
-        current->ctl.lightness = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl.temperature = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl.deltauv = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->kind = kind;
-        target->ctl.lightness = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->ctl.temperature = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->ctl.deltauv = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 1;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_lighting_state_ctl_temperature:
-      if (msg_len - msg_off == 4) {
-        current->kind = kind;
-        current->ctl_temperature.temperature = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl_temperature.deltauv = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else if (msg_len - msg_off == 8) {
-        current->kind = kind;
-        current->ctl_temperature.temperature = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl_temperature.deltauv = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->kind = kind;
-        target->ctl_temperature.temperature = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->ctl_temperature.deltauv = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 1;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_lighting_state_ctl_lightness_temperature:
-      if (msg_len - msg_off == 4) {
-        current->kind = kind;
-        current->ctl_lightness_temperature.lightness = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl_lightness_temperature.temperature = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else if (msg_len - msg_off == 8) {
-        current->kind = kind;
-        current->ctl_lightness_temperature.lightness = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl_lightness_temperature.temperature = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->kind = kind;
-        target->ctl_lightness_temperature.lightness = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        target->ctl_lightness_temperature.temperature = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 1;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_lighting_state_ctl_default:
-      if (msg_len - msg_off == 6) {
-        current->kind = kind;
-        current->ctl.lightness = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl.temperature = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl.deltauv = int16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else {
-        return -1;
-      }
-      break;
-
-    case mesh_lighting_state_ctl_temperature_range:
-      if (msg_len - msg_off == 4) {
-        current->kind = kind;
-        current->ctl_temperature_range.min = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        current->ctl_temperature_range.max = uint16_from_buf(&msg_buf[msg_off]);
-        msg_off += 2;
-        *has_target = 0;
-      } else {
-        return -1;
-      }
-      break;
+  if (!desc) {
+    return -1;
+  }
 
-    case mesh_generic_state_last:
-    default:
+  if (desc->flags & SD_TAIL) {
+    if (msg_len < desc->len) {
+      return -1;
+    }
+    if ((desc->flags & SD_TAIL_EVEN) && ((msg_len - desc->len) & 0x01)) {
       return -1;
+    }
+  } else if (msg_len == 2 * desc->len && (desc->flags & SD_TARGET)) {
+    with_target = 1;
+  } else if (msg_len != desc->len) {
+    return -1;
+  }
+
+  current->kind = kind;
+  fields_from_buf(current, msg_buf, desc);
+  if (with_target) {
+    target->kind = kind;
+    fields_from_buf(target, msg_buf + desc->len, desc);
+  }
+  if (desc->flags & SD_TAIL) {
+    tail_from_buf(current, msg_buf, desc->len, msg_len, desc);
   }
+  *has_target = with_target;
 
   return 0;
 }
@@ -0,0 +1,70 @@
+/*
+ * console.c
+ *
+ *  Line assembly for commands received over VCOM
+ */
+
+#include "console.h"
+#include "retargetserial.h"
+#include "native_gecko.h"
+#include <stdbool.h>
+#include <string.h>
+
+static char consoleLine[CONSOLE_LINE_MAX + 1];
+static size_t consoleLength;
+static bool consoleOverflow;		/* dropping the rest of a line that was too long */
+
+/**
+ * Called from the RX interrupt, wakes the main loop to read the received data
+ */
+static void consoleRxNotify(void)
+{
+	gecko_external_signal(EVENT_CONSOLE_LINE);
+}
+
+void consoleInit(void)
+{
+	consoleLength = 0;
+	consoleOverflow = false;
+	RETARGET_SerialRxNotifySet(consoleRxNotify);
+}
+
+/**
+ * Read the next complete line received.  A partial line is kept for the next call.
+ * @param line buffer for the line, NUL terminated
+ * @param size of the buffer, lines are truncated to fit
+ * @return length of the line, -1 if no complete line has been received yet or -2 if a line longer
+ * than CONSOLE_LINE_MAX was dropped
+ */
+int consoleReadLine(char *line, size_t size)
+{
+	int c;
+
+	while ((c = RETARGET_ReadChar()) >= 0) {
+		if (c == '\r' || c == '\n') {
+			size_t length = consoleLength;
+
+			consoleLength = 0;
+			if (consoleOverflow) {
+				consoleOverflow = false;
+				return -2;
+			}
+			if (length == 0) {
+				/* LF of a CRLF, or an empty line */
+				continue;
+			}
+			if (length >= size) {
+				length = size - 1;
+			}
+			memcpy(line, consoleLine, length);
+			line[length] = '\0';
+			return (int)length;
+		}
+		if (consoleLength < CONSOLE_LINE_MAX) {
+			consoleLine[consoleLength++] = (char)c;
+		} else {
+			consoleOverflow = true;
+		}
+	}
+	return -1;
+}
@@ -0,0 +1,30 @@
+/*
+ * console.h
+ *
+ *  Line assembly for commands received over VCOM
+ */
+
+#ifndef SRC_CONSOLE_H_
+#define SRC_CONSOLE_H_
+#include <stddef.h>
+
+/**
+ * Instructions for using this module:
+ * 1) Call consoleInit() once in the main init routine, after the serial port is initialized.
+ * 2) When the external signal EVENT_CONSOLE_LINE arrives, call consoleReadLine() until it returns -1
+ *    and handle each line it returns.
+ *  The RX interrupt posts EVENT_CONSOLE_LINE after it stores a CR or LF, or when its buffer is full,
+ *  so nothing is read from the serial port between commands.  Lines end with CR, LF or CRLF, empty
+ *  lines are skipped.  Lines longer than CONSOLE_LINE_MAX are dropped up to their end and reported
+ *  with a return value of -2, so a script streaming commands can tell which one was lost.
+ */
+#define EVENT_CONSOLE_LINE (1U << 4)
+
+#ifndef CONSOLE_LINE_MAX
+#define CONSOLE_LINE_MAX	128	/* longest command, without the terminating NUL */
+#endif
+
+void consoleInit(void);
+int consoleReadLine(char *line, size_t size);
+
+#endif /* SRC_CONSOLE_H_ */
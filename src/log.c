@@ -10,14 +10,446 @@
 #include <stdbool.h>
 
 #if INCLUDE_LOGGING
+#include <stdarg.h>
+#include <string.h>
+#include "em_core.h"
+
+static uint32_t logRepeated;		/* lines not sent because they repeated the one before */
+static uint32_t logRateLimited;		/* lines dropped by the call site rate limits */
+
 /**
- * @return a timestamp value for the logger, typically based on a free running timer.
+ * Get the counts of lines the log sink did not send.
+ * @param repeated set to the number of lines which repeated the one before
+ * @param rateLimited set to the number of lines dropped by the call site rate limits
+ */
+void logSinkStats(uint32_t *repeated, uint32_t *rateLimited)
+{
+	*repeated = logRepeated;
+	*rateLimited = logRateLimited;
+}
+#endif
+
+#if INCLUDE_LOGGING && LOG_RATE_LIMIT
+#if LOG_TIMESTAMP_HZ / LOG_RATE_PER_SEC == 0 || LOG_RATE_BURST < 1 || LOG_RATE_BURST > 0xffff
+#error "LOG_RATE_PER_SEC or LOG_RATE_BURST out of range"
+#endif
+
+/**
+ * Take a token from the bucket of a call site, called with interrupts disabled.
+ * @return false if the site is over its rate limit and the line is to be dropped
+ */
+static bool logLimitTake(logLimit_t *limit, uint32_t now)
+{
+	const uint32_t period = LOG_TIMESTAMP_HZ / LOG_RATE_PER_SEC;
+	uint32_t tokens = (now - limit->refilled) / period;
+
+	if (tokens >= limit->used) {
+		limit->used = 0;
+		limit->refilled = now;
+	} else {
+		limit->used -= tokens;
+		limit->refilled += tokens * period;
+	}
+	if (limit->used >= LOG_RATE_BURST) {
+		if (limit->suppressed != UINT16_MAX) {
+			limit->suppressed++;
+		}
+		logRateLimited++;
+		return false;
+	}
+	limit->used++;
+	return true;
+}
+#endif
+
+#if INCLUDE_LOGGING && LOG_BINARY
+#ifndef LOG_BINARY_RING_WORDS
+#define LOG_BINARY_RING_WORDS	256	/* size of the record ring in 32 bit words, power of two */
+#endif
+
+static uint32_t logRing[LOG_BINARY_RING_WORDS];
+static volatile uint32_t logRingWrite;	/* free running word indices */
+static volatile uint32_t logRingRead;
+static uint32_t logDropped;
+#if LOG_RATE_LIMIT
+static const char *logLastSite;		/* last record queued, for finding repeats */
+static uint32_t logLastNargs;
+static uint32_t logLastArgs[LOG_BINARY_MAX_ARGS];
+static uint32_t logRepeats;			/* repeats of the last record not yet reported */
+static uint32_t logRepeatsSince;	/* timestamp of the first of them */
+#endif
+
+/* Start of the log_strings section, record IDs are offsets from here */
+extern const char __start_log_strings[];
+
+/**
+ * Store a record in the ring, called with interrupts disabled.
+ * @param type argument count, or LOG_BINARY_REPEATED or LOG_BINARY_SUPPRESSED with a single argument
+ * @return false if the record does not fit
+ */
+static bool logRingPut(const char *site, uint32_t timestamp, uint32_t type, uint32_t nargs,
+		const uint32_t *args)
+{
+	uint32_t write = logRingWrite;
+	uint32_t i;
+
+	if (LOG_BINARY_RING_WORDS - (write - logRingRead) < nargs + 2) {
+		return false;
+	}
+	logRing[write++ & (LOG_BINARY_RING_WORDS - 1)] =
+		LOG_BINARY_SYNC | ((uint32_t)(site - __start_log_strings) << 4) | type;
+	logRing[write++ & (LOG_BINARY_RING_WORDS - 1)] = timestamp;
+	for (i = 0; i < nargs; i++) {
+		logRing[write++ & (LOG_BINARY_RING_WORDS - 1)] = args[i];
+	}
+	logRingWrite = write;
+	return true;
+}
+
+#if LOG_RATE_LIMIT
+/**
+ * Queue the count of repeats of the last record, called with interrupts disabled.
+ */
+static void logRepeatsPut(uint32_t timestamp)
+{
+	if (!logRingPut(logLastSite, timestamp, LOG_BINARY_REPEATED, 1, &logRepeats)) {
+		logDropped++;
+	}
+	logRepeats = 0;
+}
+
+/**
+ * Check whether a record repeats the last one queued and count it if so, called with interrupts
+ * disabled.
+ * @return true if the record is a repeat and is not to be queued
+ */
+static bool logRepeatCheck(const char *site, uint32_t timestamp, uint32_t nargs, const uint32_t *args)
+{
+	if (site == logLastSite && nargs == logLastNargs
+			&& memcmp(args, logLastArgs, nargs * sizeof(args[0])) == 0) {
+		if (logRepeats++ == 0) {
+			logRepeatsSince = timestamp;
+		}
+		logRepeated++;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Remember a record about to be queued as the last one, called with interrupts disabled.  Repeats
+ * of the record before are queued first.
+ */
+static void logLastSet(const char *site, uint32_t timestamp, uint32_t nargs, const uint32_t *args)
+{
+	if (logRepeats) {
+		logRepeatsPut(timestamp);
+	}
+	logLastSite = site;
+	logLastNargs = nargs;
+	memcpy(logLastArgs, args, nargs * sizeof(args[0]));
+}
+#endif
+
+/**
+ * Queue a log record, called by the LOG_XXX macros.  Nothing is formatted here, the record holds
+ * the call site, the timestamp and the raw argument words.
+ * @param site strings of the call site, see LOG_SITE
+ * @param limit rate limit state of the call site, NULL for none
+ * @param nargs number of 32 bit arguments which follow
+ */
+void logBinaryWrite(const char *site, logLimit_t *limit, uint32_t nargs, ...)
+{
+	LOG_SITE(droppedSite, "%"PRIu32" log records dropped", "Warn ");
+	uint32_t args[LOG_BINARY_MAX_ARGS];
+	uint32_t timestamp = loggerGetTimestamp();
+	uint32_t i;
+	va_list ap;
+	CORE_DECLARE_IRQ_STATE;
+
+	va_start(ap, nargs);
+	for (i = 0; i < nargs; i++) {
+		args[i] = va_arg(ap, uint32_t);
+	}
+	va_end(ap);
+
+	/* Logging is also done from interrupt handlers */
+	CORE_ENTER_ATOMIC();
+#if LOG_RATE_LIMIT
+	/* Repeats are only counted, so they do not use up the rate limit */
+	if (logRepeatCheck(site, timestamp, nargs, args)
+			|| (limit != NULL && !logLimitTake(limit, timestamp))) {
+		CORE_EXIT_ATOMIC();
+		return;
+	}
+#else
+	(void)limit;
+#endif
+	if (logDropped && logRingPut(droppedSite, timestamp, 1, 1, &logDropped)) {
+		logDropped = 0;
+	}
+#if LOG_RATE_LIMIT
+	logLastSet(site, timestamp, nargs, args);
+	if (limit != NULL && limit->suppressed) {
+		uint32_t suppressed = limit->suppressed;
+		if (logRingPut(site, timestamp, LOG_BINARY_SUPPRESSED, 1, &suppressed)) {
+			limit->suppressed = 0;
+		}
+	}
+#endif
+	if (!logRingPut(site, timestamp, nargs, nargs, args)) {
+		logDropped++;
+	}
+	CORE_EXIT_ATOMIC();
+}
+
+/**
+ * Send the queued log records over the serial port, little endian.  Call from the main loop,
+ * the ring is only read here.
+ */
+void logDrain(void)
+{
+#if LOG_RATE_LIMIT
+	uint32_t timestamp = loggerGetTimestamp();
+	CORE_DECLARE_IRQ_STATE;
+
+	CORE_ENTER_ATOMIC();
+	if (logRepeats && timestamp - logRepeatsSince >= LOG_REPEAT_SECONDS * LOG_TIMESTAMP_HZ) {
+		logRepeatsPut(timestamp);
+	}
+	CORE_EXIT_ATOMIC();
+#endif
+	while (logRingRead != logRingWrite) {
+		uint32_t word = logRing[logRingRead & (LOG_BINARY_RING_WORDS - 1)];
+		RETARGET_WriteChar((char)word);
+		RETARGET_WriteChar((char)(word >> 8));
+		RETARGET_WriteChar((char)(word >> 16));
+		RETARGET_WriteChar((char)(word >> 24));
+		logRingRead++;
+	}
+}
+#endif
+
+#if INCLUDE_LOGGING && !LOG_BINARY && LOG_RATE_LIMIT
+/* Last line sent, for finding repeats */
+static const logLimit_t *logLastLimit;
+static const char *logLastLevel;
+static const char *logLastFunc;
+static char logLastText[LOG_LINE_MAX];
+static uint32_t logRepeats;			/* repeats of the last line not yet reported */
+static uint32_t logRepeatsSince;	/* timestamp of the first of them */
+
+/**
+ * Print a log line, called by the LOG_XXX macros.  Lines which repeat the one before are counted
+ * instead of printed, other lines over the rate limit of their call site are dropped.
+ * @param limit rate limit state of the call site
+ * @param level of the line
+ * @param func name of the function logging
+ * @param format printf style format of the message
+ */
+void logTextWrite(logLimit_t *limit, const char *level, const char *func, const char *format, ...)
+{
+	char text[LOG_LINE_MAX];
+	uint32_t timestamp = loggerGetTimestamp();
+	uint32_t suppressed = 0;
+	uint32_t repeats = 0;
+	const char *repeatLevel = NULL;
+	const char *repeatFunc = NULL;
+	bool repeat;
+	va_list ap;
+	CORE_DECLARE_IRQ_STATE;
+
+	va_start(ap, format);
+	vsnprintf(text, sizeof(text), format, ap);
+	va_end(ap);
+
+	/* Logging is also done from interrupt handlers */
+	CORE_ENTER_ATOMIC();
+	repeat = limit == logLastLimit && strcmp(text, logLastText) == 0;
+	if (repeat) {
+		/* Repeats are only counted, so they do not use up the rate limit */
+		if (logRepeats++ == 0) {
+			logRepeatsSince = timestamp;
+		}
+		logRepeated++;
+	} else if (!logLimitTake(limit, timestamp)) {
+		CORE_EXIT_ATOMIC();
+		return;
+	} else {
+		repeats = logRepeats;
+		repeatLevel = logLastLevel;
+		repeatFunc = logLastFunc;
+		logRepeats = 0;
+		suppressed = limit->suppressed;
+		limit->suppressed = 0;
+		logLastLimit = limit;
+		logLastLevel = level;
+		logLastFunc = func;
+		strcpy(logLastText, text);
+	}
+	CORE_EXIT_ATOMIC();
+
+	if (repeats) {
+		printf("%5"PRIu32":%s:%s: last message repeated %"PRIu32" times\n",
+				timestamp, repeatLevel, repeatFunc, repeats);
+	}
+	if (suppressed) {
+		printf("%5"PRIu32":%s:%s: %"PRIu32" lines suppressed\n", timestamp, level, func, suppressed);
+	}
+	if (!repeat) {
+		printf("%5"PRIu32":%s:%s: %s\n", timestamp, level, func, text);
+	}
+}
+
+/**
+ * Print the count of repeats of the last line once they have been held back for
+ * LOG_REPEAT_SECONDS.  Call from the main loop.
+ */
+void logDrain(void)
+{
+	uint32_t timestamp = loggerGetTimestamp();
+	uint32_t repeats = 0;
+	const char *level = NULL;
+	const char *func = NULL;
+	CORE_DECLARE_IRQ_STATE;
+
+	CORE_ENTER_ATOMIC();
+	if (logRepeats && timestamp - logRepeatsSince >= LOG_REPEAT_SECONDS * LOG_TIMESTAMP_HZ) {
+		repeats = logRepeats;
+		level = logLastLevel;
+		func = logLastFunc;
+		logRepeats = 0;
+	}
+	CORE_EXIT_ATOMIC();
+
+	if (repeats) {
+		printf("%5"PRIu32":%s:%s: last message repeated %"PRIu32" times\n",
+				timestamp, level, func, repeats);
+	}
+}
+#endif
+
+#if INCLUDE_LOGGING
+#ifndef LOG_TIMESTAMP_TICKS
+#include "sl_sleeptimer.h"
+#define LOG_TIMESTAMP_SLEEPTIMER	1
+#define LOG_TIMESTAMP_TICKS()		sl_sleeptimer_get_tick_count64()
+#define LOG_TIMESTAMP_TICK_HZ()		sl_sleeptimer_get_timer_frequency()
+#endif
+
+#if LOG_TIMESTAMP_US
+#ifndef LOG_TIMESTAMP_CYCLES
+#include "em_device.h"
+#include "em_cmu.h"
+#define LOG_TIMESTAMP_DWT			1
+#define LOG_TIMESTAMP_CYCLES()		(DWT->CYCCNT)
+#define LOG_TIMESTAMP_CYCLE_HZ()	CMU_ClockFreqGet(cmuClock_CORE)
+#endif
+#ifndef LOG_TIMESTAMP_CYCLE_HZ
+#define LOG_TIMESTAMP_CYCLE_HZ()	0
+#endif
+
+static uint32_t logTickHz;
+static uint32_t logTickShift;		/* log2 of logTickHz / 64 if that is a power of two, else 0 */
+static uint32_t logUsPerCycle;		/* microseconds per cycle << 32, 0 turns off interpolation */
+static uint64_t logAnchorTick;		/* tick the cycle count below was taken in */
+static uint32_t logAnchorCycles;
+
+/**
+ * @return tick converted to microseconds, truncated to 32 bits
+ */
+static uint32_t logTicksToUs(uint64_t tick)
+{
+	/* 1000000 = 15625 * 64, so the usual 32768 Hz needs no division */
+	if (logTickShift) {
+		return (uint32_t)((tick * 15625u) >> logTickShift);
+	}
+	return (uint32_t)(tick * 1000000u / logTickHz);
+}
+
+static void loggerTimestampInit(void)
+{
+	uint32_t hz;
+
+#if LOG_TIMESTAMP_SLEEPTIMER
+	sl_sleeptimer_init();
+#endif
+	logTickHz = LOG_TIMESTAMP_TICK_HZ();
+	logTickShift = 0;
+	for (hz = logTickHz; hz > 64 && !(hz & 1); hz >>= 1) {
+		logTickShift++;
+	}
+	if (hz != 64) {
+		logTickShift = 0;
+	}
+#if LOG_TIMESTAMP_DWT
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+	hz = LOG_TIMESTAMP_CYCLE_HZ();
+	logUsPerCycle = hz > 1000000u ? (uint32_t)((1000000ull << 32) / hz) : 0;
+	logAnchorTick = LOG_TIMESTAMP_TICKS();
+	logAnchorCycles = LOG_TIMESTAMP_CYCLES();
+}
+
+/**
+ * @return microseconds since the sleeptimer started, wrapping after 71 minutes.
+ * The sleeptimer resolution is only 30.5us at 32768 Hz, so the time within a tick is measured with
+ * the core cycle counter.  That only counts while HFCLK clocks the core, so it is used just inside
+ * the tick it was anchored in, from the first timestamp taken in that tick.  Timestamps are
+ * monotonic and differences within a tick are exact, the offset of a tick's first timestamp from
+ * the tick edge is not known.
+ */
+uint32_t loggerGetTimestamp(void)
+{
+	uint64_t tick = LOG_TIMESTAMP_TICKS();
+	uint32_t cycles = LOG_TIMESTAMP_CYCLES();
+	uint32_t us = logTicksToUs(tick);
+	uint32_t fine = 0;
+	uint32_t span;
+	CORE_DECLARE_IRQ_STATE;
+
+	/* Also called from interrupt handlers, the anchor is two words */
+	CORE_ENTER_ATOMIC();
+	if (tick != logAnchorTick) {
+		logAnchorTick = tick;
+		logAnchorCycles = cycles;
+	} else {
+		fine = (uint32_t)(((uint64_t)(cycles - logAnchorCycles) * logUsPerCycle) >> 32);
+	}
+	CORE_EXIT_ATOMIC();
+
+	/* Stay below the first microsecond of the next tick */
+	span = logTicksToUs(tick + 1) - us;
+	if (fine >= span) {
+		fine = span - 1;
+	}
+	return us + fine;
+}
+#else
+static void loggerTimestampInit(void)
+{
+#if LOG_TIMESTAMP_SLEEPTIMER
+	sl_sleeptimer_init();
+#endif
+}
+
+/**
+ * @return a timestamp value for the logger, milliseconds since the sleeptimer started.
  * This will be printed at the beginning of each log message.
  */
 uint32_t loggerGetTimestamp(void)
 {
-	return timerGetRunTimeMilliseconds();
+	uint64_t ms = 0;
+
+#if LOG_TIMESTAMP_SLEEPTIMER
+	sl_sleeptimer_tick64_to_ms(LOG_TIMESTAMP_TICKS(), &ms);
+#else
+	ms = LOG_TIMESTAMP_TICKS() * 1000u / LOG_TIMESTAMP_TICK_HZ();
+#endif
+	return (uint32_t)ms;
 }
+#endif
 
 /**
  * Initialize logging for Blue Gecko.
@@ -25,12 +457,21 @@ uint32_t loggerGetTimestamp(void)
  */
 void logInit(void)
 {
+	loggerTimestampInit();
 	RETARGET_SerialInit();
+#if LOG_BINARY
+	/**
+	 * Records are sent as raw bytes, a 0x0a in them must not turn into 0x0d 0x0a.  Text printed
+	 * elsewhere has to bring its own carriage returns.
+	 */
+	RETARGET_SerialCrLf(false);
+#else
 	/**
 	 * See https://siliconlabs.github.io/Gecko_SDK_Doc/efm32g/html/group__RetargetIo.html#ga9e36c68713259dd181ef349430ba0096
 	 * RETARGET_SerialCrLf() ensures each linefeed also includes carriage return.  Without it, the first character is shifted in TeraTerm
 	 */
 	RETARGET_SerialCrLf(true);
+#endif
 	LOG_INFO("Initialized Logging");
 }
 
@@ -39,6 +480,7 @@ void logInit(void)
  */
 void logFlush(void)
 {
+	logDrain();
 	RETARGET_SerialFlush();
 }
 #endif
@@ -8,7 +8,6 @@
 #ifndef SRC_LOG_H_
 #define SRC_LOG_H_
 #include "stdio.h"
-//#include "letimer.h"
 #include <inttypes.h>
 
 /**
@@ -21,8 +20,8 @@
  *    * INFO for infrequent status updates
  *    * DEBUG for detailed updates, useful when troubleshooting a specific
  *        code path
- *  3) Call logInit() once in the main init routine, before any logging is attempted and after any timing capability for
- *  loggerGetTimestamp() is complete.
+ *  3) Call logInit() once in the main init routine, before any logging is attempted.  logInit() also starts the
+ *  sleeptimer, which loggerGetTimestamp() reads, and must come after the core clock is set up.
  *  For the Blue Gecko platform, logging can be viewed with Tera Term or similar terminal emulator.
  *       Select the "JLink CDC UART Port" and baud rate 115200.
  *  All logging is off by default (compiled out of the build)
@@ -32,6 +31,37 @@
  *   * To turn debug logging on for a specific .c file, #define INCLUDE_LOG_DEBUG 1 at the top of the file
  *       before the #include "log.h" reference.
  *   * To turn on for all files #define INCLUDE_LOG_DEBUG 1 in the project configuration.
+ *  Timestamps
+ *   * Each line starts with the milliseconds since the sleeptimer started, from the 64 bit sleeptimer tick count.
+ *   * #define LOG_TIMESTAMP_US 1 for microseconds instead, to use log lines as a latency tracer.  Within
+ *       a 30.5us sleeptimer tick the core cycle counter adds the microseconds, which works while HFCLK
+ *       runs the core.  Microsecond timestamps wrap after 71 minutes.
+ *   * #define LOG_TIMESTAMP_TICKS() and LOG_TIMESTAMP_TICK_HZ() to a different 64 bit tick source, and
+ *       LOG_TIMESTAMP_CYCLES() and LOG_TIMESTAMP_CYCLE_HZ() to a different cycle counter, for instance
+ *       simulated ones on a host build.
+ *  Deferred binary logging
+ *   * #define LOG_BINARY 1 along with INCLUDE_LOGGING to store log records in a RAM ring instead of
+ *       formatting them at the call site.  Each record holds the offset of the call site's strings in
+ *       the log_strings section, the timestamp and up to LOG_BINARY_MAX_ARGS integer or pointer
+ *       arguments.  The log_strings section is not loaded to the device, so format strings take no
+ *       flash space.
+ *   * Call logDrain() from the main loop to send the queued records over the serial port, logFlush()
+ *       also drains.  Records that do not fit in the ring are counted and reported by a later record.
+ *   * Decode the serial output with src/log_decode.py, which reads the strings from the .axf file:
+ *       python3 src/log_decode.py soc-btmesh-switch.axf capture.bin
+ *       Text printed with printf is passed through.  The function name is replaced by file:line.
+ *   * %s arguments are stored as pointers.  The decoder prints strings which are in flash, but not ones
+ *       in RAM since those may have changed by the time the record is sent.  Floating point and 64 bit
+ *       arguments are not supported.
+ *  Rate limiting, on by default with logging, #define LOG_RATE_LIMIT 0 to turn off
+ *   * A line identical to the one before it, apart from the timestamp, is not sent.  It is counted and
+ *       reported as "last message repeated N times" before the next different line, or by logDrain()
+ *       once LOG_REPEAT_SECONDS have passed, so call logDrain() from the main loop in text mode too.
+ *   * Each call site may send a burst of LOG_RATE_BURST lines, then LOG_RATE_PER_SEC lines per second.
+ *       Repeats do not count against the limit.  Other lines over the limit are dropped, and the next
+ *       line the site sends is preceded by "N lines suppressed".
+ *   * logSinkStats() returns the number of lines dropped as repeats and by the rate limits.
+ *   * Text lines are formatted into a LOG_LINE_MAX byte buffer first and truncated to fit.
  */
 #ifndef LOG_ERROR
 #define LOG_ERROR(message,...) \
@@ -61,18 +91,130 @@
 
 
 #if INCLUDE_LOGGING
+#include <stdint.h>
+
+#ifndef LOG_RATE_LIMIT
+#define LOG_RATE_LIMIT		1
+#endif
+#ifndef LOG_RATE_BURST
+#define LOG_RATE_BURST		8	/* lines a call site may log at once */
+#endif
+#ifndef LOG_RATE_PER_SEC
+#define LOG_RATE_PER_SEC	4	/* lines per second a call site may log after a burst */
+#endif
+#ifndef LOG_REPEAT_SECONDS
+#define LOG_REPEAT_SECONDS	5	/* longest time repeats are held back */
+#endif
+#ifndef LOG_LINE_MAX
+#define LOG_LINE_MAX		128	/* text line buffer, including the NUL */
+#endif
+
+#if LOG_TIMESTAMP_US
+#define LOG_TIMESTAMP_HZ	1000000UL
+#else
+#define LOG_TIMESTAMP_HZ	1000UL
+#endif
+
+/* Rate limit state of a call site, starts out zeroed with a full bucket */
+typedef struct {
+	uint32_t refilled;		/* timestamp the bucket was last refilled at */
+	uint16_t used;			/* tokens taken out of the bucket */
+	uint16_t suppressed;	/* lines dropped since the site last logged */
+} logLimit_t;
+
+#if LOG_RATE_LIMIT
+#define LOG_LIMIT_DECLARE(name) static logLimit_t name
+#define LOG_LIMIT(name) (&name)
+#else
+#define LOG_LIMIT_DECLARE(name)
+#define LOG_LIMIT(name) NULL
+#endif
+#endif
+
+#if INCLUDE_LOGGING && LOG_BINARY
+
+#define LOG_BINARY_MAX_ARGS	8
+/* Records start with LOG_BINARY_SYNC | string offset << 4 | argument count, then the timestamp */
+#define LOG_BINARY_SYNC		0xa5000000UL
+/* Argument counts of records with a count for a site instead of its message */
+#define LOG_BINARY_REPEATED		0xe	/* last message repeated N times */
+#define LOG_BINARY_SUPPRESSED	0xf	/* N lines suppressed */
+
+#define LOG_STRINGIFY_(x) #x
+#define LOG_STRINGIFY(x) LOG_STRINGIFY_(x)
+#define LOG_CONCAT_(a,b) a##b
+#define LOG_CONCAT(a,b) LOG_CONCAT_(a,b)
+
+/**
+ * Strings of a call site: level, file, line and format, each NUL terminated.
+ * Placed in the log_strings section, which the linker script keeps out of the image.
+ */
+#define LOG_SITE(name,message,level) \
+	static const char name[] __attribute__((section("log_strings"))) = \
+		level "\0" __FILE__ "\0" LOG_STRINGIFY(__LINE__) "\0" message
+
+/* Number of arguments after the format, up to LOG_BINARY_MAX_ARGS */
+#define LOG_NARGS(message, ...) \
+	LOG_NARGS_(message, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_NARGS_(m,a1,a2,a3,a4,a5,a6,a7,a8,n,...) n
+
+/* Arguments after the format, each converted to a 32 bit word */
+#define LOG_ARG(a) ((uint32_t)(uintptr_t)(a))
+#define LOG_ARGS(message, ...) \
+	LOG_CONCAT(LOG_ARGS_, LOG_NARGS(message, ##__VA_ARGS__))(__VA_ARGS__)
+#define LOG_ARGS_0()
+#define LOG_ARGS_1(a) ,LOG_ARG(a)
+#define LOG_ARGS_2(a,b) ,LOG_ARG(a),LOG_ARG(b)
+#define LOG_ARGS_3(a,b,c) ,LOG_ARG(a),LOG_ARG(b),LOG_ARG(c)
+#define LOG_ARGS_4(a,b,c,d) ,LOG_ARG(a),LOG_ARG(b),LOG_ARG(c),LOG_ARG(d)
+#define LOG_ARGS_5(a,b,c,d,e) LOG_ARGS_4(a,b,c,d),LOG_ARG(e)
+#define LOG_ARGS_6(a,b,c,d,e,f) LOG_ARGS_4(a,b,c,d),LOG_ARG(e),LOG_ARG(f)
+#define LOG_ARGS_7(a,b,c,d,e,f,g) LOG_ARGS_4(a,b,c,d),LOG_ARG(e),LOG_ARG(f),LOG_ARG(g)
+#define LOG_ARGS_8(a,b,c,d,e,f,g,h) LOG_ARGS_4(a,b,c,d),LOG_ARG(e),LOG_ARG(f),LOG_ARG(g),LOG_ARG(h)
+
+#define LOG_DO(message,level, ...) \
+	do { \
+		LOG_SITE(logSite, message, level); \
+		LOG_LIMIT_DECLARE(logLimit); \
+		logBinaryWrite(logSite, LOG_LIMIT(logLimit), \
+				LOG_NARGS(message, ##__VA_ARGS__) LOG_ARGS(message, ##__VA_ARGS__)); \
+	} while (0)
+void logBinaryWrite(const char *site, logLimit_t *limit, uint32_t nargs, ...);
+void logInit();
+uint32_t loggerGetTimestamp();
+void logDrain();
+void logFlush();
+void logSinkStats(uint32_t *repeated, uint32_t *rateLimited);
+#elif INCLUDE_LOGGING && LOG_RATE_LIMIT
+#define LOG_DO(message,level, ...) \
+	do { \
+		static logLimit_t logLimit; \
+		logTextWrite(&logLimit, level, __func__, message, ##__VA_ARGS__); \
+	} while (0)
+void logTextWrite(logLimit_t *limit, const char *level, const char *func, const char *format, ...)
+	__attribute__((format(printf, 4, 5)));
+void logInit();
+uint32_t loggerGetTimestamp();
+void logDrain();
+void logFlush();
+void logSinkStats(uint32_t *repeated, uint32_t *rateLimited);
+#elif INCLUDE_LOGGING
 #define LOG_DO(message,level, ...) \
 	printf( "%5"PRIu32":%s:%s: " message "\n", loggerGetTimestamp(), level, __func__, ##__VA_ARGS__ )
 void logInit();
 uint32_t loggerGetTimestamp();
+static inline void logDrain() {}
 void logFlush();
+void logSinkStats(uint32_t *repeated, uint32_t *rateLimited);
 #else
 /**
  * Remove all logging related code on builds where logging is not enabled
  */
 #define LOG_DO(message,level, ...)
 static inline void logInit() {}
+static inline void logDrain() {}
 static inline void logFlush() {}
+static inline void logSinkStats(uint32_t *repeated, uint32_t *rateLimited) { *repeated = 0; *rateLimited = 0; }
 #endif
 
 
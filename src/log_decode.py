@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""Decode the deferred binary log written with LOG_BINARY, see src/log.h.
+
+The call site strings are read from the log_strings section of the firmware
+.axf, so it has to be the image the device runs. Bytes which are not part of
+a log record, such as text printed with printf, are passed through.
+
+Usage:
+
+  python3 src/log_decode.py soc-btmesh-switch.axf [capture]
+
+The capture is read from stdin if no file is given. A serial port can be
+read directly once it is set up, e.g. stty -F /dev/ttyACM0 115200 raw.
+"""
+
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xa5
+HEADER_BYTES = 8
+MAX_ARGS = 8
+# Argument counts of records with a count for a site instead of its message
+REPEATED = 0xe
+SUPPRESSED = 0xf
+
+CONVERSION = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXcsp%])')
+
+
+class Elf:
+    """Sections of an ELF file, just what the decoder needs."""
+
+    def __init__(self, path):
+        data = open(path, 'rb').read()
+        if data[:4] != b'\x7fELF':
+            raise ValueError('%s: not an ELF file' % path)
+        is64 = data[4] == 2
+        endian = '<' if data[5] == 1 else '>'
+        if is64:
+            shoff, = struct.unpack_from(endian + 'Q', data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + 'HHH', data, 0x3a)
+            fmt = endian + 'IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + 'HHH', data, 0x2e)
+            fmt = endian + 'IIIIIIIIII'
+
+        headers = [struct.unpack_from(fmt, data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx]
+        self.sections = []
+        for name, kind, flags, addr, offset, size in (h[:6] for h in headers):
+            end = data.index(b'\0', names[4] + name)
+            # SHT_NOBITS sections have no contents in the file
+            contents = data[offset:offset + size] if kind != 8 else b''
+            self.sections.append((data[names[4] + name:end].decode(), flags, addr, contents))
+
+    def section(self, name):
+        for section in self.sections:
+            if section[0] == name:
+                return section[3]
+        return None
+
+    def string_at(self, address):
+        """Returns the C string at an address of the loaded image, or None."""
+        for _name, flags, addr, contents in self.sections:
+            # SHF_ALLOC
+            if flags & 2 and addr <= address < addr + len(contents):
+                start = address - addr
+                end = contents.find(b'\0', start)
+                if end >= 0:
+                    return contents[start:end].decode('latin-1')
+        return None
+
+
+class Site:
+    """Strings of a log call site."""
+
+    def __init__(self, strings, offset):
+        fields = strings[offset:].split(b'\0', 4)
+        if len(fields) < 5 or (offset > 0 and strings[offset - 1] != 0):
+            raise ValueError('no call site at offset %d' % offset)
+        self.level, self.file, self.line, self.message = (f.decode('latin-1') for f in fields[:4])
+        self.file = os.path.basename(self.file)
+        if not self.line.isdigit():
+            raise ValueError('no call site at offset %d' % offset)
+
+
+def signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def format_message(elf, message, args):
+    """printf for the argument words of a record."""
+    args = list(args)
+
+    def next_arg():
+        return args.pop(0) if args else 0
+
+    def convert(match):
+        flags, width, precision, length, conversion = match.groups()
+        if conversion == '%':
+            return '%'
+        if width == '*':
+            width = str(signed(next_arg()))
+        if precision == '*':
+            precision = str(signed(next_arg()))
+        spec = '%' + flags + (width or '') + ('.' + precision if precision is not None else '')
+        value = next_arg()
+        if length in ('hh', 'h'):
+            value &= 0xff if length == 'hh' else 0xffff
+        if conversion in 'di':
+            bits = {'hh': 8, 'h': 16}.get(length, 32)
+            if value & (1 << (bits - 1)):
+                value -= 1 << bits
+            return (spec + 'd') % value
+        if conversion == 'u':
+            return (spec + 'd') % value
+        if conversion == 'c':
+            return (spec + 'c') % chr(value & 0xff)
+        if conversion == 'p':
+            return (spec + 's') % ('0x%x' % value)
+        if conversion == 's':
+            string = elf.string_at(value)
+            if string is None:
+                string = '<string at 0x%08x>' % value
+            return (spec + 's') % string
+        return (spec + conversion) % value
+
+    return CONVERSION.sub(convert, message)
+
+
+def decode(elf, stream, out):
+    strings = elf.section('log_strings')
+    if strings is None:
+        raise ValueError('no log_strings section, was the firmware built with LOG_BINARY?')
+    sites = {}
+    buffer = b''
+
+    def site_at(offset):
+        if offset not in sites:
+            try:
+                sites[offset] = Site(strings, offset)
+            except ValueError:
+                sites[offset] = None
+        return sites[offset]
+
+    while True:
+        chunk = stream.read(4096)
+        if chunk:
+            buffer += chunk
+        pos = 0
+        text = bytearray()
+        while pos < len(buffer):
+            # Records start with a little endian word whose top byte is SYNC
+            if pos + 4 > len(buffer):
+                if chunk:
+                    break
+            elif buffer[pos + 3] == SYNC:
+                word, = struct.unpack_from('<I', buffer, pos)
+                offset = (word >> 4) & 0xfffff
+                kind = word & 0xf
+                nargs = 1 if kind in (REPEATED, SUPPRESSED) else kind
+                site = site_at(offset) if nargs <= MAX_ARGS else None
+                if site is not None:
+                    size = HEADER_BYTES + 4 * nargs
+                    if pos + size > len(buffer):
+                        if chunk:
+                            break
+                    else:
+                        words = struct.unpack_from('<%dI' % (1 + nargs), buffer, pos + 4)
+                        out.write(text.decode('latin-1'))
+                        text = bytearray()
+                        if kind == REPEATED:
+                            message = 'last message repeated %d times' % words[1]
+                        elif kind == SUPPRESSED:
+                            message = '%d lines suppressed' % words[1]
+                        else:
+                            message = format_message(elf, site.message, words[1:])
+                        out.write('%5d:%s:%s:%s: %s\n'
+                                  % (words[0], site.level, site.file, site.line, message))
+                        pos += size
+                        continue
+            text.append(buffer[pos])
+            pos += 1
+        out.write(text.decode('latin-1'))
+        out.flush()
+        buffer = buffer[pos:]
+        if not chunk:
+            return
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.stderr.write(__doc__)
+        return 1
+
+    elf = Elf(sys.argv[1])
+    if len(sys.argv) == 3:
+        with open(sys.argv[2], 'rb', buffering=0) as stream:
+            decode(elf, stream, sys.stdout)
+    else:
+        decode(elf, sys.stdin.buffer.raw, sys.stdout)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,155 @@
+/*
+ * profile.c
+ *
+ *  Event loop latency profiling
+ */
+
+#include "profile.h"
+
+#if INCLUDE_PROFILING
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#ifndef PROFILE_TICKS
+#include "sl_sleeptimer.h"
+#define PROFILE_SLEEPTIMER		1
+#define PROFILE_TICKS()			sl_sleeptimer_get_tick_count()
+#define PROFILE_TICK_HZ()		sl_sleeptimer_get_timer_frequency()
+#endif
+#ifndef PROFILE_TICK_HZ
+#define PROFILE_TICK_HZ()		0
+#endif
+
+struct profile_entry {
+	uint32_t evt_id;		/* 0 marks a free slot */
+	uint32_t count;
+	uint32_t total;
+	uint32_t max;
+	uint16_t hist[PROFILE_HIST_BUCKETS];
+};
+
+static struct profile_entry profile_table[PROFILE_EVENT_SLOTS];
+static uint32_t profile_dropped;
+
+/**
+ * @return the slot for evt_id, claiming a free one on first use, or NULL if the table is full
+ */
+static struct profile_entry *profileFind(uint32_t evt_id)
+{
+	uint32_t i = ((evt_id * 2654435761UL) >> 16) & (PROFILE_EVENT_SLOTS - 1);
+	uint32_t n;
+
+	for (n = 0; n < PROFILE_EVENT_SLOTS; n++) {
+		struct profile_entry *e = &profile_table[i];
+		if (e->evt_id == evt_id) {
+			return e;
+		}
+		if (e->evt_id == 0) {
+			e->evt_id = evt_id;
+			return e;
+		}
+		i = (i + 1) & (PROFILE_EVENT_SLOTS - 1);
+	}
+	return NULL;
+}
+
+/**
+ * @return the log2 histogram bucket for a dispatch time in ticks
+ */
+static uint32_t profileBucket(uint32_t ticks)
+{
+	uint32_t b = 0;
+
+	while (ticks != 0 && b < PROFILE_HIST_BUCKETS - 1) {
+		ticks >>= 1;
+		b++;
+	}
+	return b;
+}
+
+void profileInit(void)
+{
+#if PROFILE_SLEEPTIMER
+	sl_sleeptimer_init();
+#endif
+	profileReset();
+}
+
+void profileReset(void)
+{
+	memset(profile_table, 0, sizeof(profile_table));
+	profile_dropped = 0;
+}
+
+uint32_t profileStart(void)
+{
+	return PROFILE_TICKS();
+}
+
+void profileStop(uint32_t evt_id, uint32_t start)
+{
+	uint32_t ticks = PROFILE_TICKS() - start;
+	struct profile_entry *e = profileFind(evt_id);
+	uint32_t b;
+
+	if (e == NULL) {
+		profile_dropped++;
+		return;
+	}
+	e->count++;
+	e->total += ticks;
+	if (ticks > e->max) {
+		e->max = ticks;
+	}
+	b = profileBucket(ticks);
+	if (e->hist[b] != UINT16_MAX) {
+		e->hist[b]++;
+	}
+}
+
+#if PROFILE_DUMP_JSON
+void profileDump(void)
+{
+	const char *sep = "";
+	uint32_t i, b;
+
+	printf("{\"tick_hz\":%"PRIu32",\"dropped\":%"PRIu32",\"events\":[",
+			(uint32_t)PROFILE_TICK_HZ(), profile_dropped);
+	for (i = 0; i < PROFILE_EVENT_SLOTS; i++) {
+		const struct profile_entry *e = &profile_table[i];
+		if (e->evt_id == 0) {
+			continue;
+		}
+		printf("%s{\"id\":\"0x%08"PRIx32"\",\"count\":%"PRIu32",\"total\":%"PRIu32",\"max\":%"PRIu32",\"hist\":[",
+				sep, e->evt_id, e->count, e->total, e->max);
+		for (b = 0; b < PROFILE_HIST_BUCKETS; b++) {
+			printf(b ? ",%u" : "%u", e->hist[b]);
+		}
+		printf("]}");
+		sep = ",";
+	}
+	printf("]}\r\n");
+}
+#else
+void profileDump(void)
+{
+	uint32_t i, b;
+
+	printf("profile: tick %"PRIu32" Hz, %"PRIu32" dropped\r\n",
+			(uint32_t)PROFILE_TICK_HZ(), profile_dropped);
+	for (i = 0; i < PROFILE_EVENT_SLOTS; i++) {
+		const struct profile_entry *e = &profile_table[i];
+		if (e->evt_id == 0) {
+			continue;
+		}
+		printf("0x%08"PRIx32" n=%"PRIu32" total=%"PRIu32" max=%"PRIu32" |",
+				e->evt_id, e->count, e->total, e->max);
+		for (b = 0; b < PROFILE_HIST_BUCKETS; b++) {
+			printf(" %u", e->hist[b]);
+		}
+		printf("\r\n");
+	}
+}
+#endif
+#endif
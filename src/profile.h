@@ -0,0 +1,51 @@
+/*
+ * profile.h
+ *
+ *  Event loop latency profiling
+ */
+
+#ifndef SRC_PROFILE_H_
+#define SRC_PROFILE_H_
+#include <stdint.h>
+
+/**
+ * Instructions for using this module:
+ * 1) Call profileInit() once in the main init routine, after the serial port is retargeted.
+ * 2) Wrap each event dispatch in the main loop with
+ *      uint32_t start = profileStart();
+ *      ...dispatch...
+ *      profileStop(evt_id, start);
+ * 3) Call profileDump() to print the per event ID histograms over VCOM.
+ *  Each event ID keeps a count, total and maximum dispatch time and a log2 histogram of
+ *  dispatch times in timer ticks.  Bucket 0 counts dispatches shorter than one tick, bucket n
+ *  counts dispatches of [2^(n-1), 2^n) ticks and the last bucket also collects everything longer.
+ *  All profiling is off by default (compiled out of the build)
+ *   * To turn on #define INCLUDE_PROFILING 1 in your project files or build configuration.
+ *   * #define PROFILE_DUMP_JSON 1 to print the histograms as a single JSON object instead of text.
+ *   * #define PROFILE_TICKS() to a different free running tick source, for instance a fake clock.
+ */
+#ifndef PROFILE_EVENT_SLOTS
+#define PROFILE_EVENT_SLOTS		32	/* distinct event IDs tracked, power of two */
+#endif
+#ifndef PROFILE_HIST_BUCKETS
+#define PROFILE_HIST_BUCKETS	16
+#endif
+
+#if INCLUDE_PROFILING
+void profileInit(void);
+uint32_t profileStart(void);
+void profileStop(uint32_t evt_id, uint32_t start);
+void profileReset(void);
+void profileDump(void);
+#else
+/**
+ * Remove all profiling related code on builds where profiling is not enabled
+ */
+static inline void profileInit(void) {}
+static inline uint32_t profileStart(void) { return 0; }
+static inline void profileStop(uint32_t evt_id, uint32_t start) { (void)evt_id; (void)start; }
+static inline void profileReset(void) {}
+static inline void profileDump(void) {}
+#endif
+
+#endif /* SRC_PROFILE_H_ */